@@ -25,6 +25,9 @@
 
 #include <lib/core/Global.h>
 
+#include <algorithm>
+#include <tuple>
+
 namespace chip {
 namespace Access {
 
@@ -190,6 +193,7 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+        OnEntriesChanged();
     }
 
     return retval;
@@ -201,6 +205,11 @@ void AccessControl::Finish()
     ChipLogProgress(DataManagement, "AccessControl: finishing");
     mDelegate->Finish();
     mDelegate = nullptr;
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+    mGrants.Free();
+    mGrantCount      = 0;
+    mCheckIndexState = CheckIndexState::kStale;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
 }
 
 CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t * index,
@@ -311,6 +320,29 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
 
+    bool allowed = false;
+    if (mCheckCache != nullptr && mCheckCache->Find(subjectDescriptor, requestPath, requestPrivilege, allowed))
+    {
+        mCheckCache->mHitCount++;
+        return allowed ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+    }
+
+    CHIP_ERROR result = CheckUncached(subjectDescriptor, requestPath, requestPrivilege);
+    if (mCheckCache != nullptr)
+    {
+        mCheckCache->mMissCount++;
+        if (result == CHIP_NO_ERROR || result == CHIP_ERROR_ACCESS_DENIED)
+        {
+            mCheckCache->Add(subjectDescriptor, requestPath, requestPrivilege, result == CHIP_NO_ERROR);
+        }
+    }
+    return result;
+}
+
+CHIP_ERROR AccessControl::CheckUncached(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                        Privilege requestPrivilege)
+{
+
 #if CHIP_PROGRESS_LOGGING && CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 1
     {
         constexpr size_t kMaxCatsToLog = 6;
@@ -355,6 +387,56 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
         return CHIP_NO_ERROR;
     }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+    if (mCheckIndexState == CheckIndexState::kStale)
+    {
+        CHIP_ERROR err = BuildCheckIndex();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "AccessControl: cannot index entries %" CHIP_ERROR_FORMAT, err.Format());
+            mGrants.Free();
+            mGrantCount = 0;
+        }
+        mCheckIndexState = (err == CHIP_NO_ERROR) ? CheckIndexState::kValid : CheckIndexState::kUnusable;
+    }
+
+    if (mCheckIndexState == CheckIndexState::kValid)
+    {
+        // Entries without subjects, then entries naming the subject, then entries naming one of its CATs.
+        const NodeId subject = subjectDescriptor.subject;
+        bool allowed         = CheckIndexAllows(subjectDescriptor, requestPath, requestPrivilege, kUndefinedNodeId, kUndefinedNodeId);
+        if (!allowed && subject != kUndefinedNodeId && !IsCASEAuthTag(subject))
+        {
+            allowed = CheckIndexAllows(subjectDescriptor, requestPath, requestPrivilege, subject, subject);
+        }
+        if (subjectDescriptor.authMode == AuthMode::kCase)
+        {
+            for (auto cat : subjectDescriptor.cats.values)
+            {
+                if (allowed || cat == kUndefinedCAT || GetCASEAuthTagVersion(cat) == 0)
+                {
+                    continue;
+                }
+                // Subjects with the same CAT identifier and a version no greater than the one held.
+                const auto lowestVersion = static_cast<CASEAuthTag>((cat & kTagIdentifierMask) | 1);
+                allowed = CheckIndexAllows(subjectDescriptor, requestPath, requestPrivilege, NodeIdFromCASEAuthTag(lowestVersion),
+                                           NodeIdFromCASEAuthTag(cat));
+            }
+        }
+
+        if (allowed)
+        {
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+            ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+            return CHIP_NO_ERROR;
+        }
+
+        ChipLogProgress(DataManagement, "AccessControl: denied");
+        return CHIP_ERROR_ACCESS_DENIED;
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -469,6 +551,193 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
     return CHIP_ERROR_ACCESS_DENIED;
 }
 
+bool AccessControl::CheckCache::IsCachedSubject(const SubjectDescriptor & subjectDescriptor) const
+{
+    return mSubjectDescriptor.fabricIndex == subjectDescriptor.fabricIndex &&
+        mSubjectDescriptor.authMode == subjectDescriptor.authMode && mSubjectDescriptor.subject == subjectDescriptor.subject &&
+        mSubjectDescriptor.cats.values == subjectDescriptor.cats.values;
+}
+
+bool AccessControl::CheckCache::Find(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                     Privilege privilege, bool & allowed) const
+{
+    VerifyOrReturnValue(mCount > 0 && IsCachedSubject(subjectDescriptor), false);
+
+    for (size_t i = 0; i < mCount; ++i)
+    {
+        const Decision & decision = mDecisions[i];
+        if (decision.cluster == requestPath.cluster && decision.endpoint == requestPath.endpoint && decision.privilege == privilege)
+        {
+            allowed = decision.allowed;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AccessControl::CheckCache::Add(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                    Privilege privilege, bool allowed)
+{
+    if (mCount == 0)
+    {
+        mSubjectDescriptor = subjectDescriptor;
+        mNext              = 0;
+    }
+    VerifyOrReturn(kSize > 0 && IsCachedSubject(subjectDescriptor));
+
+    Decision & decision = (mCount < kSize) ? mDecisions[mCount++] : mDecisions[mNext];
+    if (mCount == kSize)
+    {
+        mNext = (mNext + 1) % kSize;
+    }
+    decision.cluster   = requestPath.cluster;
+    decision.endpoint  = requestPath.endpoint;
+    decision.privilege = privilege;
+    decision.allowed   = allowed;
+}
+
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+CHIP_ERROR AccessControl::BuildCheckIndex()
+{
+    mGrants.Free();
+    mGrantCount = 0;
+
+    // The first pass counts the grants, the second one fills them in.
+    size_t grantCount = 0;
+    for (bool fill : { false, true })
+    {
+        if (fill && grantCount > 0)
+        {
+            VerifyOrReturnError(mGrants.Calloc(grantCount), CHIP_ERROR_NO_MEMORY);
+        }
+
+        size_t grantIndex = 0;
+        EntryIterator iterator;
+        ReturnErrorOnFailure(Entries(iterator));
+
+        Entry entry;
+        while (iterator.Next(entry) == CHIP_NO_ERROR)
+        {
+            Grant grant = {};
+            ReturnErrorOnFailure(entry.GetFabricIndex(grant.fabricIndex));
+            ReturnErrorOnFailure(entry.GetAuthMode(grant.authMode));
+            ReturnErrorOnFailure(entry.GetPrivilege(grant.privilege));
+            // Entries that Check() would report as inconsistent are not indexed, so that it keeps reporting them.
+            VerifyOrReturnError(grant.authMode == AuthMode::kCase || grant.authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+
+            size_t subjectCount = 0;
+            size_t targetCount  = 0;
+            ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+            ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
+
+            for (size_t i = 0; i < std::max<size_t>(subjectCount, 1); ++i)
+            {
+                grant.subject = kUndefinedNodeId;
+                if (subjectCount > 0)
+                {
+                    ReturnErrorOnFailure(entry.GetSubject(i, grant.subject));
+                    const AuthMode expectedAuthMode = IsGroupId(grant.subject) ? AuthMode::kGroup : AuthMode::kCase;
+                    VerifyOrReturnError(IsOperationalNodeId(grant.subject) || IsCASEAuthTag(grant.subject) ||
+                                            IsGroupId(grant.subject),
+                                        CHIP_ERROR_INCORRECT_STATE);
+                    VerifyOrReturnError(grant.authMode == expectedAuthMode, CHIP_ERROR_INCORRECT_STATE);
+                }
+
+                for (size_t j = 0; j < std::max<size_t>(targetCount, 1); ++j)
+                {
+                    Entry::Target target;
+                    target.cluster    = kInvalidClusterId;
+                    target.endpoint   = kInvalidEndpointId;
+                    target.deviceType = 0;
+                    if (targetCount > 0)
+                    {
+                        ReturnErrorOnFailure(entry.GetTarget(j, target));
+                    }
+                    grant.cluster     = (target.flags & Entry::Target::kCluster) ? target.cluster : kInvalidClusterId;
+                    grant.endpoint    = target.endpoint;
+                    grant.deviceType  = target.deviceType;
+                    grant.targetFlags = static_cast<uint8_t>(target.flags);
+
+                    if (fill)
+                    {
+                        VerifyOrReturnError(grantIndex < grantCount, CHIP_ERROR_INCORRECT_STATE);
+                        mGrants[grantIndex] = grant;
+                    }
+                    grantIndex++;
+                }
+            }
+        }
+
+        grantCount = grantIndex;
+    }
+
+    mGrantCount = grantCount;
+    std::sort(mGrants.Get(), mGrants.Get() + mGrantCount, [](const Grant & a, const Grant & b) {
+        return std::tie(a.fabricIndex, a.authMode, a.subject, a.cluster) < std::tie(b.fabricIndex, b.authMode, b.subject, b.cluster);
+    });
+
+    return CHIP_NO_ERROR;
+}
+
+bool AccessControl::CheckIndexAllows(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                     Privilege requestPrivilege, NodeId subjectLow, NodeId subjectHigh) const
+{
+    auto bySubject = [](const Grant & a, const Grant & b) {
+        return std::tie(a.fabricIndex, a.authMode, a.subject) < std::tie(b.fabricIndex, b.authMode, b.subject);
+    };
+    auto byCluster = [](const Grant & a, const Grant & b) { return a.cluster < b.cluster; };
+
+    auto matches = [&](const Grant * first, const Grant * last) {
+        for (const Grant * grant = first; grant != last; ++grant)
+        {
+            if (!CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, grant->privilege))
+            {
+                continue;
+            }
+            if ((grant->targetFlags & Entry::Target::kCluster) && grant->cluster != requestPath.cluster)
+            {
+                continue;
+            }
+            if ((grant->targetFlags & Entry::Target::kEndpoint) && grant->endpoint != requestPath.endpoint)
+            {
+                continue;
+            }
+            if ((grant->targetFlags & Entry::Target::kDeviceType) &&
+                !mDeviceTypeResolver->IsDeviceTypeOnEndpoint(grant->deviceType, requestPath.endpoint))
+            {
+                continue;
+            }
+            return true;
+        }
+        return false;
+    };
+
+    Grant key       = {};
+    key.fabricIndex = subjectDescriptor.fabricIndex;
+    key.authMode    = subjectDescriptor.authMode;
+
+    const Grant * begin = mGrants.Get();
+    const Grant * end   = begin + mGrantCount;
+    key.subject         = subjectLow;
+    const Grant * first = std::lower_bound(begin, end, key, bySubject);
+    key.subject         = subjectHigh;
+    const Grant * last  = std::upper_bound(first, end, key, bySubject);
+
+    if (subjectLow != subjectHigh)
+    {
+        return matches(first, last);
+    }
+
+    // Grants for a single subject are sorted by cluster: only look at those for the requested cluster and for any cluster.
+    key.cluster     = requestPath.cluster;
+    auto forCluster = std::equal_range(first, last, key, byCluster);
+    key.cluster     = kInvalidClusterId;
+    auto anyCluster = std::equal_range(first, last, key, byCluster);
+    return matches(forCluster.first, forCluster.second) ||
+        (anyCluster.first != forCluster.first && matches(anyCluster.first, anyCluster.second));
+}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+
 #if CHIP_ACCESS_CONTROL_DUMP_ENABLED
 CHIP_ERROR AccessControl::Dump(const Entry & entry)
 {
@@ -626,6 +895,8 @@ exit:
 void AccessControl::NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index,
                                        const Entry * entry, EntryListener::ChangeType changeType)
 {
+    OnEntriesChanged();
+
     for (EntryListener * listener = mEntryListener; listener != nullptr; listener = listener->mNext)
     {
         listener->OnEntryChanged(subjectDescriptor, fabric, index, entry, changeType);
@@ -25,6 +25,7 @@
 #include <lib/core/CHIPCore.h>
 #include <lib/core/Global.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
 
 // Dump function for use during development only (0 for disabled, non-zero for enabled).
 #define CHIP_ACCESS_CONTROL_DUMP_ENABLED 0
@@ -322,6 +323,63 @@ public:
         friend class AccessControl;
     };
 
+    /**
+     * Remembers the results of Check() while it is in scope, so that an operation that checks the same subject against
+     * many paths of the same clusters, such as building a report for a wildcard read, evaluates the access control
+     * list once per (endpoint, cluster, privilege).
+     *
+     * Only one cache is used at a time: a cache created while another one is in scope replaces it until it goes out of
+     * scope. Results for a subject other than the first one checked are not cached. The cache is cleared when the
+     * access control list changes.
+     */
+    class CheckCache
+    {
+    public:
+        static constexpr size_t kSize = CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE;
+
+        explicit CheckCache(AccessControl & accessControl) : mAccessControl(accessControl), mPrevious(accessControl.mCheckCache)
+        {
+            mAccessControl.mCheckCache = this;
+        }
+        ~CheckCache() { mAccessControl.mCheckCache = mPrevious; }
+
+        CheckCache(const CheckCache &)             = delete;
+        CheckCache & operator=(const CheckCache &) = delete;
+
+        void Clear() { mCount = 0; }
+
+        /// Number of Check() results served from the cache, and evaluated from the access control list while it was in scope.
+        size_t GetHitCount() const { return mHitCount; }
+        size_t GetMissCount() const { return mMissCount; }
+
+    private:
+        friend class AccessControl;
+
+        struct Decision
+        {
+            ClusterId cluster;
+            EndpointId endpoint;
+            Privilege privilege;
+            bool allowed;
+        };
+
+        bool IsCachedSubject(const SubjectDescriptor & subjectDescriptor) const;
+        bool Find(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege privilege,
+                  bool & allowed) const;
+        void Add(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege privilege, bool allowed);
+
+        AccessControl & mAccessControl;
+        CheckCache * mPrevious;
+
+        SubjectDescriptor mSubjectDescriptor;
+        Decision mDecisions[kSize];
+        size_t mCount = 0; // decisions cached since the subject was last set
+        size_t mNext  = 0; // next decision to replace once the cache is full
+
+        size_t mHitCount  = 0;
+        size_t mMissCount = 0;
+    };
+
     class Delegate
     {
     public:
@@ -497,6 +555,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        OnEntriesChanged();
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -547,6 +606,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        OnEntriesChanged();
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -568,6 +628,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        OnEntriesChanged();
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -649,12 +710,61 @@ private:
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                             EntryListener::ChangeType changeType);
 
+    CHIP_ERROR CheckUncached(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                             Privilege requestPrivilege);
+
+    void OnEntriesChanged()
+    {
+        for (CheckCache * cache = mCheckCache; cache != nullptr; cache = cache->mPrevious)
+        {
+            cache->Clear();
+        }
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+        mCheckIndexState = CheckIndexState::kStale;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+    }
+
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+    // One (subject, target) pair of an entry. The grants are sorted by fabric, auth mode, subject and cluster, so those
+    // that may apply to a request are found by binary search.
+    struct Grant
+    {
+        NodeId subject; // kUndefinedNodeId if the entry has no subjects
+        ClusterId cluster;
+        DeviceTypeId deviceType;
+        EndpointId endpoint;
+        FabricIndex fabricIndex;
+        AuthMode authMode;
+        Privilege privilege;
+        uint8_t targetFlags; // Entry::Target flags, 0 if the entry has no targets
+    };
+
+    enum class CheckIndexState : uint8_t
+    {
+        kStale,    // rebuild before the next check
+        kValid,    // mGrants reflects the entries
+        kUnusable, // entries cannot be indexed (or memory is short): check them one by one until they change
+    };
+
+    CHIP_ERROR BuildCheckIndex();
+    bool CheckIndexAllows(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                          NodeId subjectLow, NodeId subjectHigh) const;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+
 private:
     Delegate * mDelegate = nullptr;
 
     DeviceTypeResolver * mDeviceTypeResolver = nullptr;
 
     EntryListener * mEntryListener = nullptr;
+
+    CheckCache * mCheckCache = nullptr;
+
+#if CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+    Platform::ScopedMemoryBuffer<Grant> mGrants;
+    size_t mGrantCount               = 0;
+    CheckIndexState mCheckIndexState = CheckIndexState::kStale;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
 };
 
 /**
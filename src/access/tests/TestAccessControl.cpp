@@ -21,6 +21,8 @@
 
 #include <pw_unit_test/framework.h>
 
+#include <algorithm>
+
 #include <lib/core/CHIPCore.h>
 #include <lib/core/StringBuilderAdapters.h>
 
@@ -1756,6 +1758,50 @@ TEST_F(TestAccessControl, TestCheck)
     }
 }
 
+TEST_F(TestAccessControl, TestCheckCache)
+{
+    LoadAccessControl(accessControl, entryData1, entryData1Count);
+    {
+        AccessControl::CheckCache checkCache(accessControl);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (const auto & checkData : checkData1)
+            {
+                CHIP_ERROR expectedResult = checkData.allow ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+                EXPECT_EQ(accessControl.Check(checkData.subjectDescriptor, checkData.requestPath, checkData.privilege),
+                          expectedResult);
+            }
+        }
+
+        // The decisions for the first subject checked were reused by the second pass.
+        EXPECT_GT(checkCache.GetHitCount(), 0u);
+    }
+
+    auto isAllowedCase = [](const CheckData & checkData) {
+        return checkData.allow && checkData.subjectDescriptor.authMode == AuthMode::kCase;
+    };
+    const auto & allowedCheck = *std::find_if(std::begin(checkData1), std::end(checkData1), isAllowedCase);
+    {
+        AccessControl::CheckCache checkCache(accessControl);
+
+        // Repeated checks of the same path are answered from the cache, without evaluating the entries again.
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_EQ(accessControl.Check(allowedCheck.subjectDescriptor, allowedCheck.requestPath, allowedCheck.privilege),
+                      CHIP_NO_ERROR);
+        }
+        EXPECT_EQ(checkCache.GetMissCount(), 1u);
+        EXPECT_EQ(checkCache.GetHitCount(), 2u);
+
+        // Changing the entries drops the cached decisions.
+        EXPECT_EQ(ClearAccessControl(accessControl), CHIP_NO_ERROR);
+        EXPECT_EQ(accessControl.Check(allowedCheck.subjectDescriptor, allowedCheck.requestPath, allowedCheck.privilege),
+                  CHIP_ERROR_ACCESS_DENIED);
+        EXPECT_EQ(checkCache.GetMissCount(), 2u);
+        EXPECT_EQ(checkCache.GetHitCount(), 2u);
+    }
+}
+
 TEST_F(TestAccessControl, TestCreateReadEntry)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
@@ -2191,5 +2237,71 @@ TEST_F(TestAccessControl, TestUpdateEntry)
     }
 }
 
+// Fills the access control list and checks every attribute of a large data model, as a wildcard read does.
+TEST_F(TestAccessControl, TestWildcardReadWithFullAcl)
+{
+    constexpr EndpointId kEndpoints          = 8;
+    constexpr ClusterId kClustersPerEndpoint = 40;
+    constexpr unsigned kAttributesPerCluster = 20;
+    constexpr NodeId kReader                 = 0x0000'0000'ABCD'0001;
+    constexpr FabricIndex kReaderFabric      = 1;
+
+    size_t maxEntryCount       = 0;
+    size_t maxEntriesPerFabric = 0;
+    size_t maxSubjects         = 0;
+    size_t maxTargets          = 0;
+    ASSERT_EQ(accessControl.GetMaxEntryCount(maxEntryCount), CHIP_NO_ERROR);
+    ASSERT_EQ(accessControl.GetMaxEntriesPerFabric(maxEntriesPerFabric), CHIP_NO_ERROR);
+    ASSERT_EQ(accessControl.GetMaxSubjectsPerEntry(maxSubjects), CHIP_NO_ERROR);
+    ASSERT_EQ(accessControl.GetMaxTargetsPerEntry(maxTargets), CHIP_NO_ERROR);
+
+    // Every entry names other subjects and clusters, except the last one of the reader's fabric, which grants it access
+    // to the clusters of the last endpoint.
+    NodeId nextSubject = 0x0000'0000'1000'0000;
+    for (size_t i = 0; i < maxEntryCount; ++i)
+    {
+        const auto fabricIndex = static_cast<FabricIndex>(1 + i / maxEntriesPerFabric);
+        const bool isLast      = (fabricIndex == kReaderFabric) && (i + 1 == maxEntriesPerFabric);
+
+        Entry entry;
+        ASSERT_EQ(accessControl.PrepareEntry(entry), CHIP_NO_ERROR);
+        ASSERT_EQ(entry.SetFabricIndex(fabricIndex), CHIP_NO_ERROR);
+        ASSERT_EQ(entry.SetAuthMode(AuthMode::kCase), CHIP_NO_ERROR);
+        ASSERT_EQ(entry.SetPrivilege(Privilege::kView), CHIP_NO_ERROR);
+        for (size_t j = 0; j < maxSubjects; ++j)
+        {
+            ASSERT_EQ(entry.AddSubject(nullptr, (isLast && j + 1 == maxSubjects) ? kReader : nextSubject++), CHIP_NO_ERROR);
+        }
+        for (size_t j = 0; j < maxTargets; ++j)
+        {
+            Target target = { .flags = Target::kEndpoint, .endpoint = static_cast<EndpointId>(isLast ? kEndpoints - 1 : 100 + j) };
+            ASSERT_EQ(entry.AddTarget(nullptr, target), CHIP_NO_ERROR);
+        }
+        ASSERT_EQ(accessControl.CreateEntry(nullptr, entry), CHIP_NO_ERROR);
+    }
+
+    const SubjectDescriptor subjectDescriptor = { .fabricIndex = kReaderFabric, .authMode = AuthMode::kCase, .subject = kReader };
+
+    unsigned allowed = 0;
+    for (EndpointId endpoint = 0; endpoint < kEndpoints; ++endpoint)
+    {
+        for (ClusterId cluster = 0; cluster < kClustersPerEndpoint; ++cluster)
+        {
+            for (unsigned attribute = 0; attribute < kAttributesPerCluster; ++attribute)
+            {
+                RequestPath requestPath = { .cluster = cluster, .endpoint = endpoint };
+                CHIP_ERROR result       = accessControl.Check(subjectDescriptor, requestPath, Privilege::kView);
+                EXPECT_EQ(result, (endpoint == kEndpoints - 1) ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED);
+                if (result == CHIP_NO_ERROR)
+                {
+                    ++allowed;
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(allowed, kClustersPerEndpoint * kAttributesPerCluster);
+}
+
 } // namespace Access
 } // namespace chip
@@ -49,8 +49,8 @@ uint32_t SizeOfStatusIB(const StatusIB & aStatus)
 
 } // anonymous namespace
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetElementTLVSize(TLV::TLVReader * apData, uint32_t & aSize)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetElementTLVSize(TLV::TLVReader * apData, uint32_t & aSize)
 {
     Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
     TLV::TLVReader reader;
@@ -65,9 +65,9 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetElementTLVSize(TLV::TLVR
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
-                                                                 const StatusIB & aStatus)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::UpdateCache(const ConcreteDataAttributePath & aPath,
+                                                                          TLV::TLVReader * apData, const StatusIB & aStatus)
 {
     AttributeState state;
     bool endpointIsNew = false;
@@ -110,35 +110,11 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
             state = elementSize;
         }
 
-        //
-        // Clear out the committed data version and only set it again once we have received all data for this cluster.
-        // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
-        //
-        mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
-
         // This commits a pending data version if the last report path is valid and it is different from the current path.
         if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
         {
             CommitPendingDataVersion();
         }
-
-        bool foundEncompassingWildcardPath = false;
-        for (const auto & path : mRequestPathSet)
-        {
-            if (path.IncludesAllAttributesInCluster(aPath))
-            {
-                foundEncompassingWildcardPath = true;
-                break;
-            }
-        }
-
-        // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
-        if (foundEncompassingWildcardPath)
-        {
-            mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
-        }
-
-        mLastReportDataPath = aPath;
     }
     else
     {
@@ -168,7 +144,38 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
         mAddedEndpoints.push_back(aPath.mEndpointId);
     }
 
-    mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
+    // Look the cluster up once for all of the updates below.  Nothing else may modify mCache while this reference is held,
+    // since with flat storage that can move the cluster.
+    ClusterState & clusterState = mCache[aPath.mEndpointId][aPath.mClusterId];
+
+    if (apData)
+    {
+        //
+        // Clear out the committed data version and only set it again once we have received all data for this cluster.
+        // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
+        //
+        clusterState.mCommittedDataVersion.ClearValue();
+
+        bool foundEncompassingWildcardPath = false;
+        for (const auto & path : mRequestPathSet)
+        {
+            if (path.IncludesAllAttributesInCluster(aPath))
+            {
+                foundEncompassingWildcardPath = true;
+                break;
+            }
+        }
+
+        // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
+        if (foundEncompassingWildcardPath)
+        {
+            clusterState.mPendingDataVersion = aPath.mDataVersion;
+        }
+
+        mLastReportDataPath = aPath;
+    }
+
+    clusterState.mAttributes[aPath.mAttributeId] = std::move(state);
 
     if (mCacheData)
     {
@@ -178,9 +185,9 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateEventCache(const EventHeader & aEventHeader, TLV::TLVReader * apData,
-                                                                      const StatusIB * apStatus)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::UpdateEventCache(const EventHeader & aEventHeader,
+                                                                               TLV::TLVReader * apData, const StatusIB * apStatus)
 {
     if (apData)
     {
@@ -227,8 +234,8 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateEventCache(const Even
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::OnReportBegin()
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::OnReportBegin()
 {
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     mChangedAttributeSet.clear();
@@ -236,8 +243,8 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnReportBegin()
     mCallback.OnReportBegin();
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::CommitPendingDataVersion()
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::CommitPendingDataVersion()
 {
     if (!mLastReportDataPath.IsValidConcreteClusterPath())
     {
@@ -252,8 +259,8 @@ void ClusterStateCacheT<CanEnableDataCaching>::CommitPendingDataVersion()
     }
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::OnReportEnd()
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::OnReportEnd()
 {
     CommitPendingDataVersion();
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
@@ -282,35 +289,37 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnReportEnd()
     mCallback.OnReportEnd();
 }
 
-template <>
-CHIP_ERROR ClusterStateCacheT<true>::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
 {
-    CHIP_ERROR err;
-    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
-    ReturnErrorOnFailure(err);
-
-    if (attributeState->template Is<StatusIB>())
+    if constexpr (CanEnableDataCaching)
     {
-        return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
-    }
+        CHIP_ERROR err;
+        auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
+        ReturnErrorOnFailure(err);
+
+        if (attributeState->template Is<StatusIB>())
+        {
+            return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
+        }
 
-    if (!attributeState->template Is<AttributeData>())
+        if (!attributeState->template Is<AttributeData>())
+        {
+            return CHIP_ERROR_KEY_NOT_FOUND;
+        }
+
+        reader.Init(attributeState->template Get<AttributeData>().Get(),
+                    attributeState->template Get<AttributeData>().AllocatedSize());
+        return reader.Next();
+    }
+    else
     {
         return CHIP_ERROR_KEY_NOT_FOUND;
     }
-
-    reader.Init(attributeState->template Get<AttributeData>().Get(), attributeState->template Get<AttributeData>().AllocatedSize());
-    return reader.Next();
-}
-
-template <>
-CHIP_ERROR ClusterStateCacheT<false>::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
-{
-    return CHIP_ERROR_KEY_NOT_FOUND;
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::Get(EventNumber eventNumber, TLV::TLVReader & reader) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::Get(EventNumber eventNumber, TLV::TLVReader & reader) const
 {
     CHIP_ERROR err;
 
@@ -326,9 +335,9 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::Get(EventNumber eventNumber
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::EndpointState *
-ClusterStateCacheT<CanEnableDataCaching>::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+const typename ClusterStateCacheT<CanEnableDataCaching, Storage>::EndpointState *
+ClusterStateCacheT<CanEnableDataCaching, Storage>::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
 {
     auto endpointIter = mCache.find(endpointId);
     if (endpointIter == mCache.end())
@@ -341,9 +350,10 @@ ClusterStateCacheT<CanEnableDataCaching>::GetEndpointState(EndpointId endpointId
     return &endpointIter->second;
 }
 
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::ClusterState *
-ClusterStateCacheT<CanEnableDataCaching>::GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+const typename ClusterStateCacheT<CanEnableDataCaching, Storage>::ClusterState *
+ClusterStateCacheT<CanEnableDataCaching, Storage>::GetClusterState(EndpointId endpointId, ClusterId clusterId,
+                                                                   CHIP_ERROR & err) const
 {
     auto endpointState = GetEndpointState(endpointId, err);
     if (err != CHIP_NO_ERROR)
@@ -362,10 +372,10 @@ ClusterStateCacheT<CanEnableDataCaching>::GetClusterState(EndpointId endpointId,
     return &clusterState->second;
 }
 
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::AttributeState *
-ClusterStateCacheT<CanEnableDataCaching>::GetAttributeState(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
-                                                            CHIP_ERROR & err) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+const typename ClusterStateCacheT<CanEnableDataCaching, Storage>::AttributeState *
+ClusterStateCacheT<CanEnableDataCaching, Storage>::GetAttributeState(EndpointId endpointId, ClusterId clusterId,
+                                                                     AttributeId attributeId, CHIP_ERROR & err) const
 {
     auto clusterState = GetClusterState(endpointId, clusterId, err);
     if (err != CHIP_NO_ERROR)
@@ -384,9 +394,9 @@ ClusterStateCacheT<CanEnableDataCaching>::GetAttributeState(EndpointId endpointI
     return &attributeState->second;
 }
 
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::EventData *
-ClusterStateCacheT<CanEnableDataCaching>::GetEventData(EventNumber eventNumber, CHIP_ERROR & err) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+const typename ClusterStateCacheT<CanEnableDataCaching, Storage>::EventData *
+ClusterStateCacheT<CanEnableDataCaching, Storage>::GetEventData(EventNumber eventNumber, CHIP_ERROR & err) const
 {
     EventData compareKey;
 
@@ -402,9 +412,9 @@ ClusterStateCacheT<CanEnableDataCaching>::GetEventData(EventNumber eventNumber,
     return &(*eventData);
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
-                                                               const StatusIB & aStatus)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::OnAttributeData(const ConcreteDataAttributePath & aPath,
+                                                                        TLV::TLVReader * apData, const StatusIB & aStatus)
 {
     //
     // Since the cache itself is a ReadClient::Callback, it may be incorrectly passed in directly when registering with the
@@ -434,9 +444,9 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnAttributeData(const ConcreteDat
     mCallback.OnAttributeData(aPath, apData ? &dataSnapshot : nullptr, aStatus);
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetVersion(const ConcreteClusterPath & aPath,
-                                                                Optional<DataVersion> & aVersion) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetVersion(const ConcreteClusterPath & aPath,
+                                                                         Optional<DataVersion> & aVersion) const
 {
     VerifyOrReturnError(aPath.IsValidConcreteClusterPath(), CHIP_ERROR_INVALID_ARGUMENT);
     CHIP_ERROR err;
@@ -446,9 +456,9 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetVersion(const ConcreteCl
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData,
-                                                           const StatusIB * apStatus)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                                                                    const StatusIB * apStatus)
 {
     VerifyOrDie(apData != nullptr || apStatus != nullptr);
 
@@ -462,31 +472,32 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnEventData(const EventHeader & a
     mCallback.OnEventData(aEventHeader, apData ? &dataSnapshot : nullptr, apStatus);
 }
 
-template <>
-CHIP_ERROR ClusterStateCacheT<true>::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
 {
-    CHIP_ERROR err;
+    if constexpr (CanEnableDataCaching)
+    {
+        CHIP_ERROR err;
 
-    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
-    ReturnErrorOnFailure(err);
+        auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
+        ReturnErrorOnFailure(err);
 
-    if (!attributeState->template Is<StatusIB>())
+        if (!attributeState->template Is<StatusIB>())
+        {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+
+        status = attributeState->template Get<StatusIB>();
+        return CHIP_NO_ERROR;
+    }
+    else
     {
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
-
-    status = attributeState->template Get<StatusIB>();
-    return CHIP_NO_ERROR;
-}
-
-template <>
-CHIP_ERROR ClusterStateCacheT<false>::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
-{
-    return CHIP_ERROR_INVALID_ARGUMENT;
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetStatus(const ConcreteEventPath & path, StatusIB & status) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetStatus(const ConcreteEventPath & path, StatusIB & status) const
 {
     auto statusIter = mEventStatusCache.find(path);
     if (statusIter == mEventStatusCache.end())
@@ -498,8 +509,9 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetStatus(const ConcreteEve
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::GetSortedFilters(
+    std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
 {
     for (auto const & endpointIter : mCache)
     {
@@ -565,8 +577,8 @@ void ClusterStateCacheT<CanEnableDataCaching>::GetSortedFilters(std::vector<std:
               });
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::OnUpdateDataVersionFilterList(
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::OnUpdateDataVersionFilterList(
     DataVersionFilterIBs::Builder & aDataVersionFilterIBsBuilder, const Span<AttributePathParams> & aAttributePaths,
     bool & aEncodedDataVersionList)
 {
@@ -648,14 +660,14 @@ exit:
     return err;
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::ClearAttributes(EndpointId endpointId)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::ClearAttributes(EndpointId endpointId)
 {
     mCache.erase(endpointId);
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::ClearAttributes(const ConcreteClusterPath & cluster)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::ClearAttributes(const ConcreteClusterPath & cluster)
 {
     // Can't use GetEndpointState here, since that only handles const things.
     auto endpointIter = mCache.find(cluster.mEndpointId);
@@ -668,8 +680,8 @@ void ClusterStateCacheT<CanEnableDataCaching>::ClearAttributes(const ConcreteClu
     endpointState.erase(cluster.mClusterId);
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::ClearAttribute(const ConcreteAttributePath & attribute)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::ClearAttribute(const ConcreteAttributePath & attribute)
 {
     // Can't use GetClusterState here, since that only handles const things.
     auto endpointIter = mCache.find(attribute.mEndpointId);
@@ -689,8 +701,8 @@ void ClusterStateCacheT<CanEnableDataCaching>::ClearAttribute(const ConcreteAttr
     clusterState.mAttributes.erase(attribute.mAttributeId);
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetLastReportDataPath(ConcreteClusterPath & aPath)
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetLastReportDataPath(ConcreteClusterPath & aPath)
 {
     if (mLastReportDataPath.IsValidConcreteClusterPath())
     {
@@ -703,6 +715,8 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetLastReportDataPath(Concr
 // Ensure that our out-of-line template methods actually get compiled.
 template class ClusterStateCacheT<true>;
 template class ClusterStateCacheT<false>;
+template class ClusterStateCacheT<true, ClusterStateCacheStorage::kFlat>;
+template class ClusterStateCacheT<false, ClusterStateCacheStorage::kFlat>;
 
 } // namespace app
 } // namespace chip
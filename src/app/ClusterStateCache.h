@@ -28,15 +28,124 @@
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
 #include <lib/support/Variant.h>
+#include <algorithm>
 #include <list>
 #include <map>
 #include <queue>
 #include <set>
+#include <utility>
 #include <vector>
 
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
 namespace chip {
 namespace app {
+
+/*
+ * Selects how ClusterStateCacheT stores its endpoint -> cluster -> attribute hierarchy.
+ *
+ * kTree uses a node-based std::map at each level.  kFlat uses sorted vectors instead, which keeps the entries for a cluster
+ * (and the clusters for an endpoint) contiguous: lookups and iteration touch far fewer cache lines, and there is one heap
+ * allocation per level instead of one per entry.  Paths that arrive in ascending order, as they do in a priming report for a
+ * wildcard read, are appended without moving any existing entries.  The trade-off is that inserting out of order, or
+ * clearing individual attributes or clusters, moves the entries after it.
+ */
+enum class ClusterStateCacheStorage : uint8_t
+{
+    kTree,
+    kFlat,
+};
+
+namespace detail {
+
+/*
+ * An ordered map kept in a sorted std::vector, providing the subset of the std::map interface that ClusterStateCacheT
+ * uses.  Unlike std::map, inserting or erasing an entry invalidates references to the entries after it.
+ */
+template <typename Key, typename Value>
+class SortedVectorMap
+{
+public:
+    // Entries are only ever moved, so that move-only values (e.g. buffers held in a Variant) can be stored.
+    struct Entry
+    {
+        explicit Entry(const Key & key) : first(key), second() {}
+        Entry(Entry && other) noexcept : first(other.first), second(std::move(other.second)) {}
+        Entry & operator=(Entry && other) noexcept
+        {
+            first  = other.first;
+            second = std::move(other.second);
+            return *this;
+        }
+        Entry(const Entry &)             = delete;
+        Entry & operator=(const Entry &) = delete;
+
+        Key first;
+        Value second;
+    };
+
+    using iterator       = typename std::vector<Entry>::iterator;
+    using const_iterator = typename std::vector<Entry>::const_iterator;
+
+    iterator begin() { return mEntries.begin(); }
+    iterator end() { return mEntries.end(); }
+    const_iterator begin() const { return mEntries.begin(); }
+    const_iterator end() const { return mEntries.end(); }
+    bool empty() const { return mEntries.empty(); }
+    size_t size() const { return mEntries.size(); }
+
+    iterator find(const Key & key) { return Find(mEntries, key); }
+    const_iterator find(const Key & key) const { return Find(mEntries, key); }
+
+    Value & operator[](const Key & key)
+    {
+        iterator iter = LowerBound(mEntries, key);
+        if (iter == mEntries.end() || iter->first != key)
+        {
+            iter = mEntries.emplace(iter, key);
+        }
+        return iter->second;
+    }
+
+    size_t erase(const Key & key)
+    {
+        iterator iter = Find(mEntries, key);
+        if (iter == mEntries.end())
+        {
+            return 0;
+        }
+        mEntries.erase(iter);
+        return 1;
+    }
+
+private:
+    template <typename Entries>
+    static auto LowerBound(Entries & entries, const Key & key) -> decltype(entries.begin())
+    {
+        // Reports deliver paths in ascending order, so the common cases are appending a new key and revisiting the last one.
+        if (entries.empty() || entries.back().first < key)
+        {
+            return entries.end();
+        }
+        if (entries.back().first == key)
+        {
+            return entries.end() - 1;
+        }
+        return std::lower_bound(entries.begin(), entries.end(), key,
+                                [](const Entry & entry, const Key & value) { return entry.first < value; });
+    }
+
+    template <typename Entries>
+    static auto Find(Entries & entries, const Key & key) -> decltype(entries.begin())
+    {
+        auto iter = LowerBound(entries, key);
+        return (iter != entries.end() && iter->first == key) ? iter : entries.end();
+    }
+
+    std::vector<Entry> mEntries;
+};
+
+} // namespace detail
+
 /*
  * This implements a cluster state cache designed to aggregate both attribute and event data received by a client
  * from either read or subscribe interactions and keep it resident and available for clients to
@@ -66,7 +175,7 @@ namespace app {
  * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time.
  *
  */
-template <bool CanEnableDataCaching>
+template <bool CanEnableDataCaching, ClusterStateCacheStorage Storage = ClusterStateCacheStorage::kTree>
 class ClusterStateCacheT : protected ReadClient::Callback
 {
 public:
@@ -436,7 +545,7 @@ public:
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
         auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
+        if (endpointIter != mCache.end())
         {
             for (auto & clusterIter : endpointIter->second)
             {
@@ -548,6 +657,10 @@ public:
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
 private:
+    template <typename Key, typename Value>
+    using StateMap = std::conditional_t<Storage == ClusterStateCacheStorage::kFlat, detail::SortedVectorMap<Key, Value>,
+                                        std::map<Key, Value>>;
+
     // An attribute state can be one of three things:
     // * If we got a path-specific error for the attribute, the corresponding
     //   status.
@@ -569,12 +682,12 @@ private:
     // and we must not be in the middle of receiving reports for that cluster.
     struct ClusterState
     {
-        std::map<AttributeId, AttributeState> mAttributes;
+        StateMap<AttributeId, AttributeState> mAttributes;
         Optional<DataVersion> mPendingDataVersion;
         Optional<DataVersion> mCommittedDataVersion;
     };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    using EndpointState = StateMap<ClusterId, ClusterState>;
+    using NodeState     = StateMap<EndpointId, EndpointState>;
 
     struct Comparator
     {
@@ -704,6 +817,10 @@ private:
 using ClusterStateCache       = ClusterStateCacheT<true>;
 using ClusterStateCacheNoData = ClusterStateCacheT<false>;
 
+// Variants with flat storage, for caches that hold large wildcard reads (e.g. of a whole bridge).
+using ClusterStateCacheFlat       = ClusterStateCacheT<true, ClusterStateCacheStorage::kFlat>;
+using ClusterStateCacheNoDataFlat = ClusterStateCacheT<false, ClusterStateCacheStorage::kFlat>;
+
 };     // namespace app
 };     // namespace chip
 #endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -159,6 +159,10 @@ ReadHandler::~ReadHandler()
     {
         mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
     }
+    if (mFlags.HasAny(ReadHandlerFlags::InterestIndexed, ReadHandlerFlags::InterestIndexFailed))
+    {
+        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().RemoveReadHandlerInterest(this);
+    }
     mManagementCallback.GetInteractionModelEngine()->ReleaseAttributePathList(mpAttributePathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseEventPathList(mpEventPathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
@@ -631,6 +635,13 @@ void ReadHandler::MoveToState(const HandlerState aTargetState)
     //
     if (aTargetState == HandlerState::CanStartReporting)
     {
+        // The attribute paths do not change once the request has been processed.
+        if (mpAttributePathList != nullptr &&
+            !mFlags.HasAny(ReadHandlerFlags::InterestIndexed, ReadHandlerFlags::InterestIndexFailed))
+        {
+            mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().AddReadHandlerInterest(this);
+        }
+
         if (ShouldReportUnscheduled())
         {
             mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().ScheduleRun();
@@ -67,6 +67,7 @@ class Engine;
 class TestReportingEngine;
 class ReportScheduler;
 class TestReportScheduler;
+class BenchmarkReportScheduler;
 } // namespace reporting
 
 class InteractionModelEngine;
@@ -306,6 +307,11 @@ private:
 
         // Don't need the response for report data if true
         SuppressResponse = (1 << 5),
+
+        // The attribute paths of the handler are in the interest index of the reporting engine, or could not all be added
+        // to it, in which case the engine checks the handler for every dirty path.
+        InterestIndexed     = (1 << 6),
+        InterestIndexFailed = (1 << 7),
     };
 
     /**
@@ -435,6 +441,7 @@ private:
     friend class TestReadInteraction;
     friend class chip::app::reporting::TestReportingEngine;
     friend class chip::app::reporting::TestReportScheduler;
+    friend class chip::app::reporting::BenchmarkReportScheduler;
 
     //
     // The engine needs to be able to Abort/Close a ReadHandler instance upon completion of work for a given read/subscribe
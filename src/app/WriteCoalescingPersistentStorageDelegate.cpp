@@ -0,0 +1,315 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/WriteCoalescingPersistentStorageDelegate.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <string.h>
+#include <utility>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Keys that do not fit in a pending write are passed on to the wrapped storage directly.
+bool CanHoldBack(const char * key)
+{
+    const size_t keyLength = strnlen(key, PersistentStorageDelegate::kKeyLengthMax + 1);
+    return keyLength > 0 && keyLength <= PersistentStorageDelegate::kKeyLengthMax;
+}
+
+} // namespace
+
+CHIP_ERROR WriteCoalescingPersistentStorageDelegate::Init(PersistentStorageDelegate * storage, System::Layer * systemLayer,
+                                                          System::Clock::Timeout window)
+{
+    VerifyOrReturnError(storage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(systemLayer != nullptr || window == System::Clock::kZero, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mStorage == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mStorage        = storage;
+    mSystemLayer    = systemLayer;
+    mWindow         = window;
+    mFlushedCount   = 0;
+    mCoalescedCount = 0;
+
+    return CHIP_NO_ERROR;
+}
+
+void WriteCoalescingPersistentStorageDelegate::Shutdown()
+{
+    VerifyOrReturn(mStorage != nullptr);
+
+    CHIP_ERROR err = Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Failed to flush %u pending storage writes on shutdown: %" CHIP_ERROR_FORMAT,
+                     static_cast<unsigned>(GetPendingCount()), err.Format());
+    }
+
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(OnWindowExpired, this);
+    }
+    for (auto & pending : mPending)
+    {
+        pending.Clear();
+    }
+
+    mStorage     = nullptr;
+    mSystemLayer = nullptr;
+}
+
+CHIP_ERROR WriteCoalescingPersistentStorageDelegate::Flush()
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // Pass the writes on in the order they were made, and stop at the first failure so that no later write reaches storage
+    // before it.
+    PendingWrite * ordered[kMaxPendingWrites];
+    size_t count = 0;
+    for (auto & pending : mPending)
+    {
+        if (pending.IsInUse())
+        {
+            ordered[count++] = &pending;
+        }
+    }
+    std::sort(ordered, ordered + count,
+              [](const PendingWrite * first, const PendingWrite * second) { return first->mSequence < second->mSequence; });
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    for (size_t i = 0; i < count && err == CHIP_NO_ERROR; i++)
+    {
+        err = FlushOne(*ordered[i]);
+        if (err == CHIP_NO_ERROR)
+        {
+            ordered[i]->Clear();
+        }
+    }
+
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(OnWindowExpired, this);
+        if (GetPendingCount() > 0)
+        {
+            // Try the writes that failed again at the end of another window.
+            StartWindow();
+        }
+    }
+
+    return err;
+}
+
+size_t WriteCoalescingPersistentStorageDelegate::GetPendingCount() const
+{
+    return static_cast<size_t>(
+        std::count_if(std::begin(mPending), std::end(mPending), [](const PendingWrite & pending) { return pending.IsInUse(); }));
+}
+
+CHIP_ERROR WriteCoalescingPersistentStorageDelegate::SyncGetKeyValue(const char * key, void * buffer, uint16_t & size)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(buffer != nullptr || size == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    PendingWrite * pending = FindPending(key);
+    if (pending == nullptr)
+    {
+        return mStorage->SyncGetKeyValue(key, buffer, size);
+    }
+
+    VerifyOrReturnError(!pending->mDeleted, CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    VerifyOrReturnError(size != 0 || pending->mSize != 0, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    size = std::min(size, pending->mSize);
+    if (size > 0)
+    {
+        memcpy(buffer, pending->mValue.Get(), size);
+    }
+
+    return (size < pending->mSize) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteCoalescingPersistentStorageDelegate::SyncSetKeyValue(const char * key, const void * value, uint16_t size)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(value != nullptr || size == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (mWindow == System::Clock::kZero || !CanHoldBack(key))
+    {
+        // Keep the order of the writes: the pending ones were made first.
+        ReturnErrorOnFailure(Flush());
+        ReturnErrorOnFailure(mStorage->SyncSetKeyValue(key, value, size));
+        mFlushedCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    // Copy the value first, so that a failed allocation leaves any pending write untouched.
+    Platform::ScopedMemoryBuffer<uint8_t> copy;
+    if (size > 0)
+    {
+        VerifyOrReturnError(copy.Alloc(size), CHIP_ERROR_NO_MEMORY);
+        memcpy(copy.Get(), value, size);
+    }
+
+    PendingWrite * pending = FindPending(key);
+    if (pending != nullptr)
+    {
+        mCoalescedCount++;
+    }
+    else
+    {
+        ReturnErrorOnFailure(AddPending(key, pending));
+    }
+
+    pending->mValue    = std::move(copy);
+    pending->mSize     = size;
+    pending->mDeleted  = false;
+    pending->mSequence = mNextSequence++;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteCoalescingPersistentStorageDelegate::SyncDeleteKeyValue(const char * key)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (mWindow == System::Clock::kZero || !CanHoldBack(key))
+    {
+        ReturnErrorOnFailure(Flush());
+        ReturnErrorOnFailure(mStorage->SyncDeleteKeyValue(key));
+        mFlushedCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    PendingWrite * pending = FindPending(key);
+    if (pending != nullptr)
+    {
+        VerifyOrReturnError(!pending->mDeleted, CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        mCoalescedCount++;
+    }
+    else
+    {
+        // Deleting a key that does not exist must still fail right away.
+        VerifyOrReturnError(mStorage->SyncDoesKeyExist(key), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        ReturnErrorOnFailure(AddPending(key, pending));
+    }
+
+    pending->mValue.Free();
+    pending->mSize     = 0;
+    pending->mDeleted  = true;
+    pending->mSequence = mNextSequence++;
+
+    return CHIP_NO_ERROR;
+}
+
+bool WriteCoalescingPersistentStorageDelegate::SyncDoesKeyExist(const char * key)
+{
+    VerifyOrReturnValue(mStorage != nullptr && key != nullptr, false);
+
+    PendingWrite * pending = FindPending(key);
+    if (pending != nullptr)
+    {
+        return !pending->mDeleted;
+    }
+
+    return mStorage->SyncDoesKeyExist(key);
+}
+
+void WriteCoalescingPersistentStorageDelegate::OnWindowExpired(System::Layer * systemLayer, void * context)
+{
+    auto * self    = static_cast<WriteCoalescingPersistentStorageDelegate *>(context);
+    CHIP_ERROR err = self->Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(AppServer, "Failed to flush pending storage writes: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+WriteCoalescingPersistentStorageDelegate::PendingWrite * WriteCoalescingPersistentStorageDelegate::FindPending(const char * key)
+{
+    VerifyOrReturnValue(CanHoldBack(key), nullptr);
+
+    for (auto & pending : mPending)
+    {
+        if (pending.IsInUse() && strcmp(pending.mKey, key) == 0)
+        {
+            return &pending;
+        }
+    }
+
+    return nullptr;
+}
+
+CHIP_ERROR WriteCoalescingPersistentStorageDelegate::AddPending(const char * key, PendingWrite *& pending)
+{
+    auto isFree = [](const PendingWrite & candidate) { return !candidate.IsInUse(); };
+
+    PendingWrite * slot = std::find_if(std::begin(mPending), std::end(mPending), isFree);
+    if (slot == std::end(mPending))
+    {
+        ReturnErrorOnFailure(Flush());
+        slot = std::find_if(std::begin(mPending), std::end(mPending), isFree);
+    }
+
+    if (GetPendingCount() == 0)
+    {
+        StartWindow();
+    }
+
+    memcpy(slot->mKey, key, strlen(key) + 1);
+    pending = slot;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteCoalescingPersistentStorageDelegate::FlushOne(PendingWrite & pending)
+{
+    if (pending.mDeleted)
+    {
+        CHIP_ERROR err = mStorage->SyncDeleteKeyValue(pending.mKey);
+        // The key was only ever written while held back, so it never reached storage.
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+    }
+    else
+    {
+        ReturnErrorOnFailure(mStorage->SyncSetKeyValue(pending.mKey, pending.mValue.Get(), pending.mSize));
+    }
+
+    mFlushedCount++;
+    return CHIP_NO_ERROR;
+}
+
+void WriteCoalescingPersistentStorageDelegate::StartWindow()
+{
+    CHIP_ERROR err = mSystemLayer->StartTimer(mWindow, OnWindowExpired, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Pending writes would not be flushed until Flush() is called.
+        ChipLogError(AppServer, "Failed to start storage write coalescing timer: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,155 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a PersistentStorageDelegate that holds back writes to
+ *      another PersistentStorageDelegate for a configurable window, so that
+ *      repeated writes of the same key only reach storage once.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/support/ScopedBuffer.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * A write-back PersistentStorageDelegate that wraps another one.
+ *
+ * Writes and deletions are kept in memory and passed on to the wrapped storage when the window
+ * that started with the first of them expires, when Flush() or Shutdown() is called, or when a
+ * key that is not already pending is written while CHIP_CONFIG_WRITE_COALESCING_STORAGE_MAX_PENDING_WRITES
+ * keys are. Only the last value written to a key during the window is stored. Reads see the
+ * pending values.
+ *
+ * A write that is held back is not durable until it is flushed: callers that must not lose a
+ * value across a reboot (e.g. before acknowledging a fail-safe commit) must call Flush().
+ * Errors from the wrapped storage are reported by Flush(); writes that fail stay pending.
+ *
+ * Crash consistency: the pending keys are passed on in the order of their last write or
+ * deletion, and a flush stops at the first one that fails. Writes to keys that cannot be held
+ * back flush the pending ones first. So whenever the process stops, the wrapped storage holds
+ * the last value of a key only if it also holds the last values of all the keys last written
+ * before it. The earlier values of a key written again within the window never reach storage,
+ * so keys that must change together in a given order should not be rewritten out of that order
+ * within a window.
+ *
+ * Using this class is opt-in: applications wrap their storage delegate in it before passing it
+ * to the server.
+ */
+class WriteCoalescingPersistentStorageDelegate : public PersistentStorageDelegate
+{
+public:
+    static constexpr size_t kMaxPendingWrites = CHIP_CONFIG_WRITE_COALESCING_STORAGE_MAX_PENDING_WRITES;
+
+    WriteCoalescingPersistentStorageDelegate() = default;
+    ~WriteCoalescingPersistentStorageDelegate() override { Shutdown(); }
+
+    // No copy, move or assignment.
+    WriteCoalescingPersistentStorageDelegate(const WriteCoalescingPersistentStorageDelegate &)             = delete;
+    WriteCoalescingPersistentStorageDelegate(const WriteCoalescingPersistentStorageDelegate &&)            = delete;
+    WriteCoalescingPersistentStorageDelegate & operator=(const WriteCoalescingPersistentStorageDelegate &) = delete;
+
+    /**
+     * @param storage      Storage that the writes are passed on to.
+     * @param systemLayer  Layer used to flush the pending writes when the window expires.
+     * @param window       How long the first of a set of writes may be held back. A zero window
+     *                     passes every write on immediately.
+     */
+    CHIP_ERROR Init(PersistentStorageDelegate * storage, System::Layer * systemLayer, System::Clock::Timeout window);
+
+    /**
+     * Flush the pending writes, then stop using the wrapped storage.
+     */
+    void Shutdown();
+
+    /**
+     * Pass all the pending writes on to the wrapped storage.
+     *
+     * @return the first error reported by the wrapped storage. Writes that failed stay pending.
+     */
+    CHIP_ERROR Flush();
+
+    /**
+     * Number of writes and deletions that were passed on to the wrapped storage.
+     */
+    uint32_t GetFlushedCount() const { return mFlushedCount; }
+
+    /**
+     * Number of writes and deletions that were replaced by a later one to the same key before
+     * reaching the wrapped storage.
+     */
+    uint32_t GetCoalescedCount() const { return mCoalescedCount; }
+
+    size_t GetPendingCount() const;
+
+    // PersistentStorageDelegate implementation
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override;
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override;
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override;
+    bool SyncDoesKeyExist(const char * key) override;
+
+private:
+    struct PendingWrite
+    {
+        bool IsInUse() const { return mKey[0] != '\0'; }
+        void Clear()
+        {
+            mKey[0] = '\0';
+            mValue.Free();
+            mSize    = 0;
+            mDeleted = false;
+        }
+
+        char mKey[kKeyLengthMax + 1] = {};
+        Platform::ScopedMemoryBuffer<uint8_t> mValue;
+        // Order of the last write or deletion of the key among all the pending ones.
+        uint64_t mSequence = 0;
+        uint16_t mSize     = 0;
+        bool mDeleted      = false;
+    };
+
+    static void OnWindowExpired(System::Layer * systemLayer, void * context);
+
+    PendingWrite * FindPending(const char * key);
+    CHIP_ERROR AddPending(const char * key, PendingWrite *& pending);
+    CHIP_ERROR FlushOne(PendingWrite & pending);
+    void StartWindow();
+
+    PersistentStorageDelegate * mStorage = nullptr;
+    System::Layer * mSystemLayer         = nullptr;
+    System::Clock::Timeout mWindow       = System::Clock::kZero;
+
+    PendingWrite mPending[kMaxPendingWrites];
+    uint64_t mNextSequence = 0;
+
+    uint32_t mFlushedCount   = 0;
+    uint32_t mCoalescedCount = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,124 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/AttributeReportCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+void AttributeReportCache::SetEnabled(bool aEnabled)
+{
+    mEnabled = aEnabled;
+    if (!mEnabled)
+    {
+        Release();
+    }
+}
+
+void AttributeReportCache::Start()
+{
+    mCount = 0;
+    mNext  = 0;
+
+    if (mEnabled && kEntryCount != 0 && !mEntries && mScratch.Calloc(kScratchSize) && mEntries.Calloc(kEntryCount))
+    {
+        mCapacity = kEntryCount;
+    }
+    // Without memory for the entries the reports are simply not cached.
+    mRunning = mEnabled && (mCapacity != 0);
+}
+
+void AttributeReportCache::Stop()
+{
+    mRunning = false;
+    mCount   = 0;
+    mNext    = 0;
+}
+
+void AttributeReportCache::Release()
+{
+    Stop();
+    mEntries.Free();
+    mScratch.Free();
+    mCapacity = 0;
+}
+
+CHIP_ERROR AttributeReportCache::Find(const Key & aKey, ByteSpan & aEncodedReports) const
+{
+    VerifyOrReturnError(mRunning, CHIP_ERROR_INCORRECT_STATE);
+
+    for (size_t i = 0; i < mCount; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (entry.mKey == aKey)
+        {
+            VerifyOrReturnError(entry.mLength > 0, CHIP_ERROR_INCORRECT_STATE);
+            aEncodedReports = ByteSpan(entry.mData, entry.mLength);
+            return CHIP_NO_ERROR;
+        }
+    }
+    return CHIP_ERROR_NOT_FOUND;
+}
+
+void AttributeReportCache::Keep(const Key & aKey, const ByteSpan & aEncodedReports)
+{
+    VerifyOrReturn(mRunning);
+
+    Entry & entry = mEntries[mNext];
+    mNext         = (mNext + 1 < mCapacity) ? mNext + 1 : 0;
+    if (mCount < mCapacity)
+    {
+        mCount++;
+    }
+
+    entry.mKey    = aKey;
+    entry.mLength = 0;
+    if (!aEncodedReports.empty() && aEncodedReports.size() <= sizeof(entry.mData))
+    {
+        memcpy(entry.mData, aEncodedReports.data(), aEncodedReports.size());
+        entry.mLength = static_cast<uint16_t>(aEncodedReports.size());
+    }
+}
+
+CHIP_ERROR AttributeReportCache::CopyReports(const ByteSpan & aEncodedReports, AttributeReportIBs::Builder & aBuilder)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType containerType;
+
+    reader.Init(aEncodedReports);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(aBuilder.GetWriter()->CopyElement(TLV::AnonymousTag(), reader));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    return reader.ExitContainer(containerType);
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,211 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/MessageDef/AttributeReportIBs.h>
+#include <app/StatusResponse.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @class AttributeReportCache
+ *
+ * @brief Keeps the encoded AttributeReportIBs of the attributes reported during one run of the reporting engine, so that an
+ * attribute reported to several subscribers is only read and encoded once.
+ *
+ * Entries are keyed on the concrete attribute path, the data version of its cluster, the accessing fabric and whether the
+ * read is fabric filtered, which is everything the encoding of a successfully read value depends on. Access control is not
+ * part of the key: the caller checks it for every subject before using an entry.
+ *
+ * Values are read into a scratch buffer as large as the room left in the report, so that whatever the read produced can be
+ * copied into the report without reading the attribute again, whether or not it ends up in an entry.
+ *
+ * The cache only holds entries while a Scope is alive, so values are never shared across runs. It is disabled by default,
+ * since it relies on attribute values only changing along with the data version of their cluster within a run.
+ */
+class AttributeReportCache
+{
+public:
+    static constexpr size_t kEntryCount = CHIP_IM_SERVER_REPORT_CACHE_ENTRIES;
+    static constexpr size_t kEntrySize  = CHIP_IM_SERVER_REPORT_CACHE_ENTRY_SIZE;
+
+    static_assert(kEntrySize <= UINT16_MAX, "The length of a cache entry must fit in a uint16_t");
+
+    struct Key
+    {
+        ConcreteAttributePath mPath;
+        DataVersion mDataVersion = 0;
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        bool mIsFabricFiltered   = false;
+
+        bool operator==(const Key & aOther) const
+        {
+            return mPath == aOther.mPath && mDataVersion == aOther.mDataVersion && mFabricIndex == aOther.mFabricIndex &&
+                mIsFabricFiltered == aOther.mIsFabricFiltered;
+        }
+    };
+
+    /**
+     * Enables the cache for its lifetime; all the entries are dropped when it is destroyed.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(AttributeReportCache & cache) : mCache(cache) { mCache.Start(); }
+        ~Scope() { mCache.Stop(); }
+
+        Scope(const Scope &)             = delete;
+        Scope & operator=(const Scope &) = delete;
+
+    private:
+        AttributeReportCache & mCache;
+    };
+
+    AttributeReportCache() = default;
+
+    AttributeReportCache(const AttributeReportCache &)             = delete;
+    AttributeReportCache & operator=(const AttributeReportCache &) = delete;
+
+    /**
+     * Enable or disable the cache. Disabling it frees the memory of the entries.
+     */
+    void SetEnabled(bool aEnabled);
+    bool IsEnabled() const { return mEnabled; }
+
+    bool IsRunning() const { return mRunning; }
+
+    /**
+     * Look up the encoded reports of the key.
+     *
+     * @retval CHIP_NO_ERROR               aEncodedReports is set to the cached reports.
+     * @retval CHIP_ERROR_NOT_FOUND        The reports are not cached, but can be encoded with Encode().
+     * @retval CHIP_ERROR_INCORRECT_STATE  The cache is not running, or the reports could not be cached earlier in this run.
+     */
+    CHIP_ERROR Find(const Key & aKey, ByteSpan & aEncodedReports) const;
+
+    /**
+     * Whether Encode() can encode reports taking up to aMaxLength bytes of a report, which needs the cache to be running.
+     */
+    bool CanEncode(uint32_t aMaxLength) const
+    {
+        return mRunning && aMaxLength <= kScratchSize - kReservedSizeStartOfReportIBs - kReservedSizeEndOfReportIBs;
+    }
+
+    /**
+     * Encode the reports of the key, taking up to aMaxLength bytes, and keep them in an entry, evicting the oldest entry if
+     * needed. Must only be called when CanEncode(aMaxLength) is true.
+     *
+     * aEncode is called once with an AttributeReportIBs::Builder to encode the reports into and returns a CHIP_ERROR, which is
+     * returned as is. aEncodedReports is set to the reports it wrote, even when it fails, as long as they are complete
+     * AttributeReportIBs; they stay valid until the next call. When aEncode fails, or the reports do not fit in an entry, the
+     * key is remembered as not cacheable for the rest of the run. When it encodes nothing, the key is left out of the cache.
+     */
+    template <typename EncodeFunction>
+    CHIP_ERROR Encode(const Key & aKey, uint32_t aMaxLength, EncodeFunction && aEncode, ByteSpan & aEncodedReports)
+    {
+        VerifyOrReturnError(CanEncode(aMaxLength), CHIP_ERROR_INCORRECT_STATE);
+        aEncodedReports = ByteSpan();
+
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        writer.Init(mScratch.Get(), aMaxLength + kReservedSizeStartOfReportIBs + kReservedSizeEndOfReportIBs);
+        ReturnErrorOnFailure(builder.Init(&writer));
+        ReturnErrorOnFailure(writer.ReserveBuffer(kReservedSizeEndOfReportIBs));
+
+        const uint32_t emptyLength = writer.GetLengthWritten();
+        const CHIP_ERROR err       = aEncode(builder);
+        const bool encoded         = (writer.GetLengthWritten() != emptyLength);
+
+        if (writer.UnreserveBuffer(kReservedSizeEndOfReportIBs) == CHIP_NO_ERROR &&
+            builder.EndOfAttributeReportIBs() == CHIP_NO_ERROR && writer.Finalize() == CHIP_NO_ERROR)
+        {
+            aEncodedReports = ByteSpan(mScratch.Get(), writer.GetLengthWritten());
+        }
+
+        if (encoded || err != CHIP_NO_ERROR)
+        {
+            Keep(aKey, (err == CHIP_NO_ERROR) ? aEncodedReports : ByteSpan());
+        }
+        return err;
+    }
+
+    /**
+     * Whether the AttributeReportIBs of reports returned by Find() take up to aMaxLength bytes once appended to a report.
+     */
+    static bool Fits(const ByteSpan & aEncodedReports, uint32_t aMaxLength)
+    {
+        return aEncodedReports.size() <= aMaxLength + kReservedSizeStartOfReportIBs + kReservedSizeEndOfReportIBs;
+    }
+
+    /**
+     * Append the AttributeReportIBs of reports returned by Find() or Encode() to aBuilder.
+     */
+    static CHIP_ERROR CopyReports(const ByteSpan & aEncodedReports, AttributeReportIBs::Builder & aBuilder);
+
+    /**
+     * Free the memory of the entries.
+     */
+    void Release();
+
+private:
+    // The reports are encoded into an AttributeReportIBs array, which takes one byte to open and one byte to close.
+    static constexpr uint32_t kReservedSizeStartOfReportIBs = 1;
+    static constexpr uint32_t kReservedSizeEndOfReportIBs   = 1;
+    // The largest report that is not sent over a large payload session.
+    static constexpr size_t kScratchSize = kMaxSecureSduLengthBytes;
+
+    struct Entry
+    {
+        Key mKey;
+        // Zero when the reports of the key could not be cached.
+        uint16_t mLength = 0;
+        uint8_t mData[kEntrySize];
+    };
+
+    void Start();
+    void Stop();
+
+    /**
+     * Keep the reports of the key in an entry, reusing the oldest entry when they are all taken. Empty or oversized reports
+     * mark the key as not cacheable.
+     */
+    void Keep(const Key & aKey, const ByteSpan & aEncodedReports);
+
+    Platform::ScopedMemoryBuffer<Entry> mEntries;
+    Platform::ScopedMemoryBuffer<uint8_t> mScratch;
+    size_t mCapacity = 0;
+    size_t mCount    = 0;
+    size_t mNext     = 0;
+    bool mRunning    = false;
+    bool mEnabled    = false;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
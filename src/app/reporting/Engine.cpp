@@ -57,7 +57,8 @@ void Engine::Shutdown()
 
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
-    mGlobalDirtySet.ReleaseAll();
+    ReleaseAllDirtyPaths();
+    mAttributeReportCache.Release();
 }
 
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
@@ -85,6 +86,69 @@ static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
     return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
 }
 
+CHIP_ERROR Engine::RetrieveClusterData(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                       const ConcreteReadAttributePath & aPath, AttributeEncodeState * apEncoderState)
+{
+    const Access::SubjectDescriptor subjectDescriptor = apReadHandler->GetSubjectDescriptor();
+    const uint32_t maxLength                          = aAttributeReportIBs.GetWriter()->GetRemainingFreeLength();
+
+    // Only whole values are shared: a list that is being chunked continues from the state of this read handler.
+    if (!aPath.mListIndex.HasValue() && apEncoderState->CurrentEncodingListIndex() == kInvalidListIndex &&
+        mAttributeReportCache.CanEncode(maxLength))
+    {
+        std::optional<InteractionModel::ClusterInfo> clusterInfo = mpImEngine->GetDataModel()->GetClusterInfo(aPath);
+        if (clusterInfo.has_value())
+        {
+            AttributeReportCache::Key key;
+            key.mPath             = aPath;
+            key.mDataVersion      = clusterInfo->dataVersion;
+            key.mFabricIndex      = subjectDescriptor.fabricIndex;
+            key.mIsFabricFiltered = apReadHandler->IsFabricFiltered();
+
+            ByteSpan encodedReports;
+            CHIP_ERROR err = mAttributeReportCache.Find(key, encodedReports);
+            if (err == CHIP_ERROR_NOT_FOUND)
+            {
+                // The data model checks access control: a denied subject gets an error or no reports, which are not kept.
+                err = mAttributeReportCache.Encode(
+                    key, maxLength,
+                    [&](AttributeReportIBs::Builder & builder) {
+                        return Impl::RetrieveClusterData(mpImEngine->GetDataModel(), subjectDescriptor, key.mIsFabricFiltered,
+                                                         builder, aPath, apEncoderState);
+                    },
+                    encodedReports);
+
+                // Report what the read produced rather than reading the attribute again; the caller rolls back the rest.
+                if (!encodedReports.empty() &&
+                    (err == CHIP_NO_ERROR || (apEncoderState->AllowPartialData() && IsOutOfWriterSpaceError(err))))
+                {
+                    ReturnErrorOnFailure(AttributeReportCache::CopyReports(encodedReports, aAttributeReportIBs));
+                }
+                return err;
+            }
+
+            // Cached reports are only used by subjects allowed to read the attribute. Denied subjects, and reports that do
+            // not fit in this chunk, go through the data model, whose own check is answered by the per-report CheckCache.
+            Access::RequestPath requestPath{ .cluster = aPath.mClusterId, .endpoint = aPath.mEndpointId };
+            if (err == CHIP_NO_ERROR && AttributeReportCache::Fits(encodedReports, maxLength) &&
+                Access::GetAccessControl().Check(subjectDescriptor, requestPath, RequiredPrivilege::ForReadAttribute(aPath)) ==
+                    CHIP_NO_ERROR)
+            {
+                // Serving the read from the cache is still a read of the attribute for the application.
+                DataModelCallbacks::GetInstance()->AttributeOperation(DataModelCallbacks::OperationType::Read,
+                                                                      DataModelCallbacks::OperationOrder::Pre, aPath);
+                ReturnErrorOnFailure(AttributeReportCache::CopyReports(encodedReports, aAttributeReportIBs));
+                DataModelCallbacks::GetInstance()->AttributeOperation(DataModelCallbacks::OperationType::Read,
+                                                                      DataModelCallbacks::OperationOrder::Post, aPath);
+                return CHIP_NO_ERROR;
+            }
+        }
+    }
+
+    return Impl::RetrieveClusterData(mpImEngine->GetDataModel(), subjectDescriptor, apReadHandler->IsFabricFiltered(),
+                                     aAttributeReportIBs, aPath, apEncoderState);
+}
+
 CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder,
                                                            ReadHandler * apReadHandler, bool * apHasMoreChunks,
                                                            bool * apHasEncodedData)
@@ -137,23 +201,10 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         {
             if (!apReadHandler->IsPriming())
             {
-                bool concretePathDirty = false;
                 // TODO: Optimize this implementation by making the iterator only emit intersected paths.
-                mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
-                    if (dirtyPath->IsAttributePathSupersetOf(readPath))
-                    {
-                        // We don't need to worry about paths that were already marked dirty before the last time this read handler
-                        // started a report that it completed: those paths already got reported.
-                        if (dirtyPath->mGeneration > apReadHandler->mPreviousReportsBeginGeneration)
-                        {
-                            concretePathDirty = true;
-                            return Loop::Break;
-                        }
-                    }
-                    return Loop::Continue;
-                });
-
-                if (!concretePathDirty)
+                // We don't need to worry about paths that were already marked dirty before the last time this read handler
+                // started a report that it completed: those paths already got reported.
+                if (!IsAttributePathDirtySince(readPath, apReadHandler->mPreviousReportsBeginGeneration))
                 {
                     // This attribute is not dirty, we just skip this one.
                     continue;
@@ -182,8 +233,7 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             ConcreteReadAttributePath pathForRetrieval(readPath);
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
-            err = Impl::RetrieveClusterData(mpImEngine->GetDataModel(), apReadHandler->GetSubjectDescriptor(),
-                                            apReadHandler->IsFabricFiltered(), attributeReportIBs, pathForRetrieval, &encodeState);
+            err = RetrieveClusterData(apReadHandler, attributeReportIBs, pathForRetrieval, &encodeState);
             if (err != CHIP_NO_ERROR)
             {
                 // If error is not an "out of writer space" error, rollback and encode status.
@@ -480,6 +530,10 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     bool needCloseReadHandler                  = false;
     size_t reportBufferMaxSize                 = 0;
 
+    // Every path in this report is checked for the same subject, so the access control decisions
+    // for a cluster instance are looked up once rather than once per attribute or event.
+    Access::AccessControl::CheckCache accessCheckCache(Access::GetAccessControl());
+
     // Reserved size for the MoreChunks boolean flag, which takes up 1 byte for the control tag and 1 byte for the context tag.
     const uint32_t kReservedSizeForMoreChunksFlag = 1 + 1;
 
@@ -650,6 +704,9 @@ void Engine::Run()
 {
     uint32_t numReadHandled = 0;
 
+    // Reports of the same attribute values to several read handlers in this run are only read and encoded once.
+    AttributeReportCache::Scope reportCacheScope(mAttributeReportCache);
+
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = mpImEngine->mReadHandlers.Allocated();
@@ -704,33 +761,126 @@ void Engine::Run()
     {
         ChipLogDetail(DataManagement, "All ReadHandler-s are clean, clear GlobalDirtySet");
 
-        mGlobalDirtySet.ReleaseAll();
+        ReleaseAllDirtyPaths();
     }
 }
 
+bool Engine::MergeIntoDirtyPath(AttributePathParamsWithGeneration * apPath, const AttributePathParams & aAttributePath)
+{
+    if (apPath->IsAttributePathSupersetOf(aAttributePath))
+    {
+        apPath->mGeneration = GetDirtySetGeneration();
+        return true;
+    }
+    if (aAttributePath.IsAttributePathSupersetOf(*apPath))
+    {
+        // TODO: the wildcard input path may be superset of next paths in globalDirtySet, it is fine at this moment, since
+        // when building report, it would use the first path of globalDirtySet to compare against interested paths read clients
+        // want.
+        // It is better to eliminate the duplicate wildcard paths in follow-up
+        UnlinkDirtyPath(apPath);
+        apPath->mGeneration  = GetDirtySetGeneration();
+        apPath->mEndpointId  = aAttributePath.mEndpointId;
+        apPath->mClusterId   = aAttributePath.mClusterId;
+        apPath->mListIndex   = aAttributePath.mListIndex;
+        apPath->mAttributeId = aAttributePath.mAttributeId;
+        LinkDirtyPath(apPath);
+        return true;
+    }
+    return false;
+}
+
 bool Engine::MergeOverlappedAttributePath(const AttributePathParams & aAttributePath)
 {
-    return Loop::Break == mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
+    const size_t bucket = GetDirtySetBucket(aAttributePath);
+    if (bucket == kDirtySetIndexBucketCount)
+    {
+        return Loop::Break == mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
+            return MergeIntoDirtyPath(path, aAttributePath) ? Loop::Break : Loop::Continue;
+        });
+    }
+
+    // A path with a concrete endpoint, cluster and attribute can only overlap with the paths of its own bucket, or with a
+    // wildcard path, which cannot be a subset of it.
+    for (auto * path = mDirtySetIndex[bucket]; path != nullptr; path = path->mpNext)
+    {
+        if (MergeIntoDirtyPath(path, aAttributePath))
+        {
+            return true;
+        }
+    }
+    for (auto * path = mDirtySetIndex[kDirtySetIndexBucketCount]; path != nullptr; path = path->mpNext)
+    {
         if (path->IsAttributePathSupersetOf(aAttributePath))
         {
             path->mGeneration = GetDirtySetGeneration();
-            return Loop::Break;
+            return true;
         }
-        if (aAttributePath.IsAttributePathSupersetOf(*path))
-        {
-            // TODO: the wildcard input path may be superset of next paths in globalDirtySet, it is fine at this moment, since
-            // when building report, it would use the first path of globalDirtySet to compare against interested paths read clients
-            // want.
-            // It is better to eliminate the duplicate wildcard paths in follow-up
-            path->mGeneration  = GetDirtySetGeneration();
-            path->mEndpointId  = aAttributePath.mEndpointId;
-            path->mClusterId   = aAttributePath.mClusterId;
-            path->mListIndex   = aAttributePath.mListIndex;
-            path->mAttributeId = aAttributePath.mAttributeId;
-            return Loop::Break;
+    }
+    return false;
+}
+
+bool Engine::IsAttributePathDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const
+{
+    const size_t buckets[] = { GetDirtySetBucket(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId),
+                               kDirtySetIndexBucketCount };
+    for (size_t bucket : buckets)
+    {
+        for (auto * path = mDirtySetIndex[bucket]; path != nullptr; path = path->mpNext)
+        {
+            if (path->mGeneration > aGeneration && path->IsAttributePathSupersetOf(aPath))
+            {
+                return true;
+            }
         }
-        return Loop::Continue;
-    });
+    }
+    return false;
+}
+
+Engine::AttributePathParamsWithGeneration * Engine::CreateDirtyPath(const AttributePathParams & aAttributePath)
+{
+    auto object = mGlobalDirtySet.CreateObject(aAttributePath);
+    if (object != nullptr)
+    {
+        object->mGeneration = GetDirtySetGeneration();
+        LinkDirtyPath(object);
+    }
+    return object;
+}
+
+void Engine::ReleaseDirtyPath(AttributePathParamsWithGeneration * apPath)
+{
+    UnlinkDirtyPath(apPath);
+    mGlobalDirtySet.ReleaseObject(apPath);
+}
+
+void Engine::ReleaseAllDirtyPaths()
+{
+    mGlobalDirtySet.ReleaseAll();
+    for (auto & head : mDirtySetIndex)
+    {
+        head = nullptr;
+    }
+}
+
+void Engine::LinkDirtyPath(AttributePathParamsWithGeneration * apPath)
+{
+    const size_t bucket    = GetDirtySetBucket(*apPath);
+    apPath->mpNext         = mDirtySetIndex[bucket];
+    mDirtySetIndex[bucket] = apPath;
+}
+
+void Engine::UnlinkDirtyPath(AttributePathParamsWithGeneration * apPath)
+{
+    for (auto ** link = &mDirtySetIndex[GetDirtySetBucket(*apPath)]; *link != nullptr; link = &(*link)->mpNext)
+    {
+        if (*link == apPath)
+        {
+            *link          = apPath->mpNext;
+            apPath->mpNext = nullptr;
+            return;
+        }
+    }
 }
 
 bool Engine::ClearTombPaths()
@@ -739,7 +889,7 @@ bool Engine::ClearTombPaths()
     mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
         if (path->mGeneration == 0)
         {
-            mGlobalDirtySet.ReleaseObject(path);
+            ReleaseDirtyPath(path);
             pathReleased = true;
         }
         return Loop::Continue;
@@ -769,7 +919,9 @@ bool Engine::MergeDirtyPathsUnderSameCluster()
             {
                 outerPath->mGeneration = innerPath->mGeneration;
             }
+            UnlinkDirtyPath(outerPath);
             outerPath->SetWildcardAttributeId();
+            LinkDirtyPath(outerPath);
 
             // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
             // generation to 0 and then clear it later.
@@ -802,8 +954,10 @@ bool Engine::MergeDirtyPathsUnderSameEndpoint()
             {
                 outerPath->mGeneration = innerPath->mGeneration;
             }
+            UnlinkDirtyPath(outerPath);
             outerPath->SetWildcardClusterId();
             outerPath->SetWildcardAttributeId();
+            LinkDirtyPath(outerPath);
 
             // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
             // generation to 0 and then clear it later.
@@ -822,51 +976,145 @@ CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttribute
     if (mGlobalDirtySet.Exhausted() && !MergeDirtyPathsUnderSameCluster() && !MergeDirtyPathsUnderSameEndpoint())
     {
         ChipLogDetail(DataManagement, "Global dirty set pool exhausted, merge all paths.");
-        mGlobalDirtySet.ReleaseAll();
-        auto object         = mGlobalDirtySet.CreateObject();
-        object->mGeneration = GetDirtySetGeneration();
+        ReleaseAllDirtyPaths();
+        CreateDirtyPath(AttributePathParams());
     }
 
     ReturnErrorCodeIf(MergeOverlappedAttributePath(aAttributePath), CHIP_NO_ERROR);
     ChipLogDetail(DataManagement, "Cannot merge the new path into any existing path, create one.");
 
-    auto object = mGlobalDirtySet.CreateObject();
-    if (object == nullptr)
+    if (CreateDirtyPath(aAttributePath) == nullptr)
     {
         // This should not happen, this path should be merged into the wildcard endpoint at least.
         ChipLogError(DataManagement, "mGlobalDirtySet pool full, cannot handle more entries!");
         return CHIP_ERROR_NO_MEMORY;
     }
-    *object             = aAttributePath;
-    object->mGeneration = GetDirtySetGeneration();
 
     return CHIP_NO_ERROR;
 }
 
+void Engine::AddReadHandlerInterest(ReadHandler * apReadHandler)
+{
+    VerifyOrReturn(!apReadHandler->mFlags.HasAny(ReadHandler::ReadHandlerFlags::InterestIndexed,
+                                                 ReadHandler::ReadHandlerFlags::InterestIndexFailed));
+
+    for (auto object = apReadHandler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+    {
+        AttributeInterest * interest = mInterestPool.CreateObject();
+        if (interest == nullptr)
+        {
+            // Without all of its paths in the index, the handler is checked for every dirty path instead.
+            ChipLogError(DataManagement, "<RE> Interest index is full, ReadHandler %p will not be indexed", apReadHandler);
+            RemoveReadHandlerInterest(apReadHandler);
+            apReadHandler->mFlags.Set(ReadHandler::ReadHandlerFlags::InterestIndexFailed);
+            mNumUnindexedReadHandlers++;
+            return;
+        }
+
+        const size_t bucket     = GetInterestBucket(object->mValue);
+        interest->mpReadHandler = apReadHandler;
+        interest->mpPath        = &object->mValue;
+        interest->mpNext        = mInterestIndex[bucket];
+        mInterestIndex[bucket]  = interest;
+    }
+
+    apReadHandler->mFlags.Set(ReadHandler::ReadHandlerFlags::InterestIndexed);
+}
+
+void Engine::RemoveReadHandlerInterest(ReadHandler * apReadHandler)
+{
+    for (auto & head : mInterestIndex)
+    {
+        AttributeInterest ** link = &head;
+        while (*link != nullptr)
+        {
+            AttributeInterest * interest = *link;
+            if (interest->mpReadHandler == apReadHandler)
+            {
+                *link = interest->mpNext;
+                mInterestPool.ReleaseObject(interest);
+            }
+            else
+            {
+                link = &interest->mpNext;
+            }
+        }
+    }
+
+    if (apReadHandler->mFlags.Has(ReadHandler::ReadHandlerFlags::InterestIndexFailed))
+    {
+        VerifyOrDie(mNumUnindexedReadHandlers > 0);
+        mNumUnindexedReadHandlers--;
+    }
+    apReadHandler->mFlags.Clear(ReadHandler::ReadHandlerFlags::InterestIndexed)
+        .Clear(ReadHandler::ReadHandlerFlags::InterestIndexFailed);
+}
+
+void Engine::MarkDirtyIfInterested(ReadHandler * apReadHandler, const AttributePathParams * apInterestPath,
+                                   const AttributePathParams & aDirtyPath, bool & aIntersectsInterestPath)
+{
+    // A handler with several paths intersecting the dirty path only needs to be told once per SetDirty call.
+    if (apReadHandler->mDirtyGeneration == mDirtyGeneration)
+    {
+        aIntersectsInterestPath = true;
+        return;
+    }
+
+    // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
+    // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
+    // waiting for a response to the last message chunk for read interactions.
+    VerifyOrReturn(apReadHandler->CanStartReporting() || apReadHandler->IsAwaitingReportResponse());
+
+    if (apInterestPath != nullptr)
+    {
+        VerifyOrReturn(apInterestPath->Intersects(aDirtyPath));
+        apReadHandler->AttributePathIsDirty(aDirtyPath);
+        aIntersectsInterestPath = true;
+        return;
+    }
+
+    for (auto object = apReadHandler->GetAttributePathList(); object != nullptr; object = object->mpNext)
+    {
+        if (object->mValue.Intersects(aDirtyPath))
+        {
+            apReadHandler->AttributePathIsDirty(aDirtyPath);
+            aIntersectsInterestPath = true;
+            break;
+        }
+    }
+}
+
 CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
 {
     BumpDirtySetGeneration();
 
     bool intersectsInterestPath = false;
-    mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
-        // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
-        // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
-        // waiting for a response to the last message chunk for read interactions.
-        if (handler->CanStartReporting() || handler->IsAwaitingReportResponse())
+
+    // Only the handlers with a path in the cluster of the dirty path, or with a wildcard cluster, can be interested in it.
+    const size_t dirtyBucket = GetInterestBucket(aAttributePath);
+    for (size_t bucket = 0; bucket <= kInterestIndexBucketCount; bucket++)
+    {
+        if (dirtyBucket != kInterestIndexBucketCount && bucket != dirtyBucket && bucket != kInterestIndexBucketCount)
         {
-            for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
-            {
-                if (object->mValue.Intersects(aAttributePath))
-                {
-                    handler->AttributePathIsDirty(aAttributePath);
-                    intersectsInterestPath = true;
-                    break;
-                }
-            }
+            continue;
         }
 
-        return Loop::Continue;
-    });
+        for (AttributeInterest * interest = mInterestIndex[bucket]; interest != nullptr; interest = interest->mpNext)
+        {
+            MarkDirtyIfInterested(interest->mpReadHandler, interest->mpPath, aAttributePath, intersectsInterestPath);
+        }
+    }
+
+    if (mNumUnindexedReadHandlers > 0)
+    {
+        mpImEngine->mReadHandlers.ForEachActiveObject([this, &aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
+            if (handler->mFlags.Has(ReadHandler::ReadHandlerFlags::InterestIndexFailed))
+            {
+                MarkDirtyIfInterested(handler, nullptr, aAttributePath, intersectsInterestPath);
+            }
+            return Loop::Continue;
+        });
+    }
 
     if (!intersectsInterestPath)
     {
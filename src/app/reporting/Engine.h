@@ -27,6 +27,7 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/AttributeReportCache.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -95,6 +96,18 @@ public:
      */
     CHIP_ERROR SetDirty(AttributePathParams & aAttributePathParams);
 
+    /**
+     * Add the attribute paths of a ReadHandler that can start reporting to the interest index, so that SetDirty only
+     * looks at the handlers whose paths may intersect the dirty path. The attribute path list of the handler must not
+     * change until RemoveReadHandlerInterest() is called.
+     */
+    void AddReadHandlerInterest(ReadHandler * apReadHandler);
+
+    /**
+     * Remove the attribute paths of a ReadHandler from the interest index.
+     */
+    void RemoveReadHandlerInterest(ReadHandler * apReadHandler);
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -136,6 +149,13 @@ public:
      */
     void ScheduleUrgentEventDeliverySync(Optional<FabricIndex> fabricIndex = NullOptional);
 
+    /**
+     * Enable or disable sharing the encoded value of an attribute between the read handlers that report it during the same
+     * run, when their data version, accessing fabric and fabric filtering are the same. Only enable it when every attribute
+     * value served by the data model changes along with the data version of its cluster. Disabled by default.
+     */
+    void SetAttributeReportCacheEnabled(bool aEnabled) { mAttributeReportCache.SetEnabled(aEnabled); }
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
 #endif
@@ -147,6 +167,7 @@ private:
     void Run();
 
     friend class TestReportingEngine;
+    friend class BenchmarkReportingEngine;
     friend class ::chip::app::TestReadInteraction;
 
     bool IsRunScheduled() const { return mRunScheduled; }
@@ -156,6 +177,8 @@ private:
         AttributePathParamsWithGeneration() {}
         AttributePathParamsWithGeneration(const AttributePathParams aPath) : AttributePathParams(aPath) {}
         uint64_t mGeneration = 0;
+        // Next path in the same dirty set index bucket.
+        AttributePathParamsWithGeneration * mpNext = nullptr;
     };
 
     /**
@@ -170,6 +193,13 @@ private:
                                                  bool aBufferIsUsed, bool * apHasMoreChunks, bool * apHasEncodedData);
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
+    /**
+     * Encode the value of an attribute for the read handler, reusing the reports encoded for another read handler during the
+     * same run when they are the same.
+     */
+    CHIP_ERROR RetrieveClusterData(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                   const ConcreteReadAttributePath & aPath, AttributeEncodeState * apEncoderState);
+
     // If version match, it means don't send, if version mismatch, it means send.
     // If client sends the same path with multiple data versions, client will get the data back per the spec, because at least one
     // of those will fail to match.  This function should return false if either nothing in the list matches the given
@@ -226,8 +256,76 @@ private:
 
     CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
+    /**
+     * Returns whether a path in the global dirty set that includes the given path was marked dirty after the given
+     * generation.
+     */
+    bool IsAttributePathDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const;
+
+    static constexpr size_t kDirtySetIndexBucketCount = CHIP_IM_SERVER_NUM_DIRTY_SET_INDEX_BUCKETS;
+
+    // Paths with a concrete endpoint, cluster and attribute are hashed on them, all the other paths go in the last bucket.
+    static size_t GetDirtySetBucket(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+    {
+        const uint32_t hash = (static_cast<uint32_t>(aEndpointId) * 31u + aClusterId) * 31u + aAttributeId;
+        return hash % kDirtySetIndexBucketCount;
+    }
+    static size_t GetDirtySetBucket(const AttributePathParams & aPath)
+    {
+        return aPath.IsWildcardPath() ? kDirtySetIndexBucketCount
+                                      : GetDirtySetBucket(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    }
+
+    /**
+     * Allocate a path in the global dirty set and add it to the dirty set index. Returns nullptr if the pool is exhausted.
+     */
+    AttributePathParamsWithGeneration * CreateDirtyPath(const AttributePathParams & aAttributePath);
+    void ReleaseDirtyPath(AttributePathParamsWithGeneration * apPath);
+    void ReleaseAllDirtyPaths();
+
+    /**
+     * The dirty set index is keyed on the path, so a path in the global dirty set must be unlinked before it is changed and
+     * linked again afterwards.
+     */
+    void LinkDirtyPath(AttributePathParamsWithGeneration * apPath);
+    void UnlinkDirtyPath(AttributePathParamsWithGeneration * apPath);
+
+    /**
+     * Merge the provided path into an existing path of the global dirty set, when one of them is a superset of the other.
+     *
+     * Returns whether the provided path has been merged.
+     */
+    bool MergeIntoDirtyPath(AttributePathParamsWithGeneration * apPath, const AttributePathParams & aAttributePath);
+
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
+    /**
+     * An attribute path of a ReadHandler, in the interest index bucket of its cluster.
+     */
+    struct AttributeInterest
+    {
+        ReadHandler * mpReadHandler        = nullptr;
+        const AttributePathParams * mpPath = nullptr;
+        AttributeInterest * mpNext         = nullptr;
+    };
+
+    static constexpr size_t kInterestIndexBucketCount = CHIP_IM_SERVER_NUM_INTEREST_INDEX_BUCKETS;
+    static constexpr size_t kInterestPoolSize =
+        CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS;
+
+    // Paths with a wildcard cluster ID go in the last bucket.
+    static size_t GetInterestBucket(const AttributePathParams & aPath)
+    {
+        return aPath.HasWildcardClusterId() ? kInterestIndexBucketCount : (aPath.mClusterId % kInterestIndexBucketCount);
+    }
+
+    /**
+     * Call AttributePathIsDirty on the handler if it can report and apInterestPath, or any of its attribute paths when
+     * apInterestPath is null, intersects the dirty path.
+     */
+    void MarkDirtyIfInterested(ReadHandler * apReadHandler, const AttributePathParams * apInterestPath,
+                               const AttributePathParams & aDirtyPath, bool & aIntersectsInterestPath);
+
     /**
      * Boolean to indicate if ScheduleRun is pending. This flag is used to prevent calling ScheduleRun multiple times
      * within the same execution context to avoid applying too much pressure on platforms that use small, fixed size event queues.
@@ -277,6 +375,28 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+    /**
+     * The paths of mGlobalDirtySet, chained by their concrete endpoint, cluster and attribute, so that a path can be looked up
+     * without going through the whole set.
+     */
+    AttributePathParamsWithGeneration * mDirtySetIndex[kDirtySetIndexBucketCount + 1] = {};
+
+    /**
+     * Attribute paths of the ReadHandlers that can report, chained by cluster ID.
+     */
+    AttributeInterest * mInterestIndex[kInterestIndexBucketCount + 1] = {};
+    ObjectPool<AttributeInterest, kInterestPoolSize> mInterestPool;
+
+    /**
+     * Number of ReadHandlers whose paths could not all be added to the interest index.
+     */
+    size_t mNumUnindexedReadHandlers = 0;
+
+    /**
+     * Attribute reports encoded during the current run, shared by the read handlers reporting the same values.
+     */
+    AttributeReportCache mAttributeReportCache;
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
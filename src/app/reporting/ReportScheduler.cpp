@@ -0,0 +1,212 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportScheduler.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+using ReadHandlerNode = ReportScheduler::ReadHandlerNode;
+
+ReadHandlerNode * ReportScheduler::CreateReadHandlerNode(ReadHandler * aReadHandler, const Timestamp & now)
+{
+    ReadHandlerNode * node = mNodesPool.CreateObject(aReadHandler, this, now);
+    VerifyOrReturnValue(nullptr != node, nullptr);
+
+    ReadHandlerNode *& bucket = mNodeIndex[GetNodeIndexBucket(aReadHandler)];
+    node->mpNextInBucket      = bucket;
+    bucket                    = node;
+
+    if (!ReserveDeadlineQueue(mDeadlineQueueSize + 1))
+    {
+        // The node is still scheduled; FindEarliestMaxTimestampAfter goes through the whole pool until it is released.
+        mNumUnqueuedNodes++;
+        return node;
+    }
+
+    PlaceInDeadlineQueue(node, mDeadlineQueueSize++);
+    SiftDeadlineUp(node->mDeadlineIndex);
+    return node;
+}
+
+void ReportScheduler::ReleaseReadHandlerNode(ReadHandlerNode * aNode)
+{
+    ReadHandlerNode ** link = &mNodeIndex[GetNodeIndexBucket(aNode->GetReadHandler())];
+    while (*link != nullptr && *link != aNode)
+    {
+        link = &(*link)->mpNextInBucket;
+    }
+    if (*link != nullptr)
+    {
+        *link = aNode->mpNextInBucket;
+    }
+
+    if (aNode->mDeadlineIndex == ReadHandlerNode::kNotQueued)
+    {
+        mNumUnqueuedNodes--;
+    }
+    else
+    {
+        // Move the last node of the queue in place of the removed one, then restore the order around it.
+        const size_t index = aNode->mDeadlineIndex;
+        mDeadlineQueueSize--;
+        if (index != mDeadlineQueueSize)
+        {
+            PlaceInDeadlineQueue(mDeadlineQueue[mDeadlineQueueSize], index);
+            UpdateDeadline(mDeadlineQueue[index]);
+        }
+        aNode->mDeadlineIndex = ReadHandlerNode::kNotQueued;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    if (mDeadlineQueueSize == 0)
+    {
+        mDeadlineQueue.Free();
+        mDeadlineQueueCapacity = 0;
+    }
+#endif
+
+    mNodesPool.ReleaseObject(aNode);
+}
+
+ReportScheduler::Timestamp ReportScheduler::FindEarliestMaxTimestampAfter(const Timestamp & now, const Timestamp & aDefault) const
+{
+    Timestamp earliest = aDefault;
+
+    if (mNumUnqueuedNodes > 0)
+    {
+        mNodesPool.ForEachActiveObject([&earliest, now](const ReadHandlerNode * node) {
+            if (node->GetMaxTimestamp() < earliest && node->GetMaxTimestamp() > now)
+            {
+                earliest = node->GetMaxTimestamp();
+            }
+
+            return Loop::Continue;
+        });
+        return earliest;
+    }
+
+    if (mDeadlineQueueSize > 0)
+    {
+        FindEarliestMaxTimestampAfter(0, now, earliest);
+    }
+    return earliest;
+}
+
+void ReportScheduler::FindEarliestMaxTimestampAfter(size_t aIndex, const Timestamp & now, Timestamp & aEarliest) const
+{
+    const Timestamp maxTimestamp = mDeadlineQueue[aIndex]->GetMaxTimestamp();
+    if (maxTimestamp > now)
+    {
+        // The nodes below have later max timestamps, so this is the earliest one of the subtree.
+        if (maxTimestamp < aEarliest)
+        {
+            aEarliest = maxTimestamp;
+        }
+        return;
+    }
+
+    // Only the nodes whose max timestamp has passed are looked through, which are about to report anyway.
+    for (size_t child = 2 * aIndex + 1; child <= 2 * aIndex + 2 && child < mDeadlineQueueSize; child++)
+    {
+        FindEarliestMaxTimestampAfter(child, now, aEarliest);
+    }
+}
+
+void ReportScheduler::UpdateDeadline(ReadHandlerNode * aNode)
+{
+    const size_t index = aNode->mDeadlineIndex;
+    SiftDeadlineUp(index);
+    if (aNode->mDeadlineIndex == index)
+    {
+        SiftDeadlineDown(index);
+    }
+}
+
+bool ReportScheduler::ReserveDeadlineQueue(size_t aSize)
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    VerifyOrReturnValue(aSize > mDeadlineQueueCapacity, true);
+
+    const size_t capacity = (mDeadlineQueueCapacity == 0) ? kNodesPoolSize : 2 * mDeadlineQueueCapacity;
+    Platform::ScopedMemoryBuffer<ReadHandlerNode *> queue;
+    VerifyOrReturnValue(queue.Calloc(capacity), false);
+    if (mDeadlineQueueSize > 0)
+    {
+        memcpy(queue.Get(), mDeadlineQueue.Get(), mDeadlineQueueSize * sizeof(ReadHandlerNode *));
+    }
+
+    mDeadlineQueue         = std::move(queue);
+    mDeadlineQueueCapacity = capacity;
+    return true;
+#else
+    return aSize <= kNodesPoolSize;
+#endif
+}
+
+void ReportScheduler::PlaceInDeadlineQueue(ReadHandlerNode * aNode, size_t aIndex)
+{
+    mDeadlineQueue[aIndex] = aNode;
+    aNode->mDeadlineIndex  = aIndex;
+}
+
+void ReportScheduler::SiftDeadlineUp(size_t aIndex)
+{
+    ReadHandlerNode * node = mDeadlineQueue[aIndex];
+    while (aIndex > 0)
+    {
+        const size_t parent = (aIndex - 1) / 2;
+        if (mDeadlineQueue[parent]->GetMaxTimestamp() <= node->GetMaxTimestamp())
+        {
+            break;
+        }
+        PlaceInDeadlineQueue(mDeadlineQueue[parent], aIndex);
+        aIndex = parent;
+    }
+    PlaceInDeadlineQueue(node, aIndex);
+}
+
+void ReportScheduler::SiftDeadlineDown(size_t aIndex)
+{
+    ReadHandlerNode * node = mDeadlineQueue[aIndex];
+    while (2 * aIndex + 1 < mDeadlineQueueSize)
+    {
+        size_t child = 2 * aIndex + 1;
+        if (child + 1 < mDeadlineQueueSize &&
+            mDeadlineQueue[child + 1]->GetMaxTimestamp() < mDeadlineQueue[child]->GetMaxTimestamp())
+        {
+            child++;
+        }
+        if (node->GetMaxTimestamp() <= mDeadlineQueue[child]->GetMaxTimestamp())
+        {
+            break;
+        }
+        PlaceInDeadlineQueue(mDeadlineQueue[child], aIndex);
+        aIndex = child;
+    }
+    PlaceInDeadlineQueue(node, aIndex);
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
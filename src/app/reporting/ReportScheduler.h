@@ -23,7 +23,9 @@
 
 #include <app/ReadHandler.h>
 #include <app/icd/server/ICDStateObserver.h>
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
+#include <lib/support/ScopedBuffer.h>
 #include <system/SystemClock.h>
 
 namespace chip {
@@ -52,6 +54,9 @@ public:
  * The ReportScheduler also holds a TimerDelegate pointer that is used to start and cancel timers for the ReadHandlers depending
  * on the reporting logic of the Scheduler.
  *
+ * The nodes are indexed by ReadHandler so that the reportability callbacks do not go through the whole pool, and kept in a
+ * priority queue ordered by their max timestamp so that the earliest max timestamp is found without visiting every node.
+ *
  * It inherits the ReadHandler::Observer class to be notified of reportability changes in the ReadHandlers.
  * It inherits the ICDStateObserver class to allow the implementation to generate reports based on the changes in ICD devices state,
  * such as going from idle to active mode and vice-versa.
@@ -169,6 +174,12 @@ public:
             aReadHandler->GetReportingIntervals(minInterval, maxInterval);
             mMinTimestamp = now + System::Clock::Seconds16(minInterval);
             mMaxTimestamp = now + System::Clock::Seconds16(maxInterval);
+
+            // The node is only queued once it is registered in the scheduler.
+            if (mDeadlineIndex != kNotQueued)
+            {
+                mScheduler->UpdateDeadline(this);
+            }
         }
 
         void TimerFired() override
@@ -181,11 +192,20 @@ public:
         System::Clock::Timestamp GetMaxTimestamp() const { return mMaxTimestamp; }
 
     private:
+        friend class ReportScheduler;
+
+        static constexpr size_t kNotQueued = SIZE_MAX;
+
         ReadHandler * mReadHandler;
         ReportScheduler * mScheduler;
         Timestamp mMinTimestamp;
         Timestamp mMaxTimestamp;
 
+        // Next node in the same bucket of the node index of the scheduler.
+        ReadHandlerNode * mpNextInBucket = nullptr;
+        // Position of the node in the deadline queue of the scheduler, kNotQueued if it is not in the queue.
+        size_t mDeadlineIndex = kNotQueued;
+
         BitFlags<ReadHandlerNodeFlags> mFlags;
     };
 
@@ -233,26 +253,67 @@ public:
 protected:
     friend class chip::app::reporting::TestReportScheduler;
 
+    static constexpr size_t kNodesPoolSize        = CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+    static constexpr size_t kNodeIndexBucketCount = CHIP_IM_SERVER_NUM_READ_HANDLER_NODE_INDEX_BUCKETS;
+    static_assert(kNodeIndexBucketCount > 0, "The ReadHandlerNode index needs at least one bucket");
+
     /// @brief Find the ReadHandlerNode for a given ReadHandler pointer
     /// @param [in] aReadHandler ReadHandler pointer to look for in the ReadHandler nodes list
     /// @return Node Address if the node was found, nullptr otherwise
     ReadHandlerNode * FindReadHandlerNode(const ReadHandler * aReadHandler)
     {
-        ReadHandlerNode * foundNode = nullptr;
-        mNodesPool.ForEachActiveObject([&foundNode, aReadHandler](ReadHandlerNode * node) {
+        for (ReadHandlerNode * node = mNodeIndex[GetNodeIndexBucket(aReadHandler)]; node != nullptr; node = node->mpNextInBucket)
+        {
             if (node->GetReadHandler() == aReadHandler)
             {
-                foundNode = node;
-                return Loop::Break;
+                return node;
             }
-
-            return Loop::Continue;
-        });
-        return foundNode;
+        }
+        return nullptr;
     }
 
-    ObjectPool<ReadHandlerNode, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mNodesPool;
+    /// @brief Create the ReadHandlerNode of a ReadHandler and add it to the node index and the deadline queue
+    /// @return The new node, nullptr if the node pool is exhausted
+    ReadHandlerNode * CreateReadHandlerNode(ReadHandler * aReadHandler, const Timestamp & now);
+
+    /// @brief Remove a ReadHandlerNode from the node index and the deadline queue, and release it
+    void ReleaseReadHandlerNode(ReadHandlerNode * aNode);
+
+    /// @brief Find the earliest max timestamp of the registered nodes that is after now
+    /// @param[in] now The current system timestamp
+    /// @param[in] aDefault The timestamp to return when no max timestamp of the nodes is after now
+    Timestamp FindEarliestMaxTimestampAfter(const Timestamp & now, const Timestamp & aDefault) const;
+
+    ObjectPool<ReadHandlerNode, kNodesPoolSize> mNodesPool;
     TimerDelegate * mTimerDelegate;
+
+private:
+    static size_t GetNodeIndexBucket(const ReadHandler * aReadHandler)
+    {
+        return (reinterpret_cast<uintptr_t>(aReadHandler) / alignof(ReadHandler)) % kNodeIndexBucketCount;
+    }
+
+    /// @brief Restore the order of the deadline queue after the max timestamp of a queued node changed
+    void UpdateDeadline(ReadHandlerNode * aNode);
+
+    bool ReserveDeadlineQueue(size_t aSize);
+    void PlaceInDeadlineQueue(ReadHandlerNode * aNode, size_t aIndex);
+    void SiftDeadlineUp(size_t aIndex);
+    void SiftDeadlineDown(size_t aIndex);
+    void FindEarliestMaxTimestampAfter(size_t aIndex, const Timestamp & now, Timestamp & aEarliest) const;
+
+    ReadHandlerNode * mNodeIndex[kNodeIndexBucketCount] = {};
+
+    // Binary min-heap of the registered nodes ordered by their max timestamp.
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    Platform::ScopedMemoryBuffer<ReadHandlerNode *> mDeadlineQueue;
+    size_t mDeadlineQueueCapacity = 0;
+#else
+    ReadHandlerNode * mDeadlineQueue[kNodesPoolSize];
+#endif
+    size_t mDeadlineQueueSize = 0;
+    // Registered nodes that could not be added to the deadline queue for lack of memory.
+    size_t mNumUnqueuedNodes = 0;
 };
 }; // namespace reporting
 }; // namespace app
@@ -35,7 +35,7 @@ void SynchronizedReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aRead
     // Nothing to remove if the handler is not found in the list
     VerifyOrReturn(nullptr != removeNode);
 
-    mNodesPool.ReleaseObject(removeNode);
+    ReleaseReadHandlerNode(removeNode);
 
     if (!mNodesPool.Allocated())
     {
@@ -87,18 +87,8 @@ bool SynchronizedReportSchedulerImpl::IsReportScheduled(ReadHandler * ReadHandle
 CHIP_ERROR SynchronizedReportSchedulerImpl::FindNextMaxInterval(const Timestamp & now)
 {
     VerifyOrReturnError(mNodesPool.Allocated(), CHIP_ERROR_INVALID_LIST_LENGTH);
-    System::Clock::Timestamp earliest = now + Seconds16::max();
 
-    mNodesPool.ForEachActiveObject([&earliest, now](ReadHandlerNode * node) {
-        if (node->GetMaxTimestamp() < earliest && node->GetMaxTimestamp() > now)
-        {
-            earliest = node->GetMaxTimestamp();
-        }
-
-        return Loop::Continue;
-    });
-
-    mNextMaxTimestamp = earliest;
+    mNextMaxTimestamp = FindEarliestMaxTimestampAfter(now, now + Seconds16::max());
 
     return CHIP_NO_ERROR;
 }
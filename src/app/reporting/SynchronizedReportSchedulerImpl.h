@@ -117,6 +117,7 @@ protected:
 
 private:
     friend class chip::app::reporting::TestReportScheduler;
+    friend class chip::app::reporting::BenchmarkReportScheduler;
 
     /**
      * @brief Find the highest minimum timestamp possible that still respects the lowest max timestamp and sets it as the common
@@ -131,7 +132,8 @@ private:
     CHIP_ERROR FindNextMinInterval(const Timestamp & now);
 
     /**
-     * @brief Find the smallest maximum interval possible and set it as the common maximum
+     * @brief Find the smallest maximum interval possible and set it as the common maximum, using the deadline queue of the
+     * ReportScheduler rather than going through every node
      *
      * @param[in] now The current system timestamp, set by the event that triggered the call of this method.
      *
@@ -771,4 +771,178 @@ TEST_F(TestClusterStateCache, TestCache)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+template <typename CacheType>
+class NullCacheCallback final : public CacheType::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+// Claim a wildcard request path, so that the cache tracks data versions.  Must be done before the cache sees any reports.
+template <typename CacheType>
+void ClaimWildcardPath(CacheType & cache)
+{
+    AttributePathParams wildcardPath;
+    const Span<AttributePathParams> pathSpan(&wildcardPath, 1);
+    uint8_t buf[20];
+    TLV::TLVWriter writer;
+    writer.Init(buf);
+    DataVersionFilterIBs::Builder builder;
+    EXPECT_EQ(builder.Init(&writer), CHIP_NO_ERROR);
+    bool encodedDataVersionList = false;
+    EXPECT_EQ(cache.GetBufferedCallback().OnUpdateDataVersionFilterList(builder, pathSpan, encodedDataVersionList), CHIP_NO_ERROR);
+    EXPECT_FALSE(encodedDataVersionList);
+}
+
+uint32_t WildcardReadValue(const ConcreteAttributePath & path, DataVersion version)
+{
+    return version * 1000003u + path.mEndpointId * 10007u + path.mClusterId * 101u + path.mAttributeId;
+}
+
+// Replays a report for a wildcard read of a node with the given number of endpoints, clusters per endpoint and attributes per
+// cluster.  Paths are delivered in ascending order, as a publisher does, unless `descending` is set.
+template <typename CacheType>
+void ReplayWildcardRead(CacheType & cache, EndpointId endpointCount, ClusterId clusterCount, AttributeId attributeCount,
+                        DataVersion version, bool descending = false)
+{
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+    callback.OnReportBegin();
+
+    for (EndpointId e = 0; e < endpointCount; e++)
+    {
+        for (ClusterId c = 0; c < clusterCount; c++)
+        {
+            for (AttributeId a = 0; a < attributeCount; a++)
+            {
+                ConcreteDataAttributePath path(e, c, a);
+                if (descending)
+                {
+                    path = ConcreteDataAttributePath(static_cast<EndpointId>(endpointCount - 1 - e), clusterCount - 1 - c,
+                                                     attributeCount - 1 - a);
+                }
+                path.mDataVersion.SetValue(version);
+
+                uint8_t buf[16];
+                TLV::TLVWriter writer;
+                writer.Init(buf);
+                EXPECT_EQ(writer.Put(TLV::AnonymousTag(), WildcardReadValue(path, version)), CHIP_NO_ERROR);
+
+                TLV::TLVReader reader;
+                reader.Init(buf, writer.GetLengthWritten());
+                EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+                callback.OnAttributeData(path, &reader, StatusIB());
+            }
+        }
+    }
+
+    callback.OnReportEnd();
+}
+
+// Checks the data versions and, if the cache stores data, the values from ReplayWildcardRead().
+template <typename CacheType>
+void VerifyWildcardRead(CacheType & cache, EndpointId endpointCount, ClusterId clusterCount, AttributeId attributeCount,
+                        DataVersion version, bool cachesData = true)
+{
+    for (EndpointId e = 0; e < endpointCount; e++)
+    {
+        for (ClusterId c = 0; c < clusterCount; c++)
+        {
+            Optional<DataVersion> clusterVersion;
+            EXPECT_EQ(cache.GetVersion(ConcreteClusterPath(e, c), clusterVersion), CHIP_NO_ERROR);
+            EXPECT_TRUE(clusterVersion.HasValue());
+            EXPECT_EQ(clusterVersion.ValueOr(0), version);
+
+            for (AttributeId a = 0; cachesData && a < attributeCount; a++)
+            {
+                ConcreteAttributePath path(e, c, a);
+                TLV::TLVReader reader;
+                uint32_t value = 0;
+                ASSERT_EQ(cache.Get(path, reader), CHIP_NO_ERROR);
+                ASSERT_EQ(reader.Get(value), CHIP_NO_ERROR);
+                EXPECT_EQ(value, WildcardReadValue(path, version));
+            }
+        }
+    }
+}
+
+TEST_F(TestClusterStateCache, TestFlatStorage)
+{
+    constexpr EndpointId kEndpoints   = 4;
+    constexpr ClusterId kClusters     = 3;
+    constexpr AttributeId kAttributes = 5;
+
+    NullCacheCallback<ClusterStateCacheFlat> callback;
+    ClusterStateCacheFlat cache(callback);
+    ClaimWildcardPath(cache);
+
+    // Out-of-order paths are inserted in the middle of each level, rather than appended.
+    ReplayWildcardRead(cache, kEndpoints, kClusters, kAttributes, 1, /* descending = */ true);
+    VerifyWildcardRead(cache, kEndpoints, kClusters, kAttributes, 1);
+
+    ReplayWildcardRead(cache, kEndpoints, kClusters, kAttributes, 2);
+    VerifyWildcardRead(cache, kEndpoints, kClusters, kAttributes, 2);
+
+    // Iteration is in ascending order regardless of arrival order.
+    std::vector<ClusterId> clusters;
+    auto collectCluster = [&clusters](ClusterId clusterId) {
+        clusters.push_back(clusterId);
+        return CHIP_NO_ERROR;
+    };
+    EXPECT_EQ(cache.ForEachCluster(1, collectCluster), CHIP_NO_ERROR);
+    EXPECT_TRUE(clusters == (std::vector<ClusterId>{ 0, 1, 2 }));
+
+    std::vector<AttributeId> attributes;
+    auto collectAttribute = [&attributes](const ConcreteAttributePath & path) {
+        attributes.push_back(path.mAttributeId);
+        return CHIP_NO_ERROR;
+    };
+    EXPECT_EQ(cache.ForEachAttribute(1, 2, collectAttribute), CHIP_NO_ERROR);
+    EXPECT_TRUE(attributes == (std::vector<AttributeId>{ 0, 1, 2, 3, 4 }));
+
+    // An unknown endpoint has no clusters.
+    clusters.clear();
+    EXPECT_EQ(cache.ForEachCluster(kEndpoints, collectCluster), CHIP_NO_ERROR);
+    EXPECT_TRUE(clusters.empty());
+
+    TLV::TLVReader reader;
+    Optional<DataVersion> version;
+    cache.ClearAttribute(ConcreteAttributePath(1, 2, 3));
+    EXPECT_EQ(cache.Get(ConcreteAttributePath(1, 2, 3), reader), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(cache.Get(ConcreteAttributePath(1, 2, 4), reader), CHIP_NO_ERROR);
+
+    cache.ClearAttributes(ConcreteClusterPath(1, 2));
+    EXPECT_EQ(cache.GetVersion(ConcreteClusterPath(1, 2), version), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(cache.GetVersion(ConcreteClusterPath(1, 1), version), CHIP_NO_ERROR);
+
+    cache.ClearAttributes(static_cast<EndpointId>(1));
+    EXPECT_EQ(cache.GetVersion(ConcreteClusterPath(1, 1), version), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(cache.GetVersion(ConcreteClusterPath(2, 1), version), CHIP_NO_ERROR);
+}
+
+template <typename CacheType>
+void CheckWildcardRead(bool cachesData)
+{
+    constexpr EndpointId kEndpoints   = 8;
+    constexpr ClusterId kClusters     = 6;
+    constexpr AttributeId kAttributes = 10;
+
+    NullCacheCallback<CacheType> callback;
+    CacheType cache(callback);
+    ClaimWildcardPath(cache);
+
+    // A priming report, then an update report for every attribute.
+    ReplayWildcardRead(cache, kEndpoints, kClusters, kAttributes, 1);
+    VerifyWildcardRead(cache, kEndpoints, kClusters, kAttributes, 1, cachesData);
+    ReplayWildcardRead(cache, kEndpoints, kClusters, kAttributes, 2);
+    VerifyWildcardRead(cache, kEndpoints, kClusters, kAttributes, 2, cachesData);
+}
+
+// Replays a wildcard read of a node with several endpoints (e.g. a bridge) into caches with each storage mode.
+TEST_F(TestClusterStateCache, TestWildcardReadAllStorageModes)
+{
+    CheckWildcardRead<ClusterStateCache>(true);
+    CheckWildcardRead<ClusterStateCacheFlat>(true);
+    CheckWildcardRead<ClusterStateCacheNoData>(false);
+    CheckWildcardRead<ClusterStateCacheNoDataFlat>(false);
+}
+
 } // namespace
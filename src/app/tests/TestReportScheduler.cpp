@@ -58,6 +58,7 @@ public:
     void TestReportTiming();
     void TestObserverCallbacks();
     void TestSynchronizedScheduler();
+    void TestSynchronizedSchedulerManySubscriptions();
 
     /// @brief Mimicks the various operations that happen on a subscription transaction after a read handler was created so that
     /// readhandlers are in the expected state for further tests.
@@ -807,6 +808,92 @@ TEST_F_FROM_FIXTURE(TestReportScheduler, TestSynchronizedScheduler)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+TEST_F_FROM_FIXTURE(TestReportScheduler, TestSynchronizedSchedulerManySubscriptions)
+{
+    NullReadHandlerCallback nullCallback;
+    // exchange context
+    Messaging::ExchangeContext * exchangeCtx = NewExchangeToAlice(nullptr, false);
+
+    constexpr size_t kNumSubscriptions = 2000;
+    ObjectPool<ReadHandler, kNumSubscriptions> readHandlerPool;
+
+    // The earliest max timestamp after now, found by going through every node
+    auto expectedNextMaxTimestamp = [](const Timestamp & now) {
+        Timestamp earliest = now + System::Clock::Seconds16::max();
+        syncScheduler.mNodesPool.ForEachActiveObject([&earliest, now](ReadHandlerNode * node) {
+            if (node->GetMaxTimestamp() < earliest && node->GetMaxTimestamp() > now)
+            {
+                earliest = node->GetMaxTimestamp();
+            }
+            return Loop::Continue;
+        });
+        return earliest;
+    };
+
+    sTestTimerSynchronizedDelegate.SetMockSystemTimestamp(System::Clock::Milliseconds64(0));
+
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        ReadHandler * readHandler = readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe,
+                                                                 &syncScheduler, CodegenDataModelInstance());
+        ASSERT_NE(nullptr, readHandler);
+        // Max intervals from 2s to 201s, each shared by several subscriptions.
+        EXPECT_EQ(CHIP_NO_ERROR,
+                  MockReadHandlerSubscriptionTransaction(readHandler, &syncScheduler, 1, static_cast<uint8_t>(2 + i % 200)));
+    }
+
+    EXPECT_EQ(syncScheduler.GetNumReadHandlers(), kNumSubscriptions);
+    readHandlerPool.ForEachActiveObject([](ReadHandler * handler) {
+        ReadHandlerNode * node = syncScheduler.FindReadHandlerNode(handler);
+        EXPECT_NE(nullptr, node);
+        EXPECT_EQ(node->GetReadHandler(), handler);
+        return Loop::Continue;
+    });
+
+    Timestamp now = sTestTimerSynchronizedDelegate.GetCurrentMonotonicTimestamp();
+    EXPECT_EQ(CHIP_NO_ERROR, syncScheduler.FindNextMaxInterval(now));
+    EXPECT_EQ(syncScheduler.mNextMaxTimestamp, System::Clock::Milliseconds64(2000));
+
+    // Unregistering the subscriptions with the earliest max interval moves the common max to the next one
+    readHandlerPool.ForEachActiveObject([](ReadHandler * handler) {
+        if (syncScheduler.GetMaxTimestampForHandler(handler) == System::Clock::Milliseconds64(2000))
+        {
+            syncScheduler.OnReadHandlerDestroyed(handler);
+            EXPECT_EQ(nullptr, syncScheduler.FindReadHandlerNode(handler));
+        }
+        return Loop::Continue;
+    });
+    EXPECT_EQ(syncScheduler.GetNumReadHandlers(), kNumSubscriptions - kNumSubscriptions / 200);
+    EXPECT_EQ(CHIP_NO_ERROR, syncScheduler.FindNextMaxInterval(now));
+    EXPECT_EQ(syncScheduler.mNextMaxTimestamp, System::Clock::Milliseconds64(3000));
+
+    // Max timestamps that have passed are skipped
+    now = System::Clock::Milliseconds64(3000);
+    sTestTimerSynchronizedDelegate.SetMockSystemTimestamp(now);
+    EXPECT_EQ(CHIP_NO_ERROR, syncScheduler.FindNextMaxInterval(now));
+    EXPECT_EQ(syncScheduler.mNextMaxTimestamp, System::Clock::Milliseconds64(4000));
+
+    // Reports reschedule the max timestamps of their handlers
+    size_t index = 0;
+    readHandlerPool.ForEachActiveObject([&index](ReadHandler * handler) {
+        if (index++ % 7 == 1 && syncScheduler.FindReadHandlerNode(handler) != nullptr)
+        {
+            syncScheduler.OnSubscriptionReportSent(handler);
+        }
+        return Loop::Continue;
+    });
+    EXPECT_EQ(CHIP_NO_ERROR, syncScheduler.FindNextMaxInterval(now));
+    EXPECT_EQ(syncScheduler.mNextMaxTimestamp, expectedNextMaxTimestamp(now));
+
+    syncScheduler.UnregisterAllHandlers();
+    EXPECT_EQ(syncScheduler.GetNumReadHandlers(), 0u);
+    readHandlerPool.ReleaseAll();
+    exchangeCtx->Close();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -33,6 +33,8 @@
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
 #include <app/tests/test-interaction-model-api.h>
+#include <app/util/MatterCallbacks.h>
+#include <app/util/mock/Constants.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
 #include <lib/core/StringBuilderAdapters.h>
@@ -49,6 +51,7 @@ constexpr ClusterId kTestClusterId        = 6;
 constexpr EndpointId kTestEndpointId      = 1;
 constexpr chip::AttributeId kTestFieldId1 = 1;
 constexpr chip::AttributeId kTestFieldId2 = 2;
+constexpr ClusterId kInterestIndexBuckets = CHIP_IM_SERVER_NUM_INTEREST_INDEX_BUCKETS;
 
 namespace app {
 namespace reporting {
@@ -75,6 +78,9 @@ public:
     void TestBuildAndSendSingleReportData();
     void TestMergeOverlappedAttributePath();
     void TestMergeAttributePathWhenDirtySetPoolExhausted();
+    void TestSetDirtyUsesInterestIndex();
+    void TestDirtySetUnderChurn();
+    void TestAttributeReportCacheReadHooks();
 
 private:
     chip::app::InteractionModel::DataModel * mOldModel = nullptr;
@@ -108,6 +114,53 @@ public:
     }
 };
 
+class ReadOperationCounter : public DataModelCallbacks
+{
+public:
+    void AttributeOperation(OperationType operation, OperationOrder order, const ConcreteAttributePath & path) override
+    {
+        if (operation != OperationType::Read)
+        {
+            return;
+        }
+        if (order == OperationOrder::Pre)
+        {
+            mPreReads++;
+        }
+        else
+        {
+            mPostReads++;
+        }
+    }
+
+    void Reset()
+    {
+        mPreReads  = 0;
+        mPostReads = 0;
+    }
+
+    uint32_t mPreReads  = 0;
+    uint32_t mPostReads = 0;
+};
+
+System::PacketBufferHandle BuildReadRequest(const ConcreteAttributePath & aPath)
+{
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequestMessage::Builder readRequestBuilder;
+
+    writer.Init(std::move(readRequestbuf));
+    EXPECT_EQ(readRequestBuilder.Init(&writer), CHIP_NO_ERROR);
+    AttributePathIBs::Builder & attributePathListBuilder = readRequestBuilder.CreateAttributeRequests();
+    AttributePathIB::Builder & attributePathBuilder      = attributePathListBuilder.CreatePath();
+    attributePathBuilder.Endpoint(aPath.mEndpointId).Cluster(aPath.mClusterId).Attribute(aPath.mAttributeId).EndOfAttributePathIB();
+    attributePathListBuilder.EndOfAttributePathIBs();
+    readRequestBuilder.IsFabricFiltered(false).EndOfReadRequestMessage();
+    EXPECT_EQ(readRequestBuilder.GetError(), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Finalize(&readRequestbuf), CHIP_NO_ERROR);
+    return readRequestbuf;
+}
+
 template <typename... Args>
 bool TestReportingEngine::VerifyDirtySetContent(const Args &... args)
 {
@@ -146,11 +199,7 @@ bool TestReportingEngine::VerifyDirtySetContent(const Args &... args)
 
 bool TestReportingEngine::InsertToDirtySet(const AttributePathParams & aPath)
 {
-    auto path = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    VerifyOrReturnError(path != nullptr, false);
-    *path             = aPath;
-    path->mGeneration = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
-    return true;
+    return InteractionModelEngine::GetInstance()->GetReportingEngine().CreateDirtyPath(aPath) != nullptr;
 }
 
 TEST_F_FROM_FIXTURE(TestReportingEngine, TestBuildAndSendSingleReportData)
@@ -201,10 +250,9 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeOverlappedAttributePath)
                                                           app::reporting::GetDefaultReportScheduler()),
               CHIP_NO_ERROR);
 
-    AttributePathParams * clusterInfo = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    clusterInfo->mEndpointId          = 1;
-    clusterInfo->mClusterId           = 1;
-    clusterInfo->mAttributeId         = 1;
+    AttributePathParams * clusterInfo =
+        InteractionModelEngine::GetInstance()->GetReportingEngine().CreateDirtyPath(AttributePathParams(1, 1, 1));
+    ASSERT_NE(clusterInfo, nullptr);
 
     {
         AttributePathParams testClusterInfo;
@@ -256,7 +304,7 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
                                                           app::reporting::GetDefaultReportScheduler()),
               CHIP_NO_ERROR);
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().ReleaseAllDirtyPaths();
     InteractionModelEngine::GetInstance()->GetReportingEngine().BumpDirtySetGeneration();
 
     // Case 1: All dirty paths including the new one are under the same cluster.
@@ -270,7 +318,7 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
                   AttributePathParams(kTestEndpointId, kTestClusterId, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1)));
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().ReleaseAllDirtyPaths();
 
     // Case 2: All dirty paths including the new one are under the same endpoint.
     // -> Expected behavior: The dirty set is replaced by a wildcard cluster path under the same endpoint.
@@ -283,7 +331,7 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
                   AttributePathParams(kTestEndpointId, ClusterId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1)));
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kInvalidClusterId)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().ReleaseAllDirtyPaths();
 
     // Case 3: All dirty paths including the new one are under the different endpoints.
     // -> Expected behavior: The dirty set is replaced by a wildcard endpoint.
@@ -296,7 +344,7 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
                   AttributePathParams(EndpointId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1, 1)));
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams()));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().ReleaseAllDirtyPaths();
 
     // Case 4: All existing dirty paths are under the same cluster, the new path comes from another cluster.
     // -> Expected behavior: The existing paths are merged into one single wildcard attribute path. New path is inserted
@@ -311,7 +359,7 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId),
                                       AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().ReleaseAllDirtyPaths();
 
     // Case 5: All existing dirty paths are under the same endpoint, the new path comes from another endpoint.
     // -> Expected behavior: The existing paths are merged into one single wildcard cluster path. New path is inserted as-is.
@@ -328,6 +376,323 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestSetDirtyUsesInterestIndex)
+{
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequestMessage::Builder readRequestBuilder;
+    DummyDelegate dummy;
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    TestExchangeDelegate delegate;
+    Messaging::ExchangeContext * exchangeCtx = NewExchangeToAlice(&delegate);
+
+    writer.Init(std::move(readRequestbuf));
+    EXPECT_EQ(readRequestBuilder.Init(&writer), CHIP_NO_ERROR);
+    AttributePathIBs::Builder & attributePathListBuilder = readRequestBuilder.CreateAttributeRequests();
+    EXPECT_EQ(readRequestBuilder.GetError(), CHIP_NO_ERROR);
+    AttributePathIB::Builder & attributePathBuilder1 = attributePathListBuilder.CreatePath();
+    EXPECT_EQ(attributePathListBuilder.GetError(), CHIP_NO_ERROR);
+    attributePathBuilder1.Node(1).Endpoint(kTestEndpointId).Cluster(kTestClusterId).Attribute(kTestFieldId1).EndOfAttributePathIB();
+    EXPECT_EQ(attributePathBuilder1.GetError(), CHIP_NO_ERROR);
+
+    AttributePathIB::Builder & attributePathBuilder2 = attributePathListBuilder.CreatePath();
+    EXPECT_EQ(attributePathListBuilder.GetError(), CHIP_NO_ERROR);
+    attributePathBuilder2.Node(1).Endpoint(kTestEndpointId).Cluster(kTestClusterId).Attribute(kTestFieldId2).EndOfAttributePathIB();
+    EXPECT_EQ(attributePathBuilder2.GetError(), CHIP_NO_ERROR);
+    attributePathListBuilder.EndOfAttributePathIBs();
+
+    EXPECT_EQ(readRequestBuilder.GetError(), CHIP_NO_ERROR);
+    readRequestBuilder.IsFabricFiltered(false).EndOfReadRequestMessage();
+    EXPECT_EQ(readRequestBuilder.GetError(), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Finalize(&readRequestbuf), CHIP_NO_ERROR);
+
+    engine.ReleaseAllDirtyPaths();
+
+    {
+        app::ReadHandler readHandler(dummy, exchangeCtx, chip::app::ReadHandler::InteractionType::Read,
+                                     app::reporting::GetDefaultReportScheduler(), CodegenDataModelInstance());
+        readHandler.OnInitialRequest(std::move(readRequestbuf));
+        EXPECT_TRUE(readHandler.CanStartReporting());
+        EXPECT_TRUE(readHandler.mFlags.Has(ReadHandler::ReadHandlerFlags::InterestIndexed));
+        EXPECT_EQ(engine.mInterestPool.Allocated(), 2u);
+
+        // A path in another cluster of the same bucket does not reach the handler and is not kept in the dirty set.
+        AttributePathParams otherCluster(kTestEndpointId, kTestClusterId + kInterestIndexBuckets, kTestFieldId1);
+        EXPECT_EQ(engine.SetDirty(otherCluster), CHIP_NO_ERROR);
+        EXPECT_NE(readHandler.mDirtyGeneration, engine.GetDirtySetGeneration());
+        EXPECT_EQ(engine.GetGlobalDirtySetSize(), 0u);
+
+        AttributePathParams interested(kTestEndpointId, kTestClusterId, kTestFieldId2);
+        EXPECT_EQ(engine.SetDirty(interested), CHIP_NO_ERROR);
+        EXPECT_EQ(readHandler.mDirtyGeneration, engine.GetDirtySetGeneration());
+        EXPECT_TRUE(VerifyDirtySetContent(interested));
+
+        // A wildcard cluster path reaches the handlers in every bucket.
+        AttributePathParams wildcardCluster(kTestEndpointId, kInvalidClusterId);
+        EXPECT_EQ(engine.SetDirty(wildcardCluster), CHIP_NO_ERROR);
+        EXPECT_EQ(readHandler.mDirtyGeneration, engine.GetDirtySetGeneration());
+    }
+
+    EXPECT_EQ(engine.mInterestPool.Allocated(), 0u);
+    for (auto * head : engine.mInterestIndex)
+    {
+        EXPECT_EQ(head, nullptr);
+    }
+
+    DrainAndServiceIO();
+    engine.Shutdown();
+}
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestDirtySetUnderChurn)
+{
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.ReleaseAllDirtyPaths();
+
+    // The same attributes of two clusters keep changing; there are as many of them as the dirty set can hold without merging.
+    constexpr uint32_t kRounds             = 100;
+    constexpr AttributeId kDirtyAttributes = CHIP_IM_SERVER_MAX_NUM_DIRTY_SET;
+    const uint64_t startGeneration         = engine.GetDirtySetGeneration();
+
+    for (uint32_t round = 0; round < kRounds; round++)
+    {
+        for (AttributeId attribute = 0; attribute < kDirtyAttributes; attribute++)
+        {
+            engine.BumpDirtySetGeneration();
+            EXPECT_EQ(engine.InsertPathIntoDirtySet(
+                          AttributePathParams(kTestEndpointId, ClusterId(kTestClusterId + attribute % 2), attribute)),
+                      CHIP_NO_ERROR);
+        }
+    }
+
+    // Every change is deduplicated into the path of its attribute, so the set is never merged into wider paths.
+    EXPECT_EQ(engine.GetGlobalDirtySetSize(), kDirtyAttributes);
+
+    // Count the attributes of both clusters a report would include.
+    uint32_t reported = 0;
+    for (ClusterId cluster = kTestClusterId; cluster <= kTestClusterId + 1; cluster++)
+    {
+        for (AttributeId attribute = 0; attribute < 2 * kDirtyAttributes; attribute++)
+        {
+            if (engine.IsAttributePathDirtySince(ConcreteAttributePath(kTestEndpointId, cluster, attribute), startGeneration))
+            {
+                reported++;
+            }
+        }
+    }
+    EXPECT_EQ(reported, kDirtyAttributes);
+
+    // Only the changes after the last report are reported.
+    const uint64_t lastReportGeneration = engine.GetDirtySetGeneration();
+    engine.BumpDirtySetGeneration();
+    EXPECT_EQ(engine.InsertPathIntoDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, 0)), CHIP_NO_ERROR);
+    EXPECT_TRUE(engine.IsAttributePathDirtySince(ConcreteAttributePath(kTestEndpointId, kTestClusterId, 0), lastReportGeneration));
+    EXPECT_FALSE(engine.IsAttributePathDirtySince(ConcreteAttributePath(kTestEndpointId, kTestClusterId, 2), lastReportGeneration));
+
+    // Wildcard paths are found for every attribute they include.
+    engine.ReleaseAllDirtyPaths();
+    EXPECT_EQ(engine.InsertPathIntoDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId)), CHIP_NO_ERROR);
+    EXPECT_TRUE(engine.IsAttributePathDirtySince(ConcreteAttributePath(kTestEndpointId, kTestClusterId, 5), startGeneration));
+    EXPECT_FALSE(engine.IsAttributePathDirtySince(ConcreteAttributePath(kTestEndpointId, kTestClusterId + 1, 5), startGeneration));
+
+    // A concrete path already covered by the wildcard path is not added.
+    EXPECT_EQ(engine.InsertPathIntoDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, 5)), CHIP_NO_ERROR);
+    EXPECT_EQ(engine.GetGlobalDirtySetSize(), 1u);
+
+    engine.Shutdown();
+}
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestAttributeReportCache)
+{
+    if (AttributeReportCache::kEntryCount == 0)
+    {
+        return;
+    }
+
+    AttributeReportCache cache;
+    AttributeReportCache::Key key;
+    key.mPath        = ConcreteAttributePath(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    key.mDataVersion = 1;
+    key.mFabricIndex = 1;
+
+    uint32_t encodeCount = 0;
+
+    auto encode = [&](AttributeReportIBs::Builder & builder) {
+        encodeCount++;
+        return builder.EncodeAttributeStatus(ConcreteReadAttributePath(key.mPath),
+                                             StatusIB(Protocols::InteractionModel::Status::UnsupportedAccess));
+    };
+    auto encodeNothing = [](AttributeReportIBs::Builder &) { return CHIP_NO_ERROR; };
+    auto encodeThenFail = [&](AttributeReportIBs::Builder & builder) {
+        ReturnErrorOnFailure(encode(builder));
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    };
+    auto encodeOversized = [&](AttributeReportIBs::Builder & builder) {
+        while (builder.GetWriter()->GetLengthWritten() <= AttributeReportCache::kEntrySize)
+        {
+            ReturnErrorOnFailure(encode(builder));
+        }
+        return CHIP_NO_ERROR;
+    };
+    const uint32_t maxLength = AttributeReportCache::kEntrySize * 2;
+
+    ByteSpan encodedReports;
+    EXPECT_EQ(cache.Find(key, encodedReports), CHIP_ERROR_INCORRECT_STATE);
+
+    {
+        // A disabled cache never runs.
+        AttributeReportCache::Scope scope(cache);
+        EXPECT_FALSE(cache.IsRunning());
+    }
+
+    cache.SetEnabled(true);
+    {
+        AttributeReportCache::Scope scope(cache);
+        EXPECT_TRUE(cache.IsRunning());
+
+        ASSERT_TRUE(cache.CanEncode(maxLength));
+
+        EXPECT_EQ(cache.Find(key, encodedReports), CHIP_ERROR_NOT_FOUND);
+        EXPECT_EQ(cache.Encode(key, maxLength, encode, encodedReports), CHIP_NO_ERROR);
+        EXPECT_EQ(encodeCount, 1u);
+        EXPECT_TRUE(AttributeReportCache::Fits(encodedReports, static_cast<uint32_t>(encodedReports.size())));
+        EXPECT_FALSE(AttributeReportCache::Fits(encodedReports, 1));
+
+        ByteSpan foundReports;
+        EXPECT_EQ(cache.Find(key, foundReports), CHIP_NO_ERROR);
+        EXPECT_TRUE(foundReports.data_equal(encodedReports));
+
+        // Copying the reports into another AttributeReportIBs gives the same encoding.
+        uint8_t buffer[AttributeReportCache::kEntrySize];
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        writer.Init(buffer);
+        EXPECT_EQ(builder.Init(&writer), CHIP_NO_ERROR);
+        EXPECT_EQ(AttributeReportCache::CopyReports(foundReports, builder), CHIP_NO_ERROR);
+        EXPECT_EQ(builder.EndOfAttributeReportIBs(), CHIP_NO_ERROR);
+        EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+        EXPECT_TRUE(ByteSpan(buffer, writer.GetLengthWritten()).data_equal(encodedReports));
+
+        // Any other data version or fabric is a different value.
+        AttributeReportCache::Key otherKey = key;
+        otherKey.mDataVersion++;
+        EXPECT_EQ(cache.Find(otherKey, foundReports), CHIP_ERROR_NOT_FOUND);
+        otherKey              = key;
+        otherKey.mFabricIndex = 2;
+        EXPECT_EQ(cache.Find(otherKey, foundReports), CHIP_ERROR_NOT_FOUND);
+
+        // Reports that encode nothing are left out, so that another subject can still encode them.
+        EXPECT_EQ(cache.Encode(otherKey, maxLength, encodeNothing, foundReports), CHIP_NO_ERROR);
+        EXPECT_EQ(cache.Find(otherKey, foundReports), CHIP_ERROR_NOT_FOUND);
+
+        // A failed encode is returned along with what it wrote, so that it does not need to be read again, and is not cached.
+        encodeCount = 0;
+        EXPECT_EQ(cache.Encode(otherKey, maxLength, encodeThenFail, foundReports), CHIP_ERROR_BUFFER_TOO_SMALL);
+        EXPECT_EQ(encodeCount, 1u);
+        ByteSpan cachedReports;
+        EXPECT_EQ(cache.Find(key, cachedReports), CHIP_NO_ERROR);
+        EXPECT_TRUE(foundReports.data_equal(cachedReports));
+        EXPECT_EQ(cache.Find(otherKey, foundReports), CHIP_ERROR_INCORRECT_STATE);
+
+        // So are reports that do not fit in an entry.
+        otherKey.mFabricIndex = 3;
+        EXPECT_EQ(cache.Encode(otherKey, maxLength, encodeOversized, foundReports), CHIP_NO_ERROR);
+        EXPECT_GT(foundReports.size(), AttributeReportCache::kEntrySize);
+        EXPECT_EQ(cache.Find(otherKey, foundReports), CHIP_ERROR_INCORRECT_STATE);
+    }
+
+    // Nothing is shared across runs.
+    EXPECT_FALSE(cache.IsRunning());
+    {
+        AttributeReportCache::Scope scope(cache);
+        EXPECT_EQ(cache.Find(key, encodedReports), CHIP_ERROR_NOT_FOUND);
+    }
+
+    cache.Release();
+}
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestAttributeReportCacheReadHooks)
+{
+    if (AttributeReportCache::kEntryCount == 0)
+    {
+        return;
+    }
+
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    ReadOperationCounter counter;
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    std::optional<InteractionModel::ClusterInfo> clusterInfo =
+        InteractionModelEngine::GetInstance()->GetDataModel()->GetClusterInfo(
+            ConcreteClusterPath(Test::kMockEndpoint3, Test::MockClusterId(2)));
+    ASSERT_TRUE(clusterInfo.has_value());
+
+    DataModelCallbacks * previousCallbacks = DataModelCallbacks::SetInstance(&counter);
+
+    // Two read handlers report the same attribute in one run. The application sees one read per handler whether the value
+    // is shared through the cache, or read by each of them because it is a list that does not fit in a report.
+    for (AttributeId attributeId : { Test::MockAttributeId(1), Test::MockAttributeId(4) })
+    {
+        const ConcreteAttributePath path(Test::kMockEndpoint3, Test::MockClusterId(2), attributeId);
+        uint32_t postReadsWithoutCache = 0;
+
+        for (bool cacheEnabled : { false, true })
+        {
+            engine.SetAttributeReportCacheEnabled(cacheEnabled);
+            counter.Reset();
+
+            ReadHandler firstHandler(dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+                                     app::reporting::GetDefaultReportScheduler(), CodegenDataModelInstance());
+            ReadHandler secondHandler(dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+                                      app::reporting::GetDefaultReportScheduler(), CodegenDataModelInstance());
+            firstHandler.OnInitialRequest(BuildReadRequest(path));
+            secondHandler.OnInitialRequest(BuildReadRequest(path));
+
+            AttributeReportCache::Key key;
+            key.mPath        = path;
+            key.mDataVersion = clusterInfo->dataVersion;
+            key.mFabricIndex = firstHandler.GetSubjectDescriptor().fabricIndex;
+
+            {
+                AttributeReportCache::Scope scope(engine.mAttributeReportCache);
+                EXPECT_EQ(engine.BuildAndSendSingleReportData(&firstHandler), CHIP_NO_ERROR);
+
+                // Only the value that fits in an entry is shared with the second handler.
+                ByteSpan encodedReports;
+                const bool shared = (engine.mAttributeReportCache.Find(key, encodedReports) == CHIP_NO_ERROR);
+                EXPECT_EQ(shared, cacheEnabled && attributeId == Test::MockAttributeId(1));
+
+                EXPECT_EQ(engine.BuildAndSendSingleReportData(&secondHandler), CHIP_NO_ERROR);
+            }
+
+            EXPECT_EQ(counter.mPreReads, 2u);
+            if (cacheEnabled)
+            {
+                EXPECT_EQ(counter.mPostReads, postReadsWithoutCache);
+            }
+            else
+            {
+                postReadsWithoutCache = counter.mPostReads;
+            }
+            DrainAndServiceIO();
+        }
+    }
+
+    DataModelCallbacks::SetInstance(previousCallbacks);
+    engine.SetAttributeReportCacheEnabled(false);
+    DrainAndServiceIO();
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -0,0 +1,320 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/WriteCoalescingPersistentStorageDelegate.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <pw_unit_test/framework.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+// Storage that counts the writes and deletions that reach it, and records the keys they were for in order.
+class CountingStorage : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        mSetCount++;
+        mKeyOrder.append(key).append(" ");
+        return TestPersistentStorageDelegate::SyncSetKeyValue(key, value, size);
+    }
+
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override
+    {
+        mDeleteCount++;
+        mKeyOrder.append(key).append(" ");
+        return TestPersistentStorageDelegate::SyncDeleteKeyValue(key);
+    }
+
+    unsigned mSetCount    = 0;
+    unsigned mDeleteCount = 0;
+    std::string mKeyOrder;
+};
+
+// System layer with a single timer that only fires when the test says so.
+class ManualTimerLayer : public System::Layer
+{
+public:
+    CHIP_ERROR Init() override { return CHIP_NO_ERROR; }
+    void Shutdown() override {}
+    bool IsInitialized() const override { return true; }
+
+    CHIP_ERROR StartTimer(System::Clock::Timeout delay, System::TimerCompleteCallback onComplete, void * appState) override
+    {
+        mDelay      = delay;
+        mOnComplete = onComplete;
+        mAppState   = appState;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR ExtendTimerTo(System::Clock::Timeout delay, System::TimerCompleteCallback onComplete, void * appState) override
+    {
+        return StartTimer(delay, onComplete, appState);
+    }
+    bool IsTimerActive(System::TimerCompleteCallback onComplete, void * appState) override
+    {
+        return mOnComplete == onComplete && mAppState == appState;
+    }
+    System::Clock::Timeout GetRemainingTime(System::TimerCompleteCallback onComplete, void * appState) override
+    {
+        return IsTimerActive(onComplete, appState) ? mDelay : System::Clock::kZero;
+    }
+    void CancelTimer(System::TimerCompleteCallback onComplete, void * appState) override
+    {
+        if (IsTimerActive(onComplete, appState))
+        {
+            mOnComplete = nullptr;
+            mAppState   = nullptr;
+        }
+    }
+    CHIP_ERROR ScheduleWork(System::TimerCompleteCallback onComplete, void * appState) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    bool IsArmed() const { return mOnComplete != nullptr; }
+
+    void Fire()
+    {
+        System::TimerCompleteCallback onComplete = mOnComplete;
+        void * appState                          = mAppState;
+        mOnComplete                              = nullptr;
+        mAppState                                = nullptr;
+        onComplete(this, appState);
+    }
+
+    System::Clock::Timeout mDelay             = System::Clock::kZero;
+    System::TimerCompleteCallback mOnComplete = nullptr;
+    void * mAppState                          = nullptr;
+};
+
+constexpr System::Clock::Timeout kWindow = System::Clock::Milliseconds32(500);
+
+class TestWriteCoalescingPersistentStorageDelegate : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override { ASSERT_EQ(mDelegate.Init(&mBacking, &mLayer, kWindow), CHIP_NO_ERROR); }
+    void TearDown() override { mDelegate.Shutdown(); }
+
+protected:
+    CountingStorage mBacking;
+    ManualTimerLayer mLayer;
+    WriteCoalescingPersistentStorageDelegate mDelegate;
+};
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, CoalescesWritesWithinWindow)
+{
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(mDelegate.SyncSetKeyValue("counter", &i, sizeof(i)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(mBacking.mSetCount, 0u);
+    EXPECT_EQ(mDelegate.GetCoalescedCount(), 9u);
+    EXPECT_TRUE(mLayer.IsArmed());
+    EXPECT_EQ(mLayer.mDelay, kWindow);
+
+    mLayer.Fire();
+    EXPECT_EQ(mBacking.mSetCount, 1u);
+    EXPECT_EQ(mDelegate.GetFlushedCount(), 1u);
+    EXPECT_EQ(mDelegate.GetPendingCount(), 0u);
+    EXPECT_FALSE(mLayer.IsArmed());
+
+    uint32_t stored = 0;
+    uint16_t size   = sizeof(stored);
+    EXPECT_EQ(mBacking.SyncGetKeyValue("counter", &stored, size), CHIP_NO_ERROR);
+    EXPECT_EQ(stored, 9u);
+}
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, ReadsSeePendingWrites)
+{
+    const uint8_t value[] = { 1, 2, 3, 4 };
+    uint8_t readValue[sizeof(value)];
+    uint16_t size = sizeof(readValue);
+
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("key", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_FALSE(mBacking.HasKey("key"));
+    EXPECT_TRUE(mDelegate.SyncDoesKeyExist("key"));
+    EXPECT_EQ(mDelegate.SyncGetKeyValue("key", readValue, size), CHIP_NO_ERROR);
+    EXPECT_EQ(size, sizeof(value));
+    EXPECT_EQ(memcmp(readValue, value, sizeof(value)), 0);
+
+    // A short buffer gets the start of the value.
+    size = 2;
+    EXPECT_EQ(mDelegate.SyncGetKeyValue("key", readValue, size), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(size, 2u);
+
+    // An empty value.
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("empty", nullptr, 0), CHIP_NO_ERROR);
+    size = 0;
+    EXPECT_EQ(mDelegate.SyncGetKeyValue("empty", nullptr, size), CHIP_NO_ERROR);
+    EXPECT_EQ(size, 0u);
+
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("key", nullptr, 1), CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, DeletesArePendingToo)
+{
+    const uint8_t value[] = { 1, 2, 3 };
+    uint8_t readValue[sizeof(value)];
+    uint16_t size = sizeof(readValue);
+
+    EXPECT_EQ(mBacking.SyncSetKeyValue("stored", value, sizeof(value)), CHIP_NO_ERROR);
+    mBacking.mSetCount = 0;
+
+    EXPECT_EQ(mDelegate.SyncDeleteKeyValue("missing"), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    EXPECT_EQ(mDelegate.SyncDeleteKeyValue("stored"), CHIP_NO_ERROR);
+    EXPECT_FALSE(mDelegate.SyncDoesKeyExist("stored"));
+    EXPECT_EQ(mDelegate.SyncGetKeyValue("stored", readValue, size), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    EXPECT_EQ(mDelegate.SyncDeleteKeyValue("stored"), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    EXPECT_TRUE(mBacking.HasKey("stored"));
+
+    // A key written and deleted within the window never reaches storage.
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("transient", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.SyncDeleteKeyValue("transient"), CHIP_NO_ERROR);
+
+    EXPECT_EQ(mDelegate.Flush(), CHIP_NO_ERROR);
+    EXPECT_FALSE(mBacking.HasKey("stored"));
+    EXPECT_FALSE(mBacking.HasKey("transient"));
+    EXPECT_EQ(mBacking.mSetCount, 0u);
+    EXPECT_EQ(mBacking.mDeleteCount, 2u);
+    EXPECT_EQ(mDelegate.GetCoalescedCount(), 1u);
+}
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, FlushesWhenFull)
+{
+    char key[PersistentStorageDelegate::kKeyLengthMax + 1];
+    for (uint8_t i = 0; i < WriteCoalescingPersistentStorageDelegate::kMaxPendingWrites; i++)
+    {
+        snprintf(key, sizeof(key), "k/%u", static_cast<unsigned>(i));
+        EXPECT_EQ(mDelegate.SyncSetKeyValue(key, &i, sizeof(i)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(mBacking.mSetCount, 0u);
+
+    const uint8_t last = 0xFF;
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("k/last", &last, sizeof(last)), CHIP_NO_ERROR);
+    EXPECT_EQ(mBacking.mSetCount, WriteCoalescingPersistentStorageDelegate::kMaxPendingWrites);
+    EXPECT_EQ(mDelegate.GetPendingCount(), 1u);
+    EXPECT_TRUE(mLayer.IsArmed());
+}
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, FailedWritesStayPending)
+{
+    const uint8_t value = 42;
+
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("key", &value, sizeof(value)), CHIP_NO_ERROR);
+
+    mBacking.SetRejectWrites(true);
+    EXPECT_NE(mDelegate.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.GetPendingCount(), 1u);
+    EXPECT_TRUE(mLayer.IsArmed());
+
+    mBacking.SetRejectWrites(false);
+    mLayer.Fire();
+    EXPECT_EQ(mDelegate.GetPendingCount(), 0u);
+    EXPECT_TRUE(mBacking.HasKey("key"));
+}
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, FlushesInWriteOrder)
+{
+    const uint8_t value = 1;
+
+    EXPECT_EQ(mBacking.SyncSetKeyValue("d", &value, sizeof(value)), CHIP_NO_ERROR);
+    mBacking.mKeyOrder.clear();
+
+    // Whatever slots they get, the keys are stored in the order of their last write or deletion.
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("b", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.SyncDeleteKeyValue("d"), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("c", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+
+    EXPECT_EQ(mDelegate.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(mBacking.mKeyOrder, "b d c a ");
+
+    // A write that cannot be held back goes after the pending ones.
+    char longKey[PersistentStorageDelegate::kKeyLengthMax + 2];
+    memset(longKey, 'x', sizeof(longKey) - 1);
+    longKey[sizeof(longKey) - 1] = '\0';
+
+    mBacking.mKeyOrder.clear();
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.SyncSetKeyValue(longKey, &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mBacking.mKeyOrder, std::string("a ") + longKey + " ");
+    EXPECT_EQ(mDelegate.GetPendingCount(), 0u);
+}
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, FlushStopsAtFailedWrite)
+{
+    const uint8_t value = 1;
+
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("a", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("b", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("c", &value, sizeof(value)), CHIP_NO_ERROR);
+
+    // The writes made after the one that fails do not reach storage ahead of it.
+    mBacking.AddPoisonKey("b");
+    EXPECT_NE(mDelegate.Flush(), CHIP_NO_ERROR);
+    EXPECT_TRUE(mBacking.HasKey("a"));
+    EXPECT_FALSE(mBacking.HasKey("c"));
+    EXPECT_EQ(mDelegate.GetPendingCount(), 2u);
+
+    mBacking.ClearPoisonKeys();
+    mBacking.mKeyOrder.clear();
+    mLayer.Fire();
+    EXPECT_EQ(mBacking.mKeyOrder, "b c ");
+    EXPECT_EQ(mDelegate.GetPendingCount(), 0u);
+}
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, ShutdownFlushes)
+{
+    const uint8_t value = 7;
+
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("key", &value, sizeof(value)), CHIP_NO_ERROR);
+    mDelegate.Shutdown();
+    EXPECT_TRUE(mBacking.HasKey("key"));
+    EXPECT_FALSE(mLayer.IsArmed());
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("key", &value, sizeof(value)), CHIP_ERROR_INCORRECT_STATE);
+}
+
+TEST_F(TestWriteCoalescingPersistentStorageDelegate, ZeroWindowWritesThrough)
+{
+    const uint8_t value = 7;
+
+    mDelegate.Shutdown();
+    ASSERT_EQ(mDelegate.Init(&mBacking, &mLayer, System::Clock::kZero), CHIP_NO_ERROR);
+
+    EXPECT_EQ(mDelegate.SyncSetKeyValue("key", &value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_TRUE(mBacking.HasKey("key"));
+    EXPECT_EQ(mDelegate.SyncDeleteKeyValue("key"), CHIP_NO_ERROR);
+    EXPECT_FALSE(mBacking.HasKey("key"));
+    EXPECT_EQ(mDelegate.GetFlushedCount(), 2u);
+    EXPECT_FALSE(mLayer.IsArmed());
+}
+
+} // namespace
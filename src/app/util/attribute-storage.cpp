@@ -66,10 +66,6 @@ uint8_t attributeData[ACTUAL_ATTRIBUTE_SIZE];
 // Loads the attributes from built-in default and storage.
 static void emAfLoadAttributeDefaults(chip::EndpointId endpoint, chip::Optional<chip::ClusterId> = chip::NullOptional);
 
-static bool emAfMatchCluster(const EmberAfCluster * cluster, const EmberAfAttributeSearchRecord * attRecord);
-static bool emAfMatchAttribute(const EmberAfCluster * cluster, const EmberAfAttributeMetadata * am,
-                               const EmberAfAttributeSearchRecord * attRecord);
-
 // If server == true, returns the number of server clusters,
 // otherwise number of client clusters on the endpoint at the given index.
 static uint8_t emberAfClusterCountForEndpointType(const EmberAfEndpointType * endpointType, bool server);
@@ -146,23 +142,282 @@ bool emberAfIsThisDataTypeAListType(EmberAfAttributeType dataType)
     return dataType == ZCL_ARRAY_ATTRIBUTE_TYPE;
 }
 
-uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
+// ----- Lookup index -----
+//
+// Endpoint IDs are resolved to indices into emAfEndpoints through an open-addressing hash table (linear
+// probing, backward-shift deletion) that is built lazily and then updated in place as dynamic endpoints
+// are set and cleared.
+//
+// Cluster and attribute metadata are resolved through direct-mapped caches keyed by the endpoint type and
+// cluster metadata pointers.  Those are shared by every endpoint of the same type, so a bridge with many
+// identical dynamic endpoints only needs a handful of entries.  The caches are flushed whenever the set of
+// endpoint types in use may have changed, since a dynamic endpoint type may be released and its memory
+// reused once its endpoint is cleared.
+
+constexpr size_t EndpointIndexCapacity(size_t endpointCount)
+{
+    // Keep the table at most two-thirds full.
+    size_t capacity = 1;
+    while (capacity < endpointCount + endpointCount / 2 + 1)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+constexpr size_t kEndpointIndexCapacity = EndpointIndexCapacity(MAX_ENDPOINT_COUNT);
+constexpr size_t kEndpointIndexMask     = kEndpointIndexCapacity - 1;
+
+struct EndpointIndexSlot
+{
+    EndpointId endpoint = kInvalidEndpointId;
+    uint16_t index      = kEmberInvalidEndpointIndex; // kEmberInvalidEndpointIndex for an empty slot
+};
+
+EndpointIndexSlot endpointIndex[kEndpointIndexCapacity];
+bool endpointIndexValid = false;
+
+// Offset of each fixed endpoint's attributes in attributeData; the last entry is the total size.
+uint16_t fixedEndpointStorageOffsets[FIXED_ENDPOINT_COUNT + 1];
+
+constexpr size_t kMetadataCacheSize = CHIP_CONFIG_EMBER_METADATA_LOOKUP_CACHE_SIZE;
+static_assert(kMetadataCacheSize > 0 && (kMetadataCacheSize & (kMetadataCacheSize - 1)) == 0,
+              "CHIP_CONFIG_EMBER_METADATA_LOOKUP_CACHE_SIZE must be a power of two");
+
+constexpr uint8_t kClusterNotFound    = 0xFF;
+constexpr uint16_t kAttributeNotFound = 0xFFFF;
+
+struct ClusterCacheEntry
+{
+    const EmberAfEndpointType * endpointType = nullptr;
+    ClusterId clusterId;
+    EmberAfClusterMask mask;
+    uint8_t position; // index into endpointType->cluster, or kClusterNotFound
+    uint8_t scopedIndex;
+    uint16_t storageOffset;
+};
+
+struct AttributeCacheEntry
+{
+    const EmberAfCluster * cluster = nullptr;
+    AttributeId attributeId;
+    uint16_t position; // index into cluster->attributes, or kAttributeNotFound
+    uint16_t storageOffset;
+};
+
+ClusterCacheEntry clusterCache[kMetadataCacheSize];
+AttributeCacheEntry attributeCache[kMetadataCacheSize];
+
+size_t MetadataCacheSlot(const void * key, uint32_t id)
+{
+    uint32_t hash = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(key) >> 2) ^ id;
+    return ((hash * 2654435761u) >> 16) & (kMetadataCacheSize - 1);
+}
+
+void FlushMetadataCaches()
+{
+    for (auto & entry : clusterCache)
+    {
+        entry.endpointType = nullptr;
+    }
+    for (auto & entry : attributeCache)
+    {
+        entry.cluster = nullptr;
+    }
+}
+
+void EndpointIndexInsert(uint16_t index)
+{
+    EndpointId endpoint = emAfEndpoints[index].endpoint;
+    size_t slot         = endpoint & kEndpointIndexMask;
+    while (endpointIndex[slot].index != kEmberInvalidEndpointIndex)
+    {
+        slot = (slot + 1) & kEndpointIndexMask;
+    }
+    endpointIndex[slot].endpoint = endpoint;
+    endpointIndex[slot].index    = index;
+}
+
+void EndpointIndexRemove(uint16_t index)
+{
+    size_t slot = emAfEndpoints[index].endpoint & kEndpointIndexMask;
+    while (endpointIndex[slot].index != index)
+    {
+        VerifyOrDie(endpointIndex[slot].index != kEmberInvalidEndpointIndex);
+        slot = (slot + 1) & kEndpointIndexMask;
+    }
+
+    // Move later entries of the probe sequence into the hole, unless their home slot lies (cyclically) after it.
+    size_t hole = slot;
+    size_t next = (hole + 1) & kEndpointIndexMask;
+    while (endpointIndex[next].index != kEmberInvalidEndpointIndex)
+    {
+        size_t home = endpointIndex[next].endpoint & kEndpointIndexMask;
+        if (((next - home) & kEndpointIndexMask) >= ((next - hole) & kEndpointIndexMask))
+        {
+            endpointIndex[hole] = endpointIndex[next];
+            hole                = next;
+        }
+        next = (next + 1) & kEndpointIndexMask;
+    }
+    endpointIndex[hole] = EndpointIndexSlot();
+}
+
+void InvalidateLookupIndex()
+{
+    endpointIndexValid = false;
+    FlushMetadataCaches();
+}
+
+void EnsureEndpointIndex()
+{
+    if (endpointIndexValid)
+    {
+        return;
+    }
+
+    for (auto & slot : endpointIndex)
+    {
+        slot = EndpointIndexSlot();
+    }
+    for (uint16_t index = 0; index < MAX_ENDPOINT_COUNT; index++)
+    {
+        if (emAfEndpoints[index].endpoint != kInvalidEndpointId)
+        {
+            EndpointIndexInsert(index);
+        }
+    }
+
+    uint16_t offset = 0;
+    for (uint16_t index = 0; index < FIXED_ENDPOINT_COUNT; index++)
+    {
+        fixedEndpointStorageOffsets[index] = offset;
+        if (emAfEndpoints[index].endpointType != nullptr)
+        {
+            offset = static_cast<uint16_t>(offset + emAfEndpoints[index].endpointType->endpointSize);
+        }
+    }
+    fixedEndpointStorageOffsets[FIXED_ENDPOINT_COUNT] = offset;
+
+    endpointIndexValid = true;
+}
+
+// Returns the lowest index in [begin, end) of an endpoint with the given id, or kEmberInvalidEndpointIndex.
+uint16_t LookupEndpointIndex(EndpointId endpoint, uint16_t begin, uint16_t end, bool ignoreDisabledEndpoints)
 {
     if (endpoint == kInvalidEndpointId)
     {
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t epi;
-    for (epi = 0; epi < emberAfEndpointCount(); epi++)
+    EnsureEndpointIndex();
+
+    // Endpoint IDs are normally unique, but keep the first match like a linear scan would if they are not.
+    uint16_t result = kEmberInvalidEndpointIndex;
+    for (size_t slot = endpoint & kEndpointIndexMask; endpointIndex[slot].index != kEmberInvalidEndpointIndex;
+         slot = (slot + 1) & kEndpointIndexMask)
+    {
+        uint16_t index = endpointIndex[slot].index;
+        if (endpointIndex[slot].endpoint == endpoint && index >= begin && index < end && index < result &&
+            (!ignoreDisabledEndpoints || emAfEndpoints[index].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
+        {
+            result = index;
+        }
+    }
+    return result;
+}
+
+uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
+{
+    return LookupEndpointIndex(endpoint, 0, emberAfEndpointCount(), ignoreDisabledEndpoints);
+}
+
+// Finds the cluster with the given id and matching the mask (0 matches any cluster) in the endpoint type.
+// On success, optionally returns the index of the cluster among those matching the mask, and the offset
+// of the cluster's attributes within the endpoint's attribute storage.
+const EmberAfCluster * FindClusterInType(const EmberAfEndpointType * endpointType, ClusterId clusterId, EmberAfClusterMask mask,
+                                         uint8_t * scopedIndex, uint16_t * storageOffset)
+{
+    ClusterCacheEntry & entry = clusterCache[MetadataCacheSlot(endpointType, clusterId ^ (static_cast<uint32_t>(mask) << 24))];
+    if (entry.endpointType != endpointType || entry.clusterId != clusterId || entry.mask != mask)
+    {
+        entry.endpointType  = endpointType;
+        entry.clusterId     = clusterId;
+        entry.mask          = mask;
+        entry.position      = kClusterNotFound;
+        entry.scopedIndex   = 0;
+        entry.storageOffset = 0;
+
+        for (uint8_t i = 0; i < endpointType->clusterCount; i++)
+        {
+            const EmberAfCluster * cluster = &(endpointType->cluster[i]);
+
+            if (mask == 0 || ((cluster->mask & mask) != 0))
+            {
+                if (cluster->clusterId == clusterId)
+                {
+                    entry.position = i;
+                    break;
+                }
+
+                entry.scopedIndex++;
+            }
+
+            entry.storageOffset = static_cast<uint16_t>(entry.storageOffset + cluster->clusterSize);
+        }
+    }
+
+    if (entry.position == kClusterNotFound)
+    {
+        return nullptr;
+    }
+    if (scopedIndex != nullptr)
+    {
+        *scopedIndex = entry.scopedIndex;
+    }
+    if (storageOffset != nullptr)
+    {
+        *storageOffset = entry.storageOffset;
+    }
+    return &(endpointType->cluster[entry.position]);
+}
+
+// Finds the attribute with the given id in the cluster, and the offset of its value within the cluster's
+// attribute storage.
+const EmberAfAttributeMetadata * FindAttributeInCluster(const EmberAfCluster * cluster, AttributeId attributeId,
+                                                        uint16_t & storageOffset)
+{
+    AttributeCacheEntry & entry = attributeCache[MetadataCacheSlot(cluster, attributeId)];
+    if (entry.cluster != cluster || entry.attributeId != attributeId)
     {
-        if (emAfEndpoints[epi].endpoint == endpoint &&
-            (!ignoreDisabledEndpoints || emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
+        entry.cluster       = cluster;
+        entry.attributeId   = attributeId;
+        entry.position      = kAttributeNotFound;
+        entry.storageOffset = 0;
+
+        for (uint16_t i = 0; i < cluster->attributeCount; i++)
         {
-            return epi;
+            const EmberAfAttributeMetadata * am = &(cluster->attributes[i]);
+            if (am->attributeId == attributeId)
+            {
+                entry.position = i;
+                break;
+            }
+
+            // Only attributes that are neither externally stored nor singletons occupy attribute storage.
+            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+            {
+                entry.storageOffset = static_cast<uint16_t>(entry.storageOffset + emberAfAttributeSize(am));
+            }
         }
     }
-    return kEmberInvalidEndpointIndex;
+
+    if (entry.position == kAttributeNotFound)
+    {
+        return nullptr;
+    }
+    storageOffset = entry.storageOffset;
+    return &(cluster->attributes[entry.position]);
 }
 
 // Returns the index of a given endpoint.  Considers disabled endpoints.
@@ -236,6 +491,8 @@ void emberAfEndpointConfigure()
         }
     }
 #endif
+
+    InvalidateLookupIndex();
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
@@ -250,15 +507,12 @@ uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t index;
-    for (index = FIXED_ENDPOINT_COUNT; index < MAX_ENDPOINT_COUNT; index++)
+    uint16_t index = LookupEndpointIndex(id, FIXED_ENDPOINT_COUNT, MAX_ENDPOINT_COUNT, false /* ignoreDisabledEndpoints */);
+    if (index == kEmberInvalidEndpointIndex)
     {
-        if (emAfEndpoints[index].endpoint == id)
-        {
-            return static_cast<uint8_t>(index - FIXED_ENDPOINT_COUNT);
-        }
+        return kEmberInvalidEndpointIndex;
     }
-    return kEmberInvalidEndpointIndex;
+    return static_cast<uint8_t>(index - FIXED_ENDPOINT_COUNT);
 }
 
 CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberAfEndpointType * ep,
@@ -283,13 +537,18 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     }
 
     index = static_cast<uint16_t>(realIndex);
-    for (uint16_t i = FIXED_ENDPOINT_COUNT; i < MAX_ENDPOINT_COUNT; i++)
+    if (LookupEndpointIndex(id, FIXED_ENDPOINT_COUNT, MAX_ENDPOINT_COUNT, false /* ignoreDisabledEndpoints */) !=
+        kEmberInvalidEndpointIndex)
     {
-        if (emAfEndpoints[i].endpoint == id)
-        {
-            return CHIP_ERROR_ENDPOINT_EXISTS;
-        }
+        return CHIP_ERROR_ENDPOINT_EXISTS;
+    }
+
+    if (emAfEndpoints[index].endpoint != kInvalidEndpointId)
+    {
+        EndpointIndexRemove(index);
     }
+    // The endpoint type previously at this index may have been released.
+    FlushMetadataCaches();
 
     emAfEndpoints[index].endpoint       = id;
     emAfEndpoints[index].deviceTypeList = deviceTypeList;
@@ -298,6 +557,7 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     // Start the endpoint off as disabled.
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
+    EndpointIndexInsert(index);
 
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
 
@@ -329,6 +589,9 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
     {
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
+        EnsureEndpointIndex();
+        EndpointIndexRemove(index);
+        FlushMetadataCaches();
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
     }
 
@@ -527,34 +790,6 @@ static Status typeSensitiveMemCopy(ClusterId clusterId, uint8_t * dest, uint8_t
     return Status::Success;
 }
 
-/**
- * @brief Matches a cluster based on cluster id and direction.
- *
- *   This function assumes that the passed cluster's endpoint already
- *   matches the endpoint of the EmberAfAttributeSearchRecord.
- *
- * Clusters match if:
- *   1. Cluster ids match AND
- *   2. Cluster is a server cluster (because there are no client attributes).
- */
-bool emAfMatchCluster(const EmberAfCluster * cluster, const EmberAfAttributeSearchRecord * attRecord)
-{
-    return (cluster->clusterId == attRecord->clusterId && (cluster->mask & CLUSTER_MASK_SERVER));
-}
-
-/**
- * @brief Matches an attribute based on attribute id.
- *   This function assumes that the passed cluster already matches the
- *   clusterId and direction of the passed EmberAfAttributeSearchRecord.
- *
- * Attributes match if attr ids match.
- */
-bool emAfMatchAttribute(const EmberAfCluster * cluster, const EmberAfAttributeMetadata * am,
-                        const EmberAfAttributeSearchRecord * attRecord)
-{
-    return (am->attributeId == attRecord->attributeId);
-}
-
 // When reading non-string attributes, this function returns an error when destination
 // buffer isn't large enough to accommodate the attribute type.  For strings, the
 // function will copy at most readLength bytes.  This means the resulting string
@@ -573,117 +808,84 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
 {
     assertChipStackLockedByCurrentThread();
 
-    uint16_t attributeOffsetIndex = 0;
-
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    uint16_t ep = findIndexFromEndpoint(attRecord->endpoint, true /* ignoreDisabledEndpoints */);
+    if (ep == kEmberInvalidEndpointIndex)
     {
-        // Is this a dynamic endpoint?
-        bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
+        return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+    }
 
-        if (emAfEndpoints[ep].endpoint == attRecord->endpoint)
-        {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t clusterIndex;
-            if (!emberAfEndpointIndexIsEnabled(ep))
-            {
-                continue;
-            }
-            for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
-            {
-                const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
-                if (emAfMatchCluster(cluster, attRecord))
-                { // Got the cluster
-                    uint16_t attrIndex;
-                    for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
-                    {
-                        const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
-                        if (emAfMatchAttribute(cluster, am, attRecord))
-                        { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != nullptr)
-                            {
-                                *metadata = am;
-                            }
+    // Is this a dynamic endpoint?
+    bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
 
-                            {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == nullptr)
-                                    {
-                                        return Status::Success;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-
-                                // Is the attribute externally stored?
-                                if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
-                                {
-                                    return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                          am, buffer)
-                                                  : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                         am, buffer, emberAfAttributeSize(am)));
-                                }
-
-                                // Internal storage is only supported for fixed endpoints
-                                if (!isDynamicEndpoint)
-                                {
-                                    return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                                }
-
-                                return Status::Failure;
-                            }
-                        }
-                        else
-                        { // Not the attribute we are looking for
-                            // Increase the index if attribute is not externally stored
-                            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
-                            {
-                                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
-                            }
-                        }
-                    }
+    uint16_t clusterOffset;
+    const EmberAfCluster * cluster =
+        FindClusterInType(emAfEndpoints[ep].endpointType, attRecord->clusterId, CLUSTER_MASK_SERVER, nullptr, &clusterOffset);
+    if (cluster == nullptr)
+    {
+        // Cluster is not in the endpoint.
+        return Status::UnsupportedCluster;
+    }
 
-                    // Attribute is not in the cluster.
-                    return Status::UnsupportedAttribute;
-                }
+    uint16_t attributeOffset;
+    const EmberAfAttributeMetadata * am = FindAttributeInCluster(cluster, attRecord->attributeId, attributeOffset);
+    if (am == nullptr)
+    {
+        // Attribute is not in the cluster.
+        return Status::UnsupportedAttribute;
+    }
 
-                // Not the cluster we are looking for
-                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
-            }
+    // If passed metadata location is not null, populate
+    if (metadata != nullptr)
+    {
+        *metadata = am;
+    }
+
+    // Dynamic endpoints are external and don't factor into storage size
+    uint16_t attributeOffsetIndex = static_cast<uint16_t>(
+        fixedEndpointStorageOffsets[isDynamicEndpoint ? FIXED_ENDPOINT_COUNT : ep] + clusterOffset + attributeOffset);
 
-            // Cluster is not in the endpoint.
-            return Status::UnsupportedCluster;
+    uint8_t * attributeLocation =
+        (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am) : attributeData + attributeOffsetIndex);
+    uint8_t *src, *dst;
+    if (write)
+    {
+        src = buffer;
+        dst = attributeLocation;
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return Status::UnsupportedAccess;
+        }
+    }
+    else
+    {
+        if (buffer == nullptr)
+        {
+            return Status::Success;
         }
 
-        // Not the endpoint we are looking for
-        // Dynamic endpoints are external and don't factor into storage size
-        if (!isDynamicEndpoint)
+        src = attributeLocation;
+        dst = buffer;
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
         {
-            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emAfEndpoints[ep].endpointType->endpointSize);
+            return Status::UnsupportedAccess;
         }
     }
-    return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+
+    // Is the attribute externally stored?
+    if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
+    {
+        return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am, buffer)
+                      : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am, buffer,
+                                                             emberAfAttributeSize(am)));
+    }
+
+    // Internal storage is only supported for fixed endpoints
+    if (!isDynamicEndpoint)
+    {
+        return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
+    }
+
+    return Status::Failure;
 }
 
 const EmberAfEndpointType * emberAfFindEndpointType(chip::EndpointId endpointId)
@@ -699,46 +901,20 @@ const EmberAfEndpointType * emberAfFindEndpointType(chip::EndpointId endpointId)
 const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endpointType, ClusterId clusterId,
                                                 EmberAfClusterMask mask, uint8_t * index)
 {
-    uint8_t i;
-    uint8_t scopedIndex = 0;
-
-    for (i = 0; i < endpointType->clusterCount; i++)
-    {
-        const EmberAfCluster * cluster = &(endpointType->cluster[i]);
-
-        if (mask == 0 || ((cluster->mask & mask) != 0))
-        {
-            if (cluster->clusterId == clusterId)
-            {
-                if (index)
-                {
-                    *index = scopedIndex;
-                }
-
-                return cluster;
-            }
-
-            scopedIndex++;
-        }
-    }
-
-    return nullptr;
+    return FindClusterInType(endpointType, clusterId, mask, index, nullptr);
 }
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    // Look up the endpoint first, because that way we avoid examining the
+    // endpoint type for endpoints that are not actually defined.
+    uint16_t ep = findIndexFromEndpoint(endpoint, false /* ignoreDisabledEndpoints */);
+    if (ep != kEmberInvalidEndpointIndex)
     {
-        // Check the endpoint id first, because that way we avoid examining the
-        // endpoint type for endpoints that are not actually defined.
-        if (emAfEndpoints[ep].endpoint == endpoint)
+        uint8_t index = 0xFF;
+        if (emberAfFindClusterInType(emAfEndpoints[ep].endpointType, clusterId, mask, &index) != nullptr)
         {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t index                            = 0xFF;
-            if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
-            {
-                return index;
-            }
+            return index;
         }
     }
     return 0xFF;
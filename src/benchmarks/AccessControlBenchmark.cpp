@@ -0,0 +1,129 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Times <tt>chip::Access::AccessControl::Check</tt> with a full access control list.
+ */
+
+#include <inttypes.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <access/AccessControl.h>
+#include <access/examples/ExampleAccessControlDelegate.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::Access;
+
+namespace {
+
+using Entry  = AccessControl::Entry;
+using Target = Entry::Target;
+
+class NoDeviceTypeResolver : public AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+} sDeviceTypeResolver;
+
+class BenchmarkAccessControl : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_EQ(mAccessControl.Init(Examples::GetAccessControlDelegate(), sDeviceTypeResolver), CHIP_NO_ERROR);
+    }
+    void TearDown() override { mAccessControl.Finish(); }
+
+protected:
+    AccessControl mAccessControl;
+};
+
+} // namespace
+
+// Fills the access control list and checks every attribute of a large data model, as a wildcard read does.
+TEST_F(BenchmarkAccessControl, WildcardReadWithFullAcl)
+{
+    constexpr EndpointId kEndpoints          = 8;
+    constexpr ClusterId kClustersPerEndpoint = 40;
+    constexpr unsigned kAttributesPerCluster = 20;
+    constexpr NodeId kReader                 = 0x0000'0000'ABCD'0001;
+    constexpr FabricIndex kReaderFabric      = 1;
+
+    size_t maxEntryCount       = 0;
+    size_t maxEntriesPerFabric = 0;
+    size_t maxSubjects         = 0;
+    size_t maxTargets          = 0;
+    ASSERT_EQ(mAccessControl.GetMaxEntryCount(maxEntryCount), CHIP_NO_ERROR);
+    ASSERT_EQ(mAccessControl.GetMaxEntriesPerFabric(maxEntriesPerFabric), CHIP_NO_ERROR);
+    ASSERT_EQ(mAccessControl.GetMaxSubjectsPerEntry(maxSubjects), CHIP_NO_ERROR);
+    ASSERT_EQ(mAccessControl.GetMaxTargetsPerEntry(maxTargets), CHIP_NO_ERROR);
+
+    // Every entry names other subjects and endpoints, except the last one of the reader's fabric, which grants it access
+    // to the clusters of the last endpoint.
+    NodeId nextSubject = 0x0000'0000'1000'0000;
+    for (size_t i = 0; i < maxEntryCount; ++i)
+    {
+        const auto fabricIndex = static_cast<FabricIndex>(1 + i / maxEntriesPerFabric);
+        const bool isLast      = (fabricIndex == kReaderFabric) && (i + 1 == maxEntriesPerFabric);
+
+        Entry entry;
+        ASSERT_EQ(mAccessControl.PrepareEntry(entry), CHIP_NO_ERROR);
+        ASSERT_EQ(entry.SetFabricIndex(fabricIndex), CHIP_NO_ERROR);
+        ASSERT_EQ(entry.SetAuthMode(AuthMode::kCase), CHIP_NO_ERROR);
+        ASSERT_EQ(entry.SetPrivilege(Privilege::kView), CHIP_NO_ERROR);
+        for (size_t j = 0; j < maxSubjects; ++j)
+        {
+            ASSERT_EQ(entry.AddSubject(nullptr, (isLast && j + 1 == maxSubjects) ? kReader : nextSubject++), CHIP_NO_ERROR);
+        }
+        for (size_t j = 0; j < maxTargets; ++j)
+        {
+            Target target = { .flags = Target::kEndpoint, .endpoint = static_cast<EndpointId>(isLast ? kEndpoints - 1 : 100 + j) };
+            ASSERT_EQ(entry.AddTarget(nullptr, target), CHIP_NO_ERROR);
+        }
+        ASSERT_EQ(mAccessControl.CreateEntry(nullptr, entry), CHIP_NO_ERROR);
+    }
+
+    const SubjectDescriptor subjectDescriptor = { .fabricIndex = kReaderFabric, .authMode = AuthMode::kCase, .subject = kReader };
+
+    unsigned allowed = 0;
+    const auto start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (EndpointId endpoint = 0; endpoint < kEndpoints; ++endpoint)
+    {
+        for (ClusterId cluster = 0; cluster < kClustersPerEndpoint; ++cluster)
+        {
+            for (unsigned attribute = 0; attribute < kAttributesPerCluster; ++attribute)
+            {
+                RequestPath requestPath = { .cluster = cluster, .endpoint = endpoint };
+                if (mAccessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_NO_ERROR)
+                {
+                    ++allowed;
+                }
+            }
+        }
+    }
+    const auto elapsed = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    EXPECT_EQ(allowed, kClustersPerEndpoint * kAttributesPerCluster);
+
+    ChipLogProgress(Test, "%u checks against %u entries, check index %s: %" PRIu64 " us",
+                    static_cast<unsigned>(kEndpoints * kClustersPerEndpoint * kAttributesPerCluster),
+                    static_cast<unsigned>(maxEntryCount), CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX ? "on" : "off", elapsed.count());
+}
@@ -0,0 +1,142 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Times the AES-CCM batch API against per-message encryption and decryption.
+ */
+
+#include <inttypes.h>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+#if CHIP_CRYPTO_PSA
+#include <psa/crypto.h>
+#endif
+
+using namespace chip;
+using namespace chip::Crypto;
+
+namespace {
+
+class BenchmarkAesCcmBatch : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR);
+#if CHIP_CRYPTO_PSA
+        psa_crypto_init();
+#endif
+    }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+};
+
+struct RandomAesKey
+{
+    RandomAesKey()
+    {
+        Symmetric128BitsKeyByteArray keyMaterial;
+        EXPECT_EQ(DRBG_get_bytes(keyMaterial, sizeof(keyMaterial)), CHIP_NO_ERROR);
+        EXPECT_EQ(keystore.CreateKey(keyMaterial, key), CHIP_NO_ERROR);
+    }
+
+    ~RandomAesKey() { keystore.DestroyKey(key); }
+
+    DefaultSessionKeystore keystore;
+    Aes128KeyHandle key;
+};
+
+} // namespace
+
+TEST_F(BenchmarkAesCcmBatch, BatchAgainstSingle)
+{
+    constexpr size_t kMessageLength = 64;
+    constexpr size_t kMessageCount  = 1024;
+    constexpr size_t kTagLength     = CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES;
+    constexpr size_t kNonceLength   = CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES;
+    constexpr int kRounds           = 20;
+
+    RandomAesKey key;
+
+    std::vector<uint8_t> plaintext(kMessageCount * kMessageLength);
+    std::vector<uint8_t> nonces(kMessageCount * kNonceLength);
+    std::vector<uint8_t> ciphertext(kMessageCount * kMessageLength);
+    std::vector<uint8_t> decrypted(kMessageCount * kMessageLength);
+    std::vector<uint8_t> tags(kMessageCount * kTagLength);
+    uint8_t aad[16];
+    ASSERT_EQ(DRBG_get_bytes(plaintext.data(), plaintext.size()), CHIP_NO_ERROR);
+    ASSERT_EQ(DRBG_get_bytes(nonces.data(), nonces.size()), CHIP_NO_ERROR);
+    ASSERT_EQ(DRBG_get_bytes(aad, sizeof(aad)), CHIP_NO_ERROR);
+
+    std::vector<AesCcmBatchEntry> encryptEntries(kMessageCount);
+    std::vector<AesCcmBatchEntry> decryptEntries(kMessageCount);
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        AesCcmBatchEntry & entry = encryptEntries[i];
+        entry.input              = &plaintext[i * kMessageLength];
+        entry.input_length       = kMessageLength;
+        entry.aad                = aad;
+        entry.aad_length         = sizeof(aad);
+        entry.nonce              = &nonces[i * kNonceLength];
+        entry.nonce_length       = kNonceLength;
+        entry.output             = &ciphertext[i * kMessageLength];
+        entry.tag                = &tags[i * kTagLength];
+        entry.tag_length         = kTagLength;
+
+        decryptEntries[i]        = entry;
+        decryptEntries[i].input  = entry.output;
+        decryptEntries[i].output = &decrypted[i * kMessageLength];
+    }
+
+    const auto singleStart = System::SystemClock().GetMonotonicMicroseconds64();
+    for (int round = 0; round < kRounds; round++)
+    {
+        for (auto & entry : encryptEntries)
+        {
+            ASSERT_EQ(AES_CCM_encrypt(entry.input, entry.input_length, entry.aad, entry.aad_length, key.key, entry.nonce,
+                                      entry.nonce_length, entry.output, entry.tag, entry.tag_length),
+                      CHIP_NO_ERROR);
+        }
+        for (auto & entry : decryptEntries)
+        {
+            ASSERT_EQ(AES_CCM_decrypt(entry.input, entry.input_length, entry.aad, entry.aad_length, entry.tag, entry.tag_length,
+                                      key.key, entry.nonce, entry.nonce_length, entry.output),
+                      CHIP_NO_ERROR);
+        }
+    }
+    const auto singleMicros = (System::SystemClock().GetMonotonicMicroseconds64() - singleStart).count();
+
+    const auto batchStart = System::SystemClock().GetMonotonicMicroseconds64();
+    for (int round = 0; round < kRounds; round++)
+    {
+        ASSERT_EQ(AES_CCM_encrypt_batch(encryptEntries.data(), encryptEntries.size(), key.key), CHIP_NO_ERROR);
+        ASSERT_EQ(AES_CCM_decrypt_batch(decryptEntries.data(), decryptEntries.size(), key.key), CHIP_NO_ERROR);
+    }
+    const auto batchMicros = (System::SystemClock().GetMonotonicMicroseconds64() - batchStart).count();
+
+    ChipLogProgress(Test, "AES-CCM %u x %u-byte messages, %d rounds: single %" PRIu64 " us, batch %" PRIu64 " us",
+                    static_cast<unsigned>(kMessageCount), static_cast<unsigned>(kMessageLength), kRounds, singleMicros,
+                    batchMicros);
+}
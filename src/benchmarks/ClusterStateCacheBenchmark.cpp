@@ -0,0 +1,156 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Times the storage modes of <tt>chip::app::ClusterStateCache</tt> on a large wildcard read.
+ */
+
+#include <inttypes.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <app/ClusterStateCache.h>
+#include <app/MessageDef/DataVersionFilterIBs.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+class BenchmarkClusterStateCache : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+};
+
+template <typename CacheType>
+class NullCacheCallback final : public CacheType::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+// Claim a wildcard request path, so that the cache tracks data versions.  Must be done before the cache sees any reports.
+template <typename CacheType>
+void ClaimWildcardPath(CacheType & cache)
+{
+    AttributePathParams wildcardPath;
+    const Span<AttributePathParams> pathSpan(&wildcardPath, 1);
+    uint8_t buf[20];
+    TLV::TLVWriter writer;
+    writer.Init(buf);
+    DataVersionFilterIBs::Builder builder;
+    ASSERT_EQ(builder.Init(&writer), CHIP_NO_ERROR);
+    bool encodedDataVersionList = false;
+    ASSERT_EQ(cache.GetBufferedCallback().OnUpdateDataVersionFilterList(builder, pathSpan, encodedDataVersionList), CHIP_NO_ERROR);
+}
+
+// Replays a report for a wildcard read of a node with the given number of endpoints, clusters per endpoint and attributes per
+// cluster, in the order a publisher sends them.
+template <typename CacheType>
+void ReplayWildcardRead(CacheType & cache, EndpointId endpointCount, ClusterId clusterCount, AttributeId attributeCount,
+                        DataVersion version)
+{
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+    callback.OnReportBegin();
+
+    for (EndpointId e = 0; e < endpointCount; e++)
+    {
+        for (ClusterId c = 0; c < clusterCount; c++)
+        {
+            for (AttributeId a = 0; a < attributeCount; a++)
+            {
+                ConcreteDataAttributePath path(e, c, a);
+                path.mDataVersion.SetValue(version);
+
+                uint8_t buf[16];
+                TLV::TLVWriter writer;
+                writer.Init(buf);
+                EXPECT_EQ(writer.Put(TLV::AnonymousTag(), version + a), CHIP_NO_ERROR);
+
+                TLV::TLVReader reader;
+                reader.Init(buf, writer.GetLengthWritten());
+                EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+                callback.OnAttributeData(path, &reader, StatusIB());
+            }
+        }
+    }
+
+    callback.OnReportEnd();
+}
+
+// Looks up the data version of every cluster and, if the cache stores data, every attribute value.
+template <typename CacheType>
+void LookUpWildcardRead(CacheType & cache, EndpointId endpointCount, ClusterId clusterCount, AttributeId attributeCount,
+                        bool cachesData)
+{
+    for (EndpointId e = 0; e < endpointCount; e++)
+    {
+        for (ClusterId c = 0; c < clusterCount; c++)
+        {
+            Optional<DataVersion> clusterVersion;
+            EXPECT_EQ(cache.GetVersion(ConcreteClusterPath(e, c), clusterVersion), CHIP_NO_ERROR);
+
+            for (AttributeId a = 0; cachesData && a < attributeCount; a++)
+            {
+                TLV::TLVReader reader;
+                EXPECT_EQ(cache.Get(ConcreteAttributePath(e, c, a), reader), CHIP_NO_ERROR);
+            }
+        }
+    }
+}
+
+template <typename CacheType>
+void RunWildcardRead(const char * name, bool cachesData)
+{
+    // A bridge with many endpoints.
+    constexpr EndpointId kEndpoints   = 64;
+    constexpr ClusterId kClusters     = 16;
+    constexpr AttributeId kAttributes = 24;
+
+    NullCacheCallback<CacheType> callback;
+    CacheType cache(callback);
+    ClaimWildcardPath(cache);
+
+    const auto start = System::SystemClock().GetMonotonicMicroseconds64();
+    ReplayWildcardRead(cache, kEndpoints, kClusters, kAttributes, 1);
+    const auto primed = System::SystemClock().GetMonotonicMicroseconds64();
+    ReplayWildcardRead(cache, kEndpoints, kClusters, kAttributes, 2);
+    const auto updated = System::SystemClock().GetMonotonicMicroseconds64();
+    LookUpWildcardRead(cache, kEndpoints, kClusters, kAttributes, cachesData);
+    const auto lookedUp = System::SystemClock().GetMonotonicMicroseconds64();
+
+    ChipLogProgress(Test, "%s: %u attributes: priming report %" PRIu64 " us, update report %" PRIu64 " us, lookups %" PRIu64 " us",
+                    name, static_cast<unsigned>(kEndpoints * kClusters * kAttributes), (primed - start).count(),
+                    (updated - primed).count(), (lookedUp - updated).count());
+}
+
+} // namespace
+
+TEST_F(BenchmarkClusterStateCache, WildcardRead)
+{
+    RunWildcardRead<ClusterStateCache>("tree storage", true);
+    RunWildcardRead<ClusterStateCacheFlat>("flat storage", true);
+    RunWildcardRead<ClusterStateCacheNoData>("tree storage, no data", false);
+    RunWildcardRead<ClusterStateCacheNoDataFlat>("flat storage, no data", false);
+}
@@ -0,0 +1,147 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Times the group session lookups of <tt>chip::Credentials::GroupDataProviderImpl</tt>, from storage and from its
+ *      group session cache.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <credentials/GroupDataProviderImpl.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::Credentials;
+
+namespace {
+
+using GroupKey       = GroupDataProvider::GroupKey;
+using GroupSession   = GroupDataProvider::GroupSession;
+using KeySet         = GroupDataProvider::KeySet;
+using SecurityPolicy = GroupDataProvider::SecurityPolicy;
+
+constexpr uint16_t kMaxGroupsPerFabric    = 8;
+constexpr uint16_t kMaxGroupKeysPerFabric = 8;
+
+const uint8_t kCompressedFabricId[] = { 0x87, 0xe1, 0xb0, 0x04, 0xe2, 0x35, 0xa1, 0x30 };
+
+class BenchmarkGroupSession : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        mProvider.SetStorageDelegate(&mStorage);
+        mProvider.SetSessionKeystore(&mSessionKeystore);
+        ASSERT_EQ(mProvider.Init(), CHIP_NO_ERROR);
+    }
+    void TearDown() override { mProvider.Finish(); }
+
+protected:
+    TestPersistentStorageDelegate mStorage;
+    Crypto::DefaultSessionKeystore mSessionKeystore;
+    GroupDataProviderImpl mProvider{ kMaxGroupsPerFabric, kMaxGroupKeysPerFabric };
+};
+
+size_t CountGroupSessions(GroupDataProvider & provider, uint16_t sessionId)
+{
+    auto it = provider.IterateGroupSessions(sessionId);
+    VerifyOrReturnValue(it != nullptr, 0);
+
+    GroupSession session;
+    size_t count = 0;
+    while (it->Next(session))
+    {
+        count++;
+    }
+    it->Release();
+    return count;
+}
+
+} // namespace
+
+// Every group message received looks up the sessions of its key hash. Two fabrics each map several groups to key sets of
+// three epoch keys, so storage has as many operational keys to derive and compare as a busy node does.
+TEST_F(BenchmarkGroupSession, LookupFromStorageAndCache)
+{
+    constexpr FabricIndex kFabrics[]     = { 1, 7 };
+    constexpr uint16_t kKeySetsPerFabric = 4;
+    constexpr GroupId kGroupsPerFabric   = 6;
+    constexpr int kLookups               = 1000;
+
+    std::vector<uint16_t> sessionIds;
+    uint8_t keyByte = 1;
+    for (FabricIndex fabric : kFabrics)
+    {
+        for (uint16_t keySetId = 1; keySetId <= kKeySetsPerFabric; keySetId++)
+        {
+            KeySet keySet(keySetId, SecurityPolicy::kTrustFirst, KeySet::kEpochKeysMax);
+            for (auto & epochKey : keySet.epoch_keys)
+            {
+                epochKey.start_time = keyByte;
+                memset(epochKey.key, keyByte++, sizeof(epochKey.key));
+            }
+            ASSERT_EQ(mProvider.SetKeySet(fabric, ByteSpan(kCompressedFabricId), keySet), CHIP_NO_ERROR);
+        }
+
+        for (GroupId group = 1; group <= kGroupsPerFabric; group++)
+        {
+            const auto keySetId = static_cast<uint16_t>(1 + group % kKeySetsPerFabric);
+            ASSERT_EQ(mProvider.SetGroupKeyAt(fabric, static_cast<size_t>(group - 1), GroupKey(group, keySetId)), CHIP_NO_ERROR);
+
+            Crypto::SymmetricKeyContext * keyContext = mProvider.GetKeyContext(fabric, group);
+            ASSERT_NE(keyContext, nullptr);
+            sessionIds.push_back(keyContext->GetKeyHash());
+            keyContext->Release();
+        }
+    }
+
+    size_t found = 0;
+
+    mProvider.SetGroupSessionCacheEnabled(false);
+    const auto storageStart = System::SystemClock().GetMonotonicMicroseconds64();
+    for (int i = 0; i < kLookups; i++)
+    {
+        found += CountGroupSessions(mProvider, sessionIds[static_cast<size_t>(i) % sessionIds.size()]);
+    }
+    const auto storageMicros = (System::SystemClock().GetMonotonicMicroseconds64() - storageStart).count();
+
+    mProvider.SetGroupSessionCacheEnabled(true);
+    const auto cacheStart = System::SystemClock().GetMonotonicMicroseconds64();
+    for (int i = 0; i < kLookups; i++)
+    {
+        found += CountGroupSessions(mProvider, sessionIds[static_cast<size_t>(i) % sessionIds.size()]);
+    }
+    const auto cacheMicros = (System::SystemClock().GetMonotonicMicroseconds64() - cacheStart).count();
+
+    EXPECT_GE(found, static_cast<size_t>(2 * kLookups));
+
+    ChipLogProgress(Test, "Group session lookups, %d messages: storage %" PRIu64 " us, cache %" PRIu64 " us", kLookups,
+                    storageMicros, cacheMicros);
+}
@@ -0,0 +1,143 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Times <tt>chip::app::reporting::SynchronizedReportSchedulerImpl</tt> with many subscriptions.
+ */
+
+#include <inttypes.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <app/InteractionModelEngine.h>
+#include <app/codegen-data-model/Instance.h>
+#include <app/reporting/SynchronizedReportSchedulerImpl.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
+#include <system/SystemClock.h>
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+namespace {
+
+class NullReadHandlerCallback : public ReadHandler::ManagementCallback
+{
+public:
+    void OnDone(ReadHandler & apReadHandlerObj) override {}
+    ReadHandler::ApplicationCallback * GetAppCallback() override { return nullptr; }
+    InteractionModelEngine * GetInteractionModelEngine() override { return InteractionModelEngine::GetInstance(); }
+};
+
+// Timers never fire and time stands still, so that only the bookkeeping of the scheduler is measured.
+class FrozenTimerDelegate : public ReportScheduler::TimerDelegate
+{
+public:
+    CHIP_ERROR StartTimer(TimerContext * context, System::Clock::Timeout aTimeout) override
+    {
+        mTimerContext = context;
+        return CHIP_NO_ERROR;
+    }
+    void CancelTimer(TimerContext * context) override { mTimerContext = nullptr; }
+    bool IsTimerActive(TimerContext * context) override { return mTimerContext != nullptr; }
+    System::Clock::Timestamp GetCurrentMonotonicTimestamp() override { return System::Clock::kZero; }
+
+private:
+    TimerContext * mTimerContext = nullptr;
+};
+
+} // namespace
+
+class BenchmarkReportScheduler : public chip::Test::AppContext
+{
+public:
+    void SynchronizedSchedulerManySubscriptions();
+
+    // Puts a new ReadHandler in the state of an established subscription, as the subscription transaction does.
+    static CHIP_ERROR EstablishSubscription(ReadHandler * readHandler, ReportScheduler & scheduler, uint16_t minIntervalSeconds,
+                                            uint16_t maxIntervalSeconds)
+    {
+        ReturnErrorOnFailure(readHandler->SetMaxReportingInterval(maxIntervalSeconds));
+        ReturnErrorOnFailure(readHandler->SetMinReportingIntervalForTests(minIntervalSeconds));
+        readHandler->ClearStateFlag(ReadHandler::ReadHandlerFlags::PrimingReports);
+        readHandler->SetStateFlag(ReadHandler::ReadHandlerFlags::ActiveSubscription);
+        scheduler.OnSubscriptionEstablished(readHandler);
+        readHandler->MoveToState(ReadHandler::HandlerState::CanStartReporting);
+        return CHIP_NO_ERROR;
+    }
+};
+
+// Registers many subscriptions whose max intervals are shared by several of them, then times the lookups of the next
+// common max timestamp and the rescheduling that follows every report.
+TEST_F_FROM_FIXTURE(BenchmarkReportScheduler, SynchronizedSchedulerManySubscriptions)
+{
+    constexpr size_t kNumSubscriptions = 2000;
+    constexpr int kLookups             = 1000;
+
+    NullReadHandlerCallback nullCallback;
+    FrozenTimerDelegate timerDelegate;
+    SynchronizedReportSchedulerImpl scheduler(&timerDelegate);
+    ObjectPool<ReadHandler, kNumSubscriptions> readHandlerPool;
+    Messaging::ExchangeContext * exchangeCtx = NewExchangeToAlice(nullptr, false);
+    ASSERT_NE(exchangeCtx, nullptr);
+
+    const auto start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t i = 0; i < kNumSubscriptions; i++)
+    {
+        ReadHandler * readHandler = readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe,
+                                                                 &scheduler, CodegenDataModelInstance());
+        ASSERT_NE(readHandler, nullptr);
+        // Max intervals from 2s to 201s.
+        EXPECT_EQ(EstablishSubscription(readHandler, scheduler, 1, static_cast<uint16_t>(2 + i % 200)), CHIP_NO_ERROR);
+    }
+    const auto registered = System::SystemClock().GetMonotonicMicroseconds64();
+
+    for (int i = 0; i < kLookups; i++)
+    {
+        EXPECT_EQ(scheduler.FindNextMaxInterval(System::Clock::kZero), CHIP_NO_ERROR);
+    }
+    const auto lookedUp = System::SystemClock().GetMonotonicMicroseconds64();
+
+    readHandlerPool.ForEachActiveObject([&scheduler](ReadHandler * handler) {
+        scheduler.OnSubscriptionReportSent(handler);
+        return Loop::Continue;
+    });
+    const auto rescheduled = System::SystemClock().GetMonotonicMicroseconds64();
+
+    EXPECT_EQ(scheduler.GetNumReadHandlers(), kNumSubscriptions);
+
+    scheduler.UnregisterAllHandlers();
+    readHandlerPool.ReleaseAll();
+    exchangeCtx->Close();
+
+    ChipLogProgress(Test,
+                    "Synchronized scheduler, %u subscriptions: registration %" PRIu64 " us, %d next max lookups %" PRIu64
+                    " us, reports sent %" PRIu64 " us",
+                    static_cast<unsigned>(kNumSubscriptions), (registered - start).count(), kLookups,
+                    (lookedUp - registered).count(), (rescheduled - lookedUp).count());
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -0,0 +1,96 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Times the dirty set of <tt>chip::app::reporting::Engine</tt>.
+ */
+
+#include <inttypes.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <app/InteractionModelEngine.h>
+#include <app/reporting/Engine.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <lib/support/tests/ExtraPwTestMacros.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+class BenchmarkReportingEngine : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void DirtySetUnderChurn();
+};
+
+// The same attributes of two clusters keep changing, as many of them as the dirty set can hold without merging, and a
+// report then looks up every attribute of both clusters.
+TEST_F_FROM_FIXTURE(BenchmarkReportingEngine, DirtySetUnderChurn)
+{
+    constexpr EndpointId kEndpointId       = 1;
+    constexpr ClusterId kClusterId         = 6;
+    constexpr uint32_t kRounds             = 1000;
+    constexpr AttributeId kDirtyAttributes = CHIP_IM_SERVER_MAX_NUM_DIRTY_SET;
+
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.ReleaseAllDirtyPaths();
+    const uint64_t startGeneration = engine.GetDirtySetGeneration();
+
+    const auto start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t round = 0; round < kRounds; round++)
+    {
+        for (AttributeId attribute = 0; attribute < kDirtyAttributes; attribute++)
+        {
+            engine.BumpDirtySetGeneration();
+            EXPECT_EQ(
+                engine.InsertPathIntoDirtySet(AttributePathParams(kEndpointId, ClusterId(kClusterId + attribute % 2), attribute)),
+                CHIP_NO_ERROR);
+        }
+    }
+    const auto inserted = System::SystemClock().GetMonotonicMicroseconds64();
+
+    uint32_t reported = 0;
+    for (ClusterId cluster = kClusterId; cluster <= kClusterId + 1; cluster++)
+    {
+        for (AttributeId attribute = 0; attribute < 2 * kDirtyAttributes; attribute++)
+        {
+            if (engine.IsAttributePathDirtySince(ConcreteAttributePath(kEndpointId, cluster, attribute), startGeneration))
+            {
+                reported++;
+            }
+        }
+    }
+    const auto lookedUp = System::SystemClock().GetMonotonicMicroseconds64();
+
+    EXPECT_EQ(reported, kDirtyAttributes);
+    engine.ReleaseAllDirtyPaths();
+
+    ChipLogProgress(Test, "Dirty set churn, %" PRIu32 " changes: inserts %" PRIu64 " us, %" PRIu32 " lookups %" PRIu64 " us",
+                    kRounds * kDirtyAttributes, (inserted - start).count(), static_cast<uint32_t>(4 * kDirtyAttributes),
+                    (lookedUp - inserted).count());
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,122 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Times <tt>chip::System::TimerWheel</tt> against <tt>chip::System::TimerList</tt>.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayerImpl.h>
+#include <system/SystemTimer.h>
+
+using namespace chip::System;
+
+namespace {
+
+void Callback(Layer * layer, void * state) {}
+
+void * AppState(uintptr_t n)
+{
+    return reinterpret_cast<void *>(n);
+}
+
+// Layer the timer nodes refer to; never initialized, since no callback is invoked.
+LayerImpl sLayer;
+
+class BenchmarkSystemTimer : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(::chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { ::chip::Platform::MemoryShutdown(); }
+};
+
+template <typename Timer>
+void DeleteAll(TimerList & list)
+{
+    TimerList::Node * timer;
+    while ((timer = list.PopEarliest()) != nullptr)
+    {
+        chip::Platform::Delete(static_cast<Timer *>(timer));
+    }
+}
+
+// Replays the timer pattern of a busy controller: every timer is restarted (cancel and re-add, as StartTimer() does)
+// once per round, and the timers due in that round expire.  Returns the time taken, in microseconds.
+template <typename Queue>
+uint64_t RunTimerPattern(size_t timerCount, size_t rounds)
+{
+    using Timer = typename Queue::Node;
+
+    Queue queue;
+    uint64_t now      = 0;
+    size_t fired      = 0;
+    const auto before = SystemClock().GetMonotonicMicroseconds64();
+
+    for (size_t round = 0; round < rounds; round++)
+    {
+        for (size_t i = 0; i < timerCount; i++)
+        {
+            chip::Platform::Delete(static_cast<Timer *>(queue.Remove(Callback, AppState(i + 1))));
+
+            // Deterministic spread of delays up to 5 s, like MRP and subscription timeouts.
+            const Clock::Timestamp awakenTime(now + (i * 7919) % 5000);
+            queue.Add(chip::Platform::New<Timer>(sLayer, awakenTime, Callback, AppState(i + 1)));
+        }
+
+        now += 100;
+        TimerList expired = queue.ExtractEarlier(Clock::Timestamp(now));
+        TimerList::Node * timer;
+        while ((timer = expired.PopEarliest()) != nullptr)
+        {
+            chip::Platform::Delete(static_cast<Timer *>(timer));
+            fired++;
+        }
+    }
+
+    const auto elapsed = SystemClock().GetMonotonicMicroseconds64() - before;
+
+    TimerList remaining = queue.ExtractEarlier(Clock::Timestamp(UINT64_MAX));
+    DeleteAll<Timer>(remaining);
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_GT(fired, 0u);
+
+    return elapsed.count();
+}
+
+} // namespace
+
+TEST_F(BenchmarkSystemTimer, TimerWheelAgainstTimerList)
+{
+    constexpr size_t kRounds = 100;
+
+    for (size_t timerCount : { 16u, 256u, 2048u })
+    {
+        const uint64_t listMicros  = RunTimerPattern<TimerList>(timerCount, kRounds);
+        const uint64_t wheelMicros = RunTimerPattern<TimerWheel>(timerCount, kRounds);
+
+        ChipLogProgress(Test, "%u timers x %u restarts: TimerList %" PRIu64 " us, TimerWheel %" PRIu64 " us",
+                        static_cast<unsigned>(timerCount), static_cast<unsigned>(kRounds), listMicros, wheelMicros);
+    }
+}
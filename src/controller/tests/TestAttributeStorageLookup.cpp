@@ -0,0 +1,178 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <pw_unit_test/framework.h>
+
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app/tests/AppTestContext.h>
+#include <app/util/DataModelHandler.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-config-api.h>
+#include <lib/core/StringBuilderAdapters.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+
+namespace {
+
+// Endpoint IDs that are equal modulo every power of two up to 0x1000, so that they all hash to the same slot of the
+// endpoint index and form a single probe sequence.
+constexpr EndpointId kCollidingEndpointIds[] = { 0x10E0, 0x20E0, 0x30E0, 0x40E0 };
+constexpr size_t kNumCollidingEndpoints =
+    std::min(ArraySize(kCollidingEndpointIds), static_cast<size_t>(CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT));
+
+constexpr AttributeId kTestAttribute1 = 1;
+constexpr AttributeId kTestAttribute2 = 2;
+
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(unitTestingAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(kTestAttribute1, INT8U, 1, 0), DECLARE_DYNAMIC_ATTRIBUTE(kTestAttribute2, INT8U, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(unitTestingClusters)
+DECLARE_DYNAMIC_CLUSTER(UnitTesting::Id, unitTestingAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(unitTestingEndpoint, unitTestingClusters);
+
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(identifyAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(kTestAttribute1, INT8U, 1, 0), DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(identifyClusters)
+DECLARE_DYNAMIC_CLUSTER(Identify::Id, identifyAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(identifyEndpoint, identifyClusters);
+
+class TestAttributeStorageLookup : public chip::Test::AppContext
+{
+protected:
+    static void ExpectUnitTestingEndpoint(EndpointId endpoint, uint16_t dynamicIndex)
+    {
+        EXPECT_EQ(emberAfGetDynamicIndexFromEndpoint(endpoint), dynamicIndex);
+        EXPECT_NE(emberAfIndexFromEndpoint(endpoint), kEmberInvalidEndpointIndex);
+        EXPECT_EQ(emberAfFindServerCluster(endpoint, UnitTesting::Id), &unitTestingClusters[0]);
+        EXPECT_EQ(emberAfLocateAttributeMetadata(endpoint, UnitTesting::Id, kTestAttribute2), &unitTestingAttrs[1]);
+    }
+
+    static void ExpectNoEndpoint(EndpointId endpoint)
+    {
+        EXPECT_EQ(emberAfGetDynamicIndexFromEndpoint(endpoint), kEmberInvalidEndpointIndex);
+        EXPECT_EQ(emberAfIndexFromEndpoint(endpoint), kEmberInvalidEndpointIndex);
+        EXPECT_EQ(emberAfFindServerCluster(endpoint, UnitTesting::Id), nullptr);
+        EXPECT_EQ(emberAfLocateAttributeMetadata(endpoint, UnitTesting::Id, kTestAttribute2), nullptr);
+    }
+};
+
+TEST_F(TestAttributeStorageLookup, TestCollidingDynamicEndpoints)
+{
+    InitDataModelHandler();
+
+    DataVersion dataVersionStorage[kNumCollidingEndpoints][ArraySize(unitTestingClusters)];
+
+    for (uint16_t i = 0; i < kNumCollidingEndpoints; i++)
+    {
+        EXPECT_EQ(emberAfSetDynamicEndpoint(i, kCollidingEndpointIds[i], &unitTestingEndpoint,
+                                            Span<DataVersion>(dataVersionStorage[i])),
+                  CHIP_NO_ERROR);
+    }
+    for (uint16_t i = 0; i < kNumCollidingEndpoints; i++)
+    {
+        ExpectUnitTestingEndpoint(kCollidingEndpointIds[i], i);
+    }
+
+    // Clearing the head of the probe sequence must keep the endpoints behind it reachable.
+    EXPECT_EQ(emberAfClearDynamicEndpoint(0), kCollidingEndpointIds[0]);
+    ExpectNoEndpoint(kCollidingEndpointIds[0]);
+    for (uint16_t i = 1; i < kNumCollidingEndpoints; i++)
+    {
+        ExpectUnitTestingEndpoint(kCollidingEndpointIds[i], i);
+    }
+
+    // And so must clearing one in the middle of it.
+    if (kNumCollidingEndpoints > 2)
+    {
+        EXPECT_EQ(emberAfClearDynamicEndpoint(1), kCollidingEndpointIds[1]);
+        ExpectNoEndpoint(kCollidingEndpointIds[1]);
+        for (uint16_t i = 2; i < kNumCollidingEndpoints; i++)
+        {
+            ExpectUnitTestingEndpoint(kCollidingEndpointIds[i], i);
+        }
+    }
+
+    // Endpoints added back go to the end of the probe sequence and are found again.
+    EXPECT_EQ(
+        emberAfSetDynamicEndpoint(0, kCollidingEndpointIds[0], &unitTestingEndpoint, Span<DataVersion>(dataVersionStorage[0])),
+        CHIP_NO_ERROR);
+    if (kNumCollidingEndpoints > 2)
+    {
+        EXPECT_EQ(
+            emberAfSetDynamicEndpoint(1, kCollidingEndpointIds[1], &unitTestingEndpoint, Span<DataVersion>(dataVersionStorage[1])),
+            CHIP_NO_ERROR);
+    }
+    for (uint16_t i = 0; i < kNumCollidingEndpoints; i++)
+    {
+        ExpectUnitTestingEndpoint(kCollidingEndpointIds[i], i);
+    }
+
+    for (uint16_t i = 0; i < kNumCollidingEndpoints; i++)
+    {
+        EXPECT_EQ(emberAfClearDynamicEndpoint(i), kCollidingEndpointIds[i]);
+    }
+    for (EndpointId endpoint : kCollidingEndpointIds)
+    {
+        ExpectNoEndpoint(endpoint);
+    }
+}
+
+TEST_F(TestAttributeStorageLookup, TestReplacedDynamicEndpointType)
+{
+    InitDataModelHandler();
+
+    constexpr EndpointId kEndpoint = kCollidingEndpointIds[0];
+    DataVersion dataVersionStorage[1];
+
+    // The same endpoint type object is reused with a different content, so the lookup caches keyed on its address must not
+    // return the metadata of its previous content.
+    EmberAfEndpointType replaceableEndpoint = unitTestingEndpoint;
+
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kEndpoint, &replaceableEndpoint, Span<DataVersion>(dataVersionStorage)), CHIP_NO_ERROR);
+    EXPECT_EQ(emberAfFindServerCluster(kEndpoint, UnitTesting::Id), &unitTestingClusters[0]);
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kEndpoint, UnitTesting::Id, kTestAttribute2), &unitTestingAttrs[1]);
+    EXPECT_EQ(emberAfClearDynamicEndpoint(0), kEndpoint);
+
+    replaceableEndpoint = identifyEndpoint;
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kEndpoint, &replaceableEndpoint, Span<DataVersion>(dataVersionStorage)), CHIP_NO_ERROR);
+    EXPECT_EQ(emberAfFindServerCluster(kEndpoint, UnitTesting::Id), nullptr);
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kEndpoint, UnitTesting::Id, kTestAttribute2), nullptr);
+    EXPECT_EQ(emberAfFindServerCluster(kEndpoint, Identify::Id), &identifyClusters[0]);
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kEndpoint, Identify::Id, kTestAttribute1), &identifyAttrs[0]);
+
+    // Going back to another endpoint type object is visible as well.
+    EXPECT_EQ(emberAfClearDynamicEndpoint(0), kEndpoint);
+    EXPECT_EQ(emberAfSetDynamicEndpoint(0, kEndpoint, &unitTestingEndpoint, Span<DataVersion>(dataVersionStorage)), CHIP_NO_ERROR);
+    EXPECT_EQ(emberAfFindServerCluster(kEndpoint, Identify::Id), nullptr);
+    EXPECT_EQ(emberAfLocateAttributeMetadata(kEndpoint, UnitTesting::Id, kTestAttribute1), &unitTestingAttrs[0]);
+
+    EXPECT_EQ(emberAfClearDynamicEndpoint(0), kEndpoint);
+    ExpectNoEndpoint(kEndpoint);
+}
+
+} // namespace
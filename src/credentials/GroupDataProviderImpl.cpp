@@ -22,6 +22,7 @@
 #include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/PersistentData.h>
 #include <lib/support/Pool.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <stdlib.h>
 
 namespace chip {
@@ -832,12 +833,24 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    ClearGroupSessionCache();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
 {
     VerifyOrDie(storage != nullptr);
     mStorage = storage;
+    InvalidateGroupSessionCache();
+}
+
+void GroupDataProviderImpl::SetGroupSessionCacheEnabled(bool enabled)
+{
+    mGroupSessionCacheEnabled = enabled;
+    if (!enabled && mGroupSessionsIterator.Allocated() == 0)
+    {
+        ClearGroupSessionCache();
+    }
+    InvalidateGroupSessionCache();
 }
 
 //
@@ -1349,6 +1362,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1429,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1462,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1539,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1594,6 +1611,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1695,6 +1713,8 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    InvalidateGroupSessionCache();
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1824,6 +1844,16 @@ CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::MessageDecrypt(const ByteSpan
                                    mEncryptionKey, nonce.data(), nonce.size(), output);
 }
 
+CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::MessageEncryptBatch(Crypto::AesCcmBatchEntry * entries, size_t count) const
+{
+    return Crypto::AES_CCM_encrypt_batch(entries, count, mEncryptionKey);
+}
+
+CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::MessageDecryptBatch(Crypto::AesCcmBatchEntry * entries, size_t count) const
+{
+    return Crypto::AES_CCM_decrypt_batch(entries, count, mEncryptionKey);
+}
+
 CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce,
                                                                   MutableByteSpan & output) const
 {
@@ -1839,12 +1869,106 @@ CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::PrivacyDecrypt(const ByteSpan
 GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGroupSessions(uint16_t session_id)
 {
     VerifyOrReturnError(IsInitialized(), nullptr);
-    return mGroupSessionsIterator.CreateObject(*this, session_id);
+
+    // Existing iterators may be reading the cache, so it is only replaced when there are none.
+    if (mGroupSessionCacheEnabled && !mGroupSessionCacheValid && mGroupSessionsIterator.Allocated() == 0)
+    {
+        CHIP_ERROR err = RebuildGroupSessionCache();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Crypto, "Failed to cache group session keys: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+
+    return mGroupSessionsIterator.CreateObject(*this, session_id, mGroupSessionCacheEnabled && mGroupSessionCacheValid);
 }
 
-GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
-    mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
+template <typename F>
+CHIP_ERROR GroupDataProviderImpl::ForEachStoredGroupSession(F && callback)
 {
+    FabricList fabric_list;
+    CHIP_ERROR err = fabric_list.Load(mStorage);
+    VerifyOrReturnError(CHIP_ERROR_NOT_FOUND != err, CHIP_NO_ERROR);
+    ReturnErrorOnFailure(err);
+
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        ReturnErrorOnFailure(fabric.Load(mStorage));
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            ReturnErrorOnFailure(mapping.Load(mStorage));
+
+            // Like GroupSessionIteratorImpl::Next(), stop at a mapping whose key set is missing.
+            KeySetData keyset;
+            VerifyOrReturnError(keyset.Find(mStorage, fabric, mapping.keyset_id), CHIP_NO_ERROR);
+            for (uint16_t k = 0; k < keyset.keys_count; ++k)
+            {
+                callback(fabric.fabric_index, mapping.group_id, keyset.policy, keyset.operational_keys[k]);
+            }
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR GroupDataProviderImpl::RebuildGroupSessionCache()
+{
+    ClearGroupSessionCache();
+
+    // Walk the stored sessions twice: once to size the cache, then to fill it, in the order in which the
+    // iterator would find them in storage.
+    size_t count = 0;
+    ReturnErrorOnFailure(ForEachStoredGroupSession(
+        [&count](FabricIndex, GroupId, SecurityPolicy, const Crypto::GroupOperationalCredentials &) { count++; }));
+
+    if (count > 0)
+    {
+        VerifyOrReturnError(mGroupSessionCache.Calloc(count), CHIP_ERROR_NO_MEMORY);
+    }
+
+    size_t index   = 0;
+    CHIP_ERROR err = ForEachStoredGroupSession([this, &index, count](FabricIndex fabric_index, GroupId group_id,
+                                                                     SecurityPolicy policy,
+                                                                     const Crypto::GroupOperationalCredentials & credentials) {
+        VerifyOrReturn(index < count);
+        GroupSessionCacheEntry & entry = mGroupSessionCache[index++];
+        entry.fabric_index             = fabric_index;
+        entry.group_id                 = group_id;
+        entry.security_policy          = policy;
+        entry.credentials              = credentials;
+    });
+    if (err != CHIP_NO_ERROR || index != count)
+    {
+        ClearGroupSessionCache();
+        return (err != CHIP_NO_ERROR) ? err : CHIP_ERROR_INTERNAL;
+    }
+
+    mGroupSessionCacheCount = count;
+    mGroupSessionCacheValid = true;
+    return CHIP_NO_ERROR;
+}
+
+void GroupDataProviderImpl::ClearGroupSessionCache()
+{
+    if (mGroupSessionCache)
+    {
+        Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(mGroupSessionCache.Get()),
+                                mGroupSessionCacheCount * sizeof(GroupSessionCacheEntry));
+    }
+    mGroupSessionCache.Free();
+    mGroupSessionCacheCount = 0;
+    mGroupSessionCacheValid = false;
+}
+
+GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id,
+                                                                          bool useCache) :
+    mProvider(provider), mUseCache(useCache), mSessionId(session_id), mGroupKeyContext(provider)
+{
+    VerifyOrReturn(!mUseCache);
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1857,6 +1981,19 @@ GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupD
 
 size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 {
+    if (mUseCache)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < mProvider.mGroupSessionCacheCount; i++)
+        {
+            if (mProvider.mGroupSessionCache[i].credentials.hash == mSessionId)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
     FabricData fabric(mFirstFabric);
     size_t count = 0;
 
@@ -1898,6 +2035,11 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+    if (mUseCache)
+    {
+        return NextFromCache(output);
+    }
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
@@ -1950,6 +2092,25 @@ bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output
     return false;
 }
 
+bool GroupDataProviderImpl::GroupSessionIteratorImpl::NextFromCache(GroupSession & output)
+{
+    while (mCacheIndex < mProvider.mGroupSessionCacheCount)
+    {
+        const GroupSessionCacheEntry & entry = mProvider.mGroupSessionCache[mCacheIndex++];
+        if (entry.credentials.hash == mSessionId)
+        {
+            mGroupKeyContext.Initialize(entry.credentials.encryption_key, mSessionId, entry.credentials.privacy_key);
+            output.fabric_index    = entry.fabric_index;
+            output.group_id        = entry.group_id;
+            output.security_policy = entry.security_policy;
+            output.keyContext      = &mGroupKeyContext;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void GroupDataProviderImpl::GroupSessionIteratorImpl::Release()
 {
     mGroupKeyContext.ReleaseKeys();
@@ -18,8 +18,10 @@
 
 #include <credentials/GroupDataProvider.h>
 #include <crypto/SessionKeystore.h>
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <lib/support/Pool.h>
+#include <lib/support/ScopedBuffer.h>
 
 namespace chip {
 namespace Credentials {
@@ -33,7 +35,7 @@ public:
     GroupDataProviderImpl(uint16_t maxGroupsPerFabric, uint16_t maxGroupKeysPerFabric) :
         GroupDataProvider(maxGroupsPerFabric, maxGroupKeysPerFabric)
     {}
-    ~GroupDataProviderImpl() override {}
+    ~GroupDataProviderImpl() override { ClearGroupSessionCache(); }
 
     /**
      * @brief Set the storage implementation used for non-volatile storage of configuration data.
@@ -49,6 +51,14 @@ public:
     CHIP_ERROR Init() override;
     void Finish() override;
 
+    /**
+     * @brief Keep the operational keys of all group sessions in RAM, so that IterateGroupSessions() does not
+     *        read the fabrics, group-key maps and key sets from storage for every incoming group message.
+     *        The copy is rebuilt on the next lookup after the group-key maps or key sets change.
+     *        Defaults to CHIP_CONFIG_GROUP_SESSION_CACHE. Disabling it releases the copy.
+     */
+    void SetGroupSessionCacheEnabled(bool enabled);
+
     //
     // Group Info
     //
@@ -193,6 +203,8 @@ protected:
                                   MutableByteSpan & ciphertext) const override;
         CHIP_ERROR MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad, const ByteSpan & nonce, const ByteSpan & mic,
                                   MutableByteSpan & plaintext) const override;
+        CHIP_ERROR MessageEncryptBatch(Crypto::AesCcmBatchEntry * entries, size_t count) const override;
+        CHIP_ERROR MessageDecryptBatch(Crypto::AesCcmBatchEntry * entries, size_t count) const override;
         CHIP_ERROR PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
         CHIP_ERROR PrivacyDecrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
 
@@ -221,16 +233,29 @@ protected:
         size_t mTotal       = 0;
     };
 
+    // Operational keys of a group session, as found in a key set mapped to a group.
+    struct GroupSessionCacheEntry
+    {
+        FabricIndex fabric_index       = kUndefinedFabricIndex;
+        GroupId group_id               = kUndefinedGroupId;
+        SecurityPolicy security_policy = SecurityPolicy::kCacheAndSync;
+        Crypto::GroupOperationalCredentials credentials;
+    };
+
     class GroupSessionIteratorImpl : public GroupSessionIterator
     {
     public:
-        GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id);
+        GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id, bool useCache);
         size_t Count() override;
         bool Next(GroupSession & output) override;
         void Release() override;
 
     protected:
+        bool NextFromCache(GroupSession & output);
+
         GroupDataProviderImpl & mProvider;
+        bool mUseCache           = false;
+        size_t mCacheIndex       = 0;
         uint16_t mSessionId      = 0;
         FabricIndex mFirstFabric = kUndefinedFabricIndex;
         FabricIndex mFabric      = kUndefinedFabricIndex;
@@ -246,6 +271,12 @@ protected:
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
 
+    void InvalidateGroupSessionCache() { mGroupSessionCacheValid = false; }
+    void ClearGroupSessionCache();
+    CHIP_ERROR RebuildGroupSessionCache();
+    template <typename F>
+    CHIP_ERROR ForEachStoredGroupSession(F && callback);
+
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
@@ -254,6 +285,11 @@ protected:
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+
+    Platform::ScopedMemoryBuffer<GroupSessionCacheEntry> mGroupSessionCache;
+    size_t mGroupSessionCacheCount = 0;
+    bool mGroupSessionCacheValid   = false;
+    bool mGroupSessionCacheEnabled = CHIP_CONFIG_GROUP_SESSION_CACHE;
 };
 
 } // namespace Credentials
@@ -16,10 +16,12 @@
  *    limitations under the License.
  */
 
+#include <algorithm>
 #include <set>
 #include <string.h>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <pw_unit_test/framework.h>
 
@@ -1222,6 +1224,129 @@ TEST_F(TestGroupDataProvider, TestGroupDecryption)
     it->Release();
 }
 
+size_t CountGroupSessions(GroupDataProvider * provider, uint16_t session_id)
+{
+    auto it = provider->IterateGroupSessions(session_id);
+    VerifyOrReturnValue(it != nullptr, 0);
+
+    GroupSession session;
+    size_t count = 0;
+    while (it->Next(session))
+    {
+        EXPECT_NE(session.keyContext, nullptr);
+        count++;
+    }
+    EXPECT_EQ(count, it->Count());
+    it->Release();
+    return count;
+}
+
+TEST_F(TestGroupDataProvider, TestGroupSessionCache)
+{
+    auto * provider = static_cast<GroupDataProviderImpl *>(GetGroupDataProvider());
+    ASSERT_NE(provider, nullptr);
+
+    // Reset test
+    ResetProvider(provider);
+    provider->SetGroupSessionCacheEnabled(true);
+
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric2, kGroup2);
+    ASSERT_NE(nullptr, key_context);
+    uint16_t session_id = key_context->GetKeyHash();
+    key_context->Release();
+
+    EXPECT_EQ(CountGroupSessions(provider, session_id), 1u);
+    EXPECT_EQ(CountGroupSessions(provider, session_id), 1u);
+
+    // Changes to the group-key map and key sets are seen by the next lookup.
+    EXPECT_EQ(provider->RemoveGroupKeyAt(kFabric2, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(CountGroupSessions(provider, session_id), 0u);
+
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(CountGroupSessions(provider, session_id), 1u);
+
+    EXPECT_EQ(provider->RemoveKeySet(kFabric2, kKeysetId1), CHIP_NO_ERROR);
+    EXPECT_EQ(CountGroupSessions(provider, session_id), 0u);
+
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(CountGroupSessions(provider, session_id), 1u);
+
+    // Without the cache, the sessions are read from storage.
+    provider->SetGroupSessionCacheEnabled(false);
+    EXPECT_EQ(CountGroupSessions(provider, session_id), 1u);
+    provider->SetGroupSessionCacheEnabled(true);
+
+    EXPECT_EQ(provider->RemoveFabric(kFabric2), CHIP_NO_ERROR);
+    EXPECT_EQ(CountGroupSessions(provider, session_id), 0u);
+
+    provider->SetGroupSessionCacheEnabled(CHIP_CONFIG_GROUP_SESSION_CACHE);
+}
+
+using GroupSessionInfo = std::tuple<FabricIndex, GroupId, SecurityPolicy>;
+
+std::vector<GroupSessionInfo> ListGroupSessions(GroupDataProvider * provider, uint16_t session_id)
+{
+    std::vector<GroupSessionInfo> sessions;
+    auto it = provider->IterateGroupSessions(session_id);
+    VerifyOrReturnValue(it != nullptr, sessions);
+
+    GroupSession session;
+    while (it->Next(session))
+    {
+        EXPECT_NE(session.keyContext, nullptr);
+        sessions.emplace_back(session.fabric_index, session.group_id, session.security_policy);
+    }
+    it->Release();
+    return sessions;
+}
+
+TEST_F(TestGroupDataProvider, TestGroupSessionCacheMatchesStorage)
+{
+    auto * provider = static_cast<GroupDataProviderImpl *>(GetGroupDataProvider());
+    ASSERT_NE(provider, nullptr);
+
+    // Reset test
+    ResetProvider(provider);
+
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet0), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet3), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset0), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 1, kGroup1Keyset2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 2, kGroup3Keyset0), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric1, 3, kGroup3Keyset2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 1, kGroup2Keyset3), CHIP_NO_ERROR);
+
+    for (auto [fabric, group] : { std::make_pair(kFabric1, kGroup1), std::make_pair(kFabric1, kGroup3),
+                                  std::make_pair(kFabric2, kGroup2) })
+    {
+        Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(fabric, group);
+        ASSERT_NE(nullptr, key_context);
+        uint16_t session_id = key_context->GetKeyHash();
+        key_context->Release();
+
+        provider->SetGroupSessionCacheEnabled(false);
+        const auto fromStorage = ListGroupSessions(provider, session_id);
+        auto isGroup = [fabric = fabric, group = group](const GroupSessionInfo & info) {
+            return std::get<0>(info) == fabric && std::get<1>(info) == group;
+        };
+        EXPECT_NE(std::find_if(fromStorage.begin(), fromStorage.end(), isGroup), fromStorage.end());
+
+        // The cache lists the same sessions, in the same order, on every lookup.
+        provider->SetGroupSessionCacheEnabled(true);
+        EXPECT_TRUE(ListGroupSessions(provider, session_id) == fromStorage);
+        EXPECT_TRUE(ListGroupSessions(provider, session_id) == fromStorage);
+    }
+
+    provider->SetGroupSessionCacheEnabled(CHIP_CONFIG_GROUP_SESSION_CACHE);
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
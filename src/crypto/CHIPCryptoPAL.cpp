@@ -785,6 +785,48 @@ CHIP_ERROR AES_CTR_crypt(const uint8_t * input, size_t input_length, const Aes12
     return AES_CCM_encrypt(input, input_length, nullptr, 0, key, nonce, nonce_length, output, tag, kTagLen);
 }
 
+#if !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+// Other backends do not cache cipher state in key handles.
+void ReleasePreparedKey(Symmetric128BitsKeyHandle & key) {}
+
+// Backends without a batch-aware implementation process the messages one at a time.
+CHIP_ERROR AES_CCM_encrypt_batch(AesCcmBatchEntry * entries, size_t count, const Aes128KeyHandle & key)
+{
+    VerifyOrReturnError(entries != nullptr || count == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    for (size_t i = 0; i < count; i++)
+    {
+        AesCcmBatchEntry & entry = entries[i];
+        entry.result = AES_CCM_encrypt(entry.input, entry.input_length, entry.aad, entry.aad_length, key, entry.nonce,
+                                       entry.nonce_length, entry.output, entry.tag, entry.tag_length);
+        if (error == CHIP_NO_ERROR)
+        {
+            error = entry.result;
+        }
+    }
+    return error;
+}
+
+CHIP_ERROR AES_CCM_decrypt_batch(AesCcmBatchEntry * entries, size_t count, const Aes128KeyHandle & key)
+{
+    VerifyOrReturnError(entries != nullptr || count == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    for (size_t i = 0; i < count; i++)
+    {
+        AesCcmBatchEntry & entry = entries[i];
+        entry.result = AES_CCM_decrypt(entry.input, entry.input_length, entry.aad, entry.aad_length, entry.tag, entry.tag_length,
+                                       key, entry.nonce, entry.nonce_length, entry.output);
+        if (error == CHIP_NO_ERROR)
+        {
+            error = entry.result;
+        }
+    }
+    return error;
+}
+#endif // !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+
 CHIP_ERROR GenerateCompressedFabricId(const Crypto::P256PublicKey & root_public_key, uint64_t fabric_id,
                                       MutableByteSpan & out_compressed_fabric_id)
 {
@@ -39,6 +39,10 @@
 #include <stddef.h>
 #include <string.h>
 
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+#include <atomic>
+#endif
+
 namespace chip {
 namespace Crypto {
 
@@ -644,11 +648,36 @@ private:
 
 using Symmetric128BitsKeyByteArray = uint8_t[CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES];
 
+class Symmetric128BitsKeyHandle;
+
+/**
+ * @brief Free the cipher state that the crypto backend may have prepared for a key and cached in its handle.
+ *
+ * Session keystores call this when they destroy a key. It does nothing on backends that do not cache such state.
+ */
+void ReleasePreparedKey(Symmetric128BitsKeyHandle & key);
+
 /**
  * @brief Platform-specific 128-bit symmetric key handle
  */
 class Symmetric128BitsKeyHandle : public SymmetricKeyHandle<CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES>
 {
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+public:
+    ~Symmetric128BitsKeyHandle() { ReleasePreparedKey(*this); }
+
+    /**
+     * @brief Cipher state prepared from the key by the crypto backend, such as a cipher context holding the key
+     *        schedule, so that it is not set up again for every message. Owned by the backend; null if none.
+     *
+     * Users take the state out of the handle for the duration of an operation, so the handle can be used from
+     * several threads at once.
+     */
+    std::atomic<void *> & PreparedState() const { return mPreparedState; }
+
+private:
+    mutable std::atomic<void *> mPreparedState{ nullptr };
+#endif // CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
 };
 
 /**
@@ -786,6 +815,56 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext);
 
+/**
+ * @brief One message of an AES-CCM batch operation.
+ *
+ * The fields have the same meaning and constraints as the corresponding arguments of
+ * AES_CCM_encrypt() and AES_CCM_decrypt(): `input` is the plaintext when encrypting and the
+ * ciphertext when decrypting, and `tag` is written when encrypting and read when decrypting.
+ */
+struct AesCcmBatchEntry
+{
+    const uint8_t * input = nullptr;
+    size_t input_length   = 0;
+    const uint8_t * aad   = nullptr;
+    size_t aad_length     = 0;
+    const uint8_t * nonce = nullptr;
+    size_t nonce_length   = 0;
+    uint8_t * output      = nullptr;
+    uint8_t * tag         = nullptr;
+    size_t tag_length     = 0;
+
+    /// Set by the batch operation to the result of processing this message.
+    CHIP_ERROR result = CHIP_NO_ERROR;
+};
+
+/**
+ * @brief Encrypt a batch of messages with the same key.
+ *
+ * Equivalent to calling AES_CCM_encrypt() for each entry, but lets the crypto backend set up
+ * the key schedule and cipher context once for the whole batch. Every entry is processed, even
+ * if an earlier one failed.
+ *
+ * @param entries Messages to encrypt. The `result` of each entry is set.
+ * @param count Number of entries
+ * @param key Encryption key
+ * @return CHIP_NO_ERROR if every message was encrypted, otherwise the first failure
+ */
+CHIP_ERROR AES_CCM_encrypt_batch(AesCcmBatchEntry * entries, size_t count, const Aes128KeyHandle & key);
+
+/**
+ * @brief Decrypt a batch of messages with the same key.
+ *
+ * Equivalent to calling AES_CCM_decrypt() for each entry; see AES_CCM_encrypt_batch(). A message
+ * that fails authentication does not prevent the others from being decrypted.
+ *
+ * @param entries Messages to decrypt. The `result` of each entry is set.
+ * @param count Number of entries
+ * @param key Decryption key
+ * @return CHIP_NO_ERROR if every message was decrypted, otherwise the first failure
+ */
+CHIP_ERROR AES_CCM_decrypt_batch(AesCcmBatchEntry * entries, size_t count, const Aes128KeyHandle & key);
+
 /**
  * @brief A function that implements AES-CTR encryption/decryption
  *
@@ -1845,6 +1924,46 @@ public:
     virtual CHIP_ERROR MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad, const ByteSpan & nonce,
                                       const ByteSpan & mic, MutableByteSpan & plaintext) const = 0;
 
+    /**
+     * @brief Perform MessageEncrypt() for a batch of messages, as AES_CCM_encrypt_batch() does with a raw key.
+     *
+     * The default implementation encrypts the messages one at a time.
+     */
+    virtual CHIP_ERROR MessageEncryptBatch(AesCcmBatchEntry * entries, size_t count) const
+    {
+        CHIP_ERROR error = CHIP_NO_ERROR;
+        for (size_t i = 0; i < count; i++)
+        {
+            AesCcmBatchEntry & entry = entries[i];
+            MutableByteSpan mic(entry.tag, entry.tag_length);
+            MutableByteSpan ciphertext(entry.output, entry.input_length);
+            entry.result = MessageEncrypt(ByteSpan(entry.input, entry.input_length), ByteSpan(entry.aad, entry.aad_length),
+                                          ByteSpan(entry.nonce, entry.nonce_length), mic, ciphertext);
+            error        = (error == CHIP_NO_ERROR) ? entry.result : error;
+        }
+        return error;
+    }
+
+    /**
+     * @brief Perform MessageDecrypt() for a batch of messages, as AES_CCM_decrypt_batch() does with a raw key.
+     *
+     * The default implementation decrypts the messages one at a time.
+     */
+    virtual CHIP_ERROR MessageDecryptBatch(AesCcmBatchEntry * entries, size_t count) const
+    {
+        CHIP_ERROR error = CHIP_NO_ERROR;
+        for (size_t i = 0; i < count; i++)
+        {
+            AesCcmBatchEntry & entry = entries[i];
+            MutableByteSpan plaintext(entry.output, entry.input_length);
+            entry.result = MessageDecrypt(ByteSpan(entry.input, entry.input_length), ByteSpan(entry.aad, entry.aad_length),
+                                          ByteSpan(entry.nonce, entry.nonce_length), ByteSpan(entry.tag, entry.tag_length),
+                                          plaintext);
+            error        = (error == CHIP_NO_ERROR) ? entry.result : error;
+        }
+        return error;
+    }
+
     /**
      * @brief Perform privacy encoding as described in 4.8.2. (Privacy Processing of Outgoing Messages)
      * @param[in] input         Message header to privacy encrypt
@@ -48,6 +48,7 @@
 #include <lib/support/BufferWriter.h>
 #include <lib/support/BytesToHex.h>
 #include <lib/support/CHIPArgParser.hpp>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/SafePointerCast.h>
@@ -146,269 +147,329 @@ static int _compareDaysAndSeconds(const int days, const int seconds)
     return 0;
 }
 
-CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
-                           const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
-                           uint8_t * tag, size_t tag_length)
+namespace {
+
+// AES-CCM state prepared for a key and cached in its handle (see Symmetric128BitsKeyHandle::PreparedState()), so that
+// successive messages under the same key only set their nonce instead of building a new context and key schedule.
+struct PreparedAesCcmKey
 {
+    // The key the context was set up with, to notice a handle that has since been given another key.
+    Symmetric128BitsKeyByteArray mKey = {};
+    size_t mNonceLength               = 0;
+    size_t mTagLength                 = 0; // 0 until the context is set up
+    bool mEncrypt                     = false;
 #if CHIP_CRYPTO_BORINGSSL
-    EVP_AEAD_CTX * context = nullptr;
-    size_t written_tag_len = 0;
-    const EVP_AEAD * aead  = nullptr;
+    EVP_AEAD_CTX * mContext = nullptr;
 #else
-    EVP_CIPHER_CTX * context = nullptr;
-    int bytesWritten         = 0;
-    size_t ciphertext_length = 0;
-    const EVP_CIPHER * type  = nullptr;
-#endif
-    CHIP_ERROR error = CHIP_NO_ERROR;
-    int result       = 1;
+    EVP_CIPHER_CTX * mContext = nullptr;
+#endif // CHIP_CRYPTO_BORINGSSL
+};
 
-    // Placeholder location for avoiding null params for plaintexts when
-    // size is zero.
-    uint8_t placeholder_empty_plaintext = 0;
+void FreePreparedAesCcmKey(PreparedAesCcmKey * state)
+{
+    if (state->mContext != nullptr)
+    {
+#if CHIP_CRYPTO_BORINGSSL
+        EVP_AEAD_CTX_free(state->mContext);
+#else
+        EVP_CIPHER_CTX_free(state->mContext);
+#endif // CHIP_CRYPTO_BORINGSSL
+    }
+    ClearSecretData(state->mKey);
+    Platform::Delete(state);
+}
 
-    // Ciphertext block to hold a finalized ciphertext block if output
-    // `ciphertext` buffer is nullptr or plaintext_length is zero (i.e.
-    // we are only doing auth and don't care about output).
-    uint8_t placeholder_ciphertext[kAES_CCM128_Block_Length];
-    bool ciphertext_was_null = (ciphertext == nullptr);
+// Encrypts or decrypts messages with the prepared state of a key.
+//
+// The state is taken out of the handle for the lifetime of the cipher and put back afterwards, so that a key used from
+// several threads at once never has its context shared: a thread that finds the slot empty prepares a state of its own.
+class AesCcmCipher
+{
+public:
+    AesCcmCipher(const Aes128KeyHandle & key, bool encrypt) :
+        mKey(key), mEncrypt(encrypt), mState(static_cast<PreparedAesCcmKey *>(key.PreparedState().exchange(nullptr)))
+    {}
 
-    if (plaintext_length == 0)
+    ~AesCcmCipher()
     {
-        if (plaintext == nullptr)
+        void * expected = nullptr;
+        if (mState != nullptr && !mKey.PreparedState().compare_exchange_strong(expected, mState))
         {
-            plaintext = &placeholder_empty_plaintext;
+            // Another thread cached its state in the meantime; keep only one.
+            FreePreparedAesCcmKey(mState);
         }
-        // Make sure we have at least 1 full block size buffer for the
-        // extraction of final block (required by OpenSSL EVP_EncryptFinal_ex)
-        if (ciphertext_was_null)
+    }
+
+    CHIP_ERROR Process(const AesCcmBatchEntry & entry)
+    {
+        AesCcmBatchEntry message = entry;
+
+        // Placeholders for authentication-only messages, so that the backend is never given null buffers. The output
+        // one must hold a full block for the final block extracted by EVP_EncryptFinal_ex.
+        uint8_t placeholder_input = 0;
+        uint8_t placeholder_output[kAES_CCM128_Block_Length];
+
+        if (message.input_length == 0)
         {
-            ciphertext = &placeholder_ciphertext[0];
+            // An encryption that only authenticates does not produce output.
+            VerifyOrReturnError(!mEncrypt || message.output == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+            if (message.input == nullptr)
+            {
+                message.input = &placeholder_input;
+            }
+            if (message.output == nullptr)
+            {
+                message.output = &placeholder_output[0];
+            }
         }
-    }
 
-    VerifyOrExit((plaintext_length != 0) || ciphertext_was_null, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(plaintext != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(ciphertext != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(nonce != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(nonce_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(tag != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(message.input != nullptr && message.output != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(message.nonce != nullptr && message.nonce_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(message.tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 #if CHIP_CRYPTO_BORINGSSL
-    VerifyOrExit(tag_length == CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES, error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(message.tag_length == CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES, CHIP_ERROR_INVALID_ARGUMENT);
 #else
-    VerifyOrExit(tag_length == 8 || tag_length == 12 || tag_length == CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES,
-                              error = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(message.tag_length == 8 || message.tag_length == 12 ||
+                                message.tag_length == CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES,
+                            CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(CanCastTo<int>(message.nonce_length) && CanCastTo<int>(message.input_length) &&
+                                CanCastTo<int>(message.aad_length),
+                            CHIP_ERROR_INVALID_ARGUMENT);
 #endif // CHIP_CRYPTO_BORINGSSL
 
-#if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
+        ReturnErrorOnFailure(Prepare(message.nonce_length, message.tag_length));
 
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        CHIP_ERROR error = mEncrypt ? Encrypt(message) : Decrypt(message);
+        if (error != CHIP_NO_ERROR)
+        {
+            // Do not rely on the state of a context after a failed operation; set it up from scratch for the next message.
+            mState->mTagLength = 0;
+        }
+        return error;
+    }
 
-    result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
-                                       plaintext_length, nullptr, 0, aad, aad_length);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-    VerifyOrExit(written_tag_len == tag_length, error = CHIP_ERROR_INTERNAL);
+private:
+    bool IsPrepared(size_t nonce_length, size_t tag_length) const
+    {
+        if (mState->mTagLength != tag_length ||
+            !IsBufferContentEqualConstantTime(mState->mKey, mKey.As<Symmetric128BitsKeyByteArray>(), sizeof(mState->mKey)))
+        {
+            return false;
+        }
+#if CHIP_CRYPTO_BORINGSSL
+        // The nonce and the direction are given to each operation.
+        return true;
 #else
+        return mState->mNonceLength == nonce_length && mState->mEncrypt == mEncrypt;
+#endif // CHIP_CRYPTO_BORINGSSL
+    }
 
-    type = EVP_aes_128_ccm();
+    // Sets up the context for the key, direction, nonce and tag lengths, unless it already is.
+    CHIP_ERROR Prepare(size_t nonce_length, size_t tag_length)
+    {
+        if (mState == nullptr)
+        {
+            mState = Platform::New<PreparedAesCcmKey>();
+            VerifyOrReturnError(mState != nullptr, CHIP_ERROR_NO_MEMORY);
+        }
+        else if (IsPrepared(nonce_length, tag_length))
+        {
+            return CHIP_NO_ERROR;
+        }
+        mState->mTagLength = 0;
 
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
+        const Symmetric128BitsKeyByteArray & key = mKey.As<Symmetric128BitsKeyByteArray>();
 
-    // Pass in cipher
-    result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+#if CHIP_CRYPTO_BORINGSSL
+        // The nonce is passed with each operation, so only the key and the tag length are bound to the context.
+        if (mState->mContext != nullptr)
+        {
+            EVP_AEAD_CTX_free(mState->mContext);
+        }
+        mState->mContext = EVP_AEAD_CTX_new(EVP_aead_aes_128_ccm_matter(), key, sizeof(key), tag_length);
+        VerifyOrReturnError(mState->mContext != nullptr, CHIP_ERROR_NO_MEMORY);
+#else
+        if (mState->mContext == nullptr)
+        {
+            mState->mContext = EVP_CIPHER_CTX_new();
+            VerifyOrReturnError(mState->mContext != nullptr, CHIP_ERROR_NO_MEMORY);
+        }
 
-    // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        const int enc = mEncrypt ? 1 : 0;
+        int result    = EVP_CipherInit_ex(mState->mContext, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, enc);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 
-    // Pass in tag length. Cast is safe because we checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // The nonce and tag lengths must be set before the key, which fixes them for the following operations.
+        result = EVP_CIPHER_CTX_ctrl(mState->mContext, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+        result = EVP_CIPHER_CTX_ctrl(mState->mContext, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_EncryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        result = EVP_CipherInit_ex(mState->mContext, nullptr, nullptr, key, nullptr, enc);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+#endif // CHIP_CRYPTO_BORINGSSL
 
-    // Pass in plain text length
-    VerifyOrExit(CanCastTo<int>(plaintext_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, nullptr, static_cast<int>(plaintext_length));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        memcpy(mState->mKey, key, sizeof(mState->mKey));
+        mState->mNonceLength = nonce_length;
+        mState->mEncrypt     = mEncrypt;
+        mState->mTagLength   = tag_length;
+        return CHIP_NO_ERROR;
+    }
 
-    // Pass in AAD
-    if (aad_length > 0 && aad != nullptr)
+    CHIP_ERROR Encrypt(const AesCcmBatchEntry & message)
     {
-        VerifyOrExit(CanCastTo<int>(aad_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-        result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, Uint8::to_const_uchar(aad), static_cast<int>(aad_length));
-        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-    }
+#if CHIP_CRYPTO_BORINGSSL
+        size_t written_tag_len = 0;
+        int result = EVP_AEAD_CTX_seal_scatter(mState->mContext, message.output, message.tag, &written_tag_len, message.tag_length,
+                                               message.nonce, message.nonce_length, message.input, message.input_length, nullptr,
+                                               0, message.aad, message.aad_length);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+        VerifyOrReturnError(written_tag_len == message.tag_length, CHIP_ERROR_INTERNAL);
+#else
+        EVP_CIPHER_CTX * context = mState->mContext;
+        int bytesWritten         = 0;
 
-    // Encrypt
-    VerifyOrExit(CanCastTo<int>(plaintext_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_EncryptUpdate(context, Uint8::to_uchar(ciphertext), &bytesWritten, Uint8::to_const_uchar(plaintext),
-                                            static_cast<int>(plaintext_length));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-    VerifyOrExit((ciphertext_was_null && bytesWritten == 0) || (bytesWritten >= 0), error = CHIP_ERROR_INTERNAL);
-    ciphertext_length = static_cast<unsigned int>(bytesWritten);
+        int result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(message.nonce));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 
-    // Finalize encryption
-    result = EVP_EncryptFinal_ex(context, ciphertext + ciphertext_length, &bytesWritten);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-    VerifyOrExit(bytesWritten >= 0 && bytesWritten <= static_cast<int>(plaintext_length), error = CHIP_ERROR_INTERNAL);
+        result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, nullptr, static_cast<int>(message.input_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 
-    // Get tag
-    VerifyOrExit(CanCastTo<int>(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_GET_TAG, static_cast<int>(tag_length), Uint8::to_uchar(tag));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-#endif // CHIP_CRYPTO_BORINGSSL
+        if (message.aad_length > 0 && message.aad != nullptr)
+        {
+            result = EVP_EncryptUpdate(context, nullptr, &bytesWritten, Uint8::to_const_uchar(message.aad),
+                                       static_cast<int>(message.aad_length));
+            VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+        }
 
-exit:
-    if (context != nullptr)
-    {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
+        result = EVP_EncryptUpdate(context, Uint8::to_uchar(message.output), &bytesWritten, Uint8::to_const_uchar(message.input),
+                                   static_cast<int>(message.input_length));
+        VerifyOrReturnError(result == 1 && bytesWritten >= 0, CHIP_ERROR_INTERNAL);
+
+        result = EVP_EncryptFinal_ex(context, message.output + bytesWritten, &bytesWritten);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_GET_TAG, static_cast<int>(message.tag_length),
+                                     Uint8::to_uchar(message.tag));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 #endif // CHIP_CRYPTO_BORINGSSL
-        context = nullptr;
+        return CHIP_NO_ERROR;
     }
 
-    return error;
-}
-
-CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
-                           const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
-                           size_t nonce_length, uint8_t * plaintext)
-{
+    CHIP_ERROR Decrypt(const AesCcmBatchEntry & message)
+    {
 #if CHIP_CRYPTO_BORINGSSL
-    EVP_AEAD_CTX * context = nullptr;
-    const EVP_AEAD * aead  = nullptr;
+        int result = EVP_AEAD_CTX_open_gather(mState->mContext, message.output, message.nonce, message.nonce_length, message.input,
+                                              message.input_length, message.tag, message.tag_length, message.aad,
+                                              message.aad_length);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 #else
+        EVP_CIPHER_CTX * context = mState->mContext;
+        int bytesOutput          = 0;
 
-    EVP_CIPHER_CTX * context = nullptr;
-    int bytesOutput          = 0;
-    const EVP_CIPHER * type  = nullptr;
-#endif // CHIP_CRYPTO_BORINGSSL
-    CHIP_ERROR error = CHIP_NO_ERROR;
-    int result       = 1;
+        int result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(message.tag_length), message.tag);
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 
-    // Placeholder location for avoiding null params for ciphertext when
-    // size is zero.
-    uint8_t placeholder_empty_ciphertext = 0;
+        result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(message.nonce));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 
-    // Plaintext block to hold a finalized plaintext block if output
-    // `plaintext` buffer is nullptr or ciphertext_length is zero (i.e.
-    // we are only doing auth and don't care about output).
-    uint8_t placeholder_plaintext[kAES_CCM128_Block_Length];
-    bool plaintext_was_null = (plaintext == nullptr);
+        result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, nullptr, static_cast<int>(message.input_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 
-    if (ciphertext_length == 0)
-    {
-        if (ciphertext == nullptr)
-        {
-            ciphertext = &placeholder_empty_ciphertext;
-        }
-        // Make sure we have at least 1 full block size buffer for the
-        // extraction of final block (required by OpenSSL EVP_DecryptFinal_ex)
-        if (plaintext_was_null)
+        if (message.aad_length > 0 && message.aad != nullptr)
         {
-            plaintext = &placeholder_plaintext[0];
+            result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, Uint8::to_const_uchar(message.aad),
+                                       static_cast<int>(message.aad_length));
+            VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
         }
-    }
 
-    VerifyOrExit(ciphertext != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(plaintext != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(tag != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-#if CHIP_CRYPTO_BORINGSSL
-    VerifyOrExit(tag_length == CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES, error = CHIP_ERROR_INVALID_ARGUMENT);
-#else
-    VerifyOrExit(tag_length == 8 || tag_length == 12 || tag_length == CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES,
-                              error = CHIP_ERROR_INVALID_ARGUMENT);
+        // Fails if the tag does not match.
+        result = EVP_DecryptUpdate(context, Uint8::to_uchar(message.output), &bytesOutput, Uint8::to_const_uchar(message.input),
+                                   static_cast<int>(message.input_length));
+        VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
 #endif // CHIP_CRYPTO_BORINGSSL
-    VerifyOrExit(nonce != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(nonce_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-#if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
+        return CHIP_NO_ERROR;
+    }
 
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    const Aes128KeyHandle & mKey;
+    const bool mEncrypt;
+    PreparedAesCcmKey * mState;
+};
 
-    result = EVP_AEAD_CTX_open_gather(context, plaintext, nonce, nonce_length, ciphertext, ciphertext_length, tag, tag_length, aad,
-                                      aad_length);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-#else
-    type = EVP_aes_128_ccm();
+CHIP_ERROR AES_CCM_process_batch(AesCcmBatchEntry * entries, size_t count, const Aes128KeyHandle & key, bool encrypt)
+{
+    VerifyOrReturnError(entries != nullptr || count == 0, CHIP_ERROR_INVALID_ARGUMENT);
 
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    AesCcmCipher cipher(key, encrypt);
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    for (size_t i = 0; i < count; i++)
+    {
+        entries[i].result = cipher.Process(entries[i]);
+        if (error == CHIP_NO_ERROR)
+        {
+            error = entries[i].result;
+        }
+    }
+    return error;
+}
 
-    // Pass in cipher
-    result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+} // namespace
 
-    // Pass in nonce length
-    VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                           const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
+                           uint8_t * tag, size_t tag_length)
+{
+    AesCcmBatchEntry message;
+    message.input        = plaintext;
+    message.input_length = plaintext_length;
+    message.aad          = aad;
+    message.aad_length   = aad_length;
+    message.nonce        = nonce;
+    message.nonce_length = nonce_length;
+    message.output       = ciphertext;
+    message.tag          = tag;
+    message.tag_length   = tag_length;
 
-    // Pass in expected tag
-    // Removing "const" from |tag| here should hopefully be safe as
-    // we're writing the tag, not reading.
-    VerifyOrExit(CanCastTo<int>(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
-                                              const_cast<void *>(static_cast<const void *>(tag)));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    return AesCcmCipher(key, true /* encrypt */).Process(message);
+}
 
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_DecryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                           const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
+                           size_t nonce_length, uint8_t * plaintext)
+{
+    AesCcmBatchEntry message;
+    message.input        = ciphertext;
+    message.input_length = ciphertext_length;
+    message.aad          = aad;
+    message.aad_length   = aad_length;
+    message.nonce        = nonce;
+    message.nonce_length = nonce_length;
+    message.output       = plaintext;
+    // The expected tag is only read when decrypting.
+    message.tag        = const_cast<uint8_t *>(tag);
+    message.tag_length = tag_length;
 
-    // Pass in cipher text length
-    VerifyOrExit(CanCastTo<int>(ciphertext_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, nullptr, static_cast<int>(ciphertext_length));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-    VerifyOrExit(bytesOutput <= static_cast<int>(ciphertext_length), error = CHIP_ERROR_INTERNAL);
+    return AesCcmCipher(key, false /* encrypt */).Process(message);
+}
 
-    // Pass in aad
-    if (aad_length > 0 && aad != nullptr)
-    {
-        VerifyOrExit(CanCastTo<int>(aad_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-        result = EVP_DecryptUpdate(context, nullptr, &bytesOutput, Uint8::to_const_uchar(aad), static_cast<int>(aad_length));
-        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-        VerifyOrExit(bytesOutput <= static_cast<int>(aad_length), error = CHIP_ERROR_INTERNAL);
-    }
+CHIP_ERROR AES_CCM_encrypt_batch(AesCcmBatchEntry * entries, size_t count, const Aes128KeyHandle & key)
+{
+    return AES_CCM_process_batch(entries, count, key, true /* encrypt */);
+}
 
-    // Pass in ciphertext. We wont get anything if validation fails.
-    VerifyOrExit(CanCastTo<int>(ciphertext_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_DecryptUpdate(context, Uint8::to_uchar(plaintext), &bytesOutput, Uint8::to_const_uchar(ciphertext),
-                                            static_cast<int>(ciphertext_length));
-    if (plaintext_was_null)
-    {
-        VerifyOrExit(bytesOutput <= static_cast<int>(sizeof(placeholder_plaintext)), error = CHIP_ERROR_INTERNAL);
-    }
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-#endif // CHIP_CRYPTO_BORINGSSL
+CHIP_ERROR AES_CCM_decrypt_batch(AesCcmBatchEntry * entries, size_t count, const Aes128KeyHandle & key)
+{
+    return AES_CCM_process_batch(entries, count, key, false /* encrypt */);
+}
 
-exit:
-    if (context != nullptr)
+void ReleasePreparedKey(Symmetric128BitsKeyHandle & key)
+{
+    auto * state = static_cast<PreparedAesCcmKey *>(key.PreparedState().exchange(nullptr));
+    if (state != nullptr)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
-
-        context = nullptr;
+        FreePreparedAesCcmKey(state);
     }
-
-    return error;
 }
 
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
@@ -95,6 +95,7 @@ CHIP_ERROR RawKeySessionKeystore::DeriveSessionKeys(const HkdfKeyHandle & hkdfKe
 
 void RawKeySessionKeystore::DestroyKey(Symmetric128BitsKeyHandle & key)
 {
+    ReleasePreparedKey(key);
     ClearSecretData(key.AsMutable<Symmetric128BitsKeyByteArray>());
 }
 
@@ -0,0 +1,343 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the AES-CCM batch API, including a comparison of
+ *      batched and per-message encryption and decryption.
+ */
+
+#include "AES_CCM_128_test_vectors.h"
+
+#include <string.h>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#if CHIP_CRYPTO_PSA
+#include <psa/crypto.h>
+#endif
+
+using namespace chip;
+using namespace chip::Crypto;
+
+namespace {
+
+constexpr size_t kBatchCopies = 3;
+
+class TestAesCcmBatch : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
+#if CHIP_CRYPTO_PSA
+        psa_crypto_init();
+#endif
+    }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+struct TestAesKey
+{
+    TestAesKey(const uint8_t * keyBytes, size_t keyLength)
+    {
+        Symmetric128BitsKeyByteArray keyMaterial;
+        memcpy(&keyMaterial, keyBytes, keyLength);
+        EXPECT_EQ(keystore.CreateKey(keyMaterial, key), CHIP_NO_ERROR);
+    }
+
+    ~TestAesKey() { keystore.DestroyKey(key); }
+
+    DefaultSessionKeystore keystore;
+    Aes128KeyHandle key;
+};
+
+} // namespace
+
+TEST_F(TestAesCcmBatch, TestEncryptBatchTestVectors)
+{
+    int numOfTestsRan = 0;
+    for (const ccm_128_test_vector * vector : ccm_128_test_vectors)
+    {
+        if (vector->pt_len == 0)
+        {
+            continue;
+        }
+        numOfTestsRan++;
+
+        TestAesKey key(vector->key, vector->key_len);
+        std::vector<uint8_t> ciphertexts[kBatchCopies];
+        std::vector<uint8_t> tags[kBatchCopies];
+        AesCcmBatchEntry entries[kBatchCopies];
+
+        // The same message several times, so the cipher context is reused within the batch.
+        for (size_t i = 0; i < kBatchCopies; i++)
+        {
+            ciphertexts[i].resize(vector->ct_len);
+            tags[i].resize(vector->tag_len);
+            entries[i].input        = vector->pt;
+            entries[i].input_length = vector->pt_len;
+            entries[i].aad          = vector->aad;
+            entries[i].aad_length   = vector->aad_len;
+            entries[i].nonce        = vector->nonce;
+            entries[i].nonce_length = vector->nonce_len;
+            entries[i].output       = ciphertexts[i].data();
+            entries[i].tag          = tags[i].data();
+            entries[i].tag_length   = vector->tag_len;
+        }
+
+        EXPECT_EQ(AES_CCM_encrypt_batch(entries, kBatchCopies, key.key), vector->result);
+        for (size_t i = 0; i < kBatchCopies; i++)
+        {
+            EXPECT_EQ(entries[i].result, vector->result);
+            if (vector->result == CHIP_NO_ERROR)
+            {
+                EXPECT_EQ(memcmp(ciphertexts[i].data(), vector->ct, vector->ct_len), 0);
+                EXPECT_EQ(memcmp(tags[i].data(), vector->tag, vector->tag_len), 0);
+            }
+        }
+    }
+    EXPECT_GT(numOfTestsRan, 0);
+}
+
+TEST_F(TestAesCcmBatch, TestDecryptBatchTestVectors)
+{
+    int numOfTestsRan = 0;
+    for (const ccm_128_test_vector * vector : ccm_128_test_vectors)
+    {
+        if (vector->pt_len == 0 || vector->result != CHIP_NO_ERROR)
+        {
+            continue;
+        }
+        numOfTestsRan++;
+
+        TestAesKey key(vector->key, vector->key_len);
+        std::vector<uint8_t> plaintexts[kBatchCopies];
+        std::vector<uint8_t> tags[kBatchCopies];
+        AesCcmBatchEntry entries[kBatchCopies];
+
+        for (size_t i = 0; i < kBatchCopies; i++)
+        {
+            plaintexts[i].resize(vector->pt_len);
+            tags[i].assign(vector->tag, vector->tag + vector->tag_len);
+            entries[i].input        = vector->ct;
+            entries[i].input_length = vector->ct_len;
+            entries[i].aad          = vector->aad;
+            entries[i].aad_length   = vector->aad_len;
+            entries[i].nonce        = vector->nonce;
+            entries[i].nonce_length = vector->nonce_len;
+            entries[i].output       = plaintexts[i].data();
+            entries[i].tag          = tags[i].data();
+            entries[i].tag_length   = vector->tag_len;
+        }
+
+        // A message that fails authentication in the middle of the batch does not affect the others.
+        tags[1][0] ^= 0x01;
+
+        EXPECT_NE(AES_CCM_decrypt_batch(entries, kBatchCopies, key.key), CHIP_NO_ERROR);
+        for (size_t i = 0; i < kBatchCopies; i++)
+        {
+            if (i == 1)
+            {
+                EXPECT_NE(entries[i].result, CHIP_NO_ERROR);
+                continue;
+            }
+            EXPECT_EQ(entries[i].result, CHIP_NO_ERROR);
+            EXPECT_EQ(memcmp(plaintexts[i].data(), vector->pt, vector->pt_len), 0);
+        }
+    }
+    EXPECT_GT(numOfTestsRan, 0);
+}
+
+TEST_F(TestAesCcmBatch, TestBatchMixedLengths)
+{
+    const uint8_t keyBytes[kAES_CCM128_Key_Length] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                                       0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    const uint8_t nonce[CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+                                                                 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c };
+    const uint8_t aad[] = { 0x20, 0x21, 0x22, 0x23 };
+    uint8_t plaintext[100];
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = static_cast<uint8_t>(i);
+    }
+
+    // Nonce and tag lengths that change from one message to the next.
+    const size_t nonceLengths[] = { 13, 13, 8, 13, 12 };
+    const size_t tagLengths[]   = { 16, 8, 16, 16, 16 };
+    constexpr size_t kCount     = ArraySize(nonceLengths);
+
+    TestAesKey key(keyBytes, sizeof(keyBytes));
+    uint8_t ciphertexts[kCount][sizeof(plaintext)];
+    uint8_t tags[kCount][CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+    AesCcmBatchEntry entries[kCount];
+    for (size_t i = 0; i < kCount; i++)
+    {
+        entries[i].input        = plaintext;
+        entries[i].input_length = sizeof(plaintext) - i;
+        entries[i].aad          = aad;
+        entries[i].aad_length   = sizeof(aad);
+        entries[i].nonce        = nonce;
+        entries[i].nonce_length = nonceLengths[i];
+        entries[i].output       = ciphertexts[i];
+        entries[i].tag          = tags[i];
+        entries[i].tag_length   = tagLengths[i];
+    }
+
+    // Not every backend supports short tags.
+    CHIP_ERROR err = AES_CCM_encrypt_batch(entries, kCount, key.key);
+    for (size_t i = 0; i < kCount; i++)
+    {
+        uint8_t expectedCiphertext[sizeof(plaintext)];
+        uint8_t expectedTag[CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+        CHIP_ERROR expected = AES_CCM_encrypt(plaintext, entries[i].input_length, aad, sizeof(aad), key.key, nonce, nonceLengths[i],
+                                              expectedCiphertext, expectedTag, tagLengths[i]);
+        EXPECT_EQ(entries[i].result, expected);
+        if (expected == CHIP_NO_ERROR)
+        {
+            EXPECT_EQ(memcmp(ciphertexts[i], expectedCiphertext, entries[i].input_length), 0);
+            EXPECT_EQ(memcmp(tags[i], expectedTag, tagLengths[i]), 0);
+        }
+        else
+        {
+            EXPECT_NE(err, CHIP_NO_ERROR);
+        }
+    }
+
+    EXPECT_EQ(AES_CCM_encrypt_batch(nullptr, 0, key.key), CHIP_NO_ERROR);
+    EXPECT_EQ(AES_CCM_encrypt_batch(nullptr, 1, key.key), CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(TestAesCcmBatch, TestKeyReplacedInHandle)
+{
+    const uint8_t nonce[CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+                                                                 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c };
+    const uint8_t plaintext[32]                              = { 0x42 };
+    Symmetric128BitsKeyByteArray firstKey;
+    Symmetric128BitsKeyByteArray secondKey;
+    ASSERT_EQ(DRBG_get_bytes(firstKey, sizeof(firstKey)), CHIP_NO_ERROR);
+    memcpy(secondKey, firstKey, sizeof(secondKey));
+    secondKey[0] ^= 0x01;
+
+    uint8_t expectedCiphertext[sizeof(plaintext)];
+    uint8_t expectedTag[CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+    {
+        TestAesKey key(secondKey, sizeof(secondKey));
+        ASSERT_EQ(AES_CCM_encrypt(plaintext, sizeof(plaintext), nullptr, 0, key.key, nonce, sizeof(nonce), expectedCiphertext,
+                                  expectedTag, sizeof(expectedTag)),
+                  CHIP_NO_ERROR);
+    }
+
+    // Use the handle with one key, then give it another: whatever the backend prepared for the first key must not be used.
+    TestAesKey key(firstKey, sizeof(firstKey));
+    uint8_t ciphertext[sizeof(plaintext)];
+    uint8_t tag[CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+    ASSERT_EQ(AES_CCM_encrypt(plaintext, sizeof(plaintext), nullptr, 0, key.key, nonce, sizeof(nonce), ciphertext, tag,
+                              sizeof(tag)),
+              CHIP_NO_ERROR);
+    EXPECT_NE(memcmp(tag, expectedTag, sizeof(tag)), 0);
+
+    key.keystore.DestroyKey(key.key);
+    ASSERT_EQ(key.keystore.CreateKey(secondKey, key.key), CHIP_NO_ERROR);
+    ASSERT_EQ(AES_CCM_encrypt(plaintext, sizeof(plaintext), nullptr, 0, key.key, nonce, sizeof(nonce), ciphertext, tag,
+                              sizeof(tag)),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(memcmp(ciphertext, expectedCiphertext, sizeof(ciphertext)), 0);
+    EXPECT_EQ(memcmp(tag, expectedTag, sizeof(tag)), 0);
+
+    uint8_t decrypted[sizeof(plaintext)];
+    EXPECT_EQ(AES_CCM_decrypt(ciphertext, sizeof(ciphertext), nullptr, 0, tag, sizeof(tag), key.key, nonce, sizeof(nonce),
+                              decrypted),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(memcmp(decrypted, plaintext, sizeof(plaintext)), 0);
+}
+
+TEST_F(TestAesCcmBatch, TestBatchMatchesSingle)
+{
+    constexpr size_t kMessageLength = 64;
+    constexpr size_t kMessageCount  = 64;
+    constexpr size_t kTagLength     = CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES;
+    constexpr size_t kNonceLength   = CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES;
+
+    Symmetric128BitsKeyByteArray keyMaterial;
+    ASSERT_EQ(DRBG_get_bytes(keyMaterial, sizeof(keyMaterial)), CHIP_NO_ERROR);
+    TestAesKey key(keyMaterial, sizeof(keyMaterial));
+
+    std::vector<uint8_t> plaintext(kMessageCount * kMessageLength);
+    std::vector<uint8_t> nonces(kMessageCount * kNonceLength);
+    std::vector<uint8_t> ciphertext(kMessageCount * kMessageLength);
+    std::vector<uint8_t> decrypted(kMessageCount * kMessageLength);
+    std::vector<uint8_t> tags(kMessageCount * kTagLength);
+    uint8_t aad[16];
+    ASSERT_EQ(DRBG_get_bytes(plaintext.data(), plaintext.size()), CHIP_NO_ERROR);
+    ASSERT_EQ(DRBG_get_bytes(nonces.data(), nonces.size()), CHIP_NO_ERROR);
+    ASSERT_EQ(DRBG_get_bytes(aad, sizeof(aad)), CHIP_NO_ERROR);
+
+    std::vector<AesCcmBatchEntry> encryptEntries(kMessageCount);
+    std::vector<AesCcmBatchEntry> decryptEntries(kMessageCount);
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        AesCcmBatchEntry & entry = encryptEntries[i];
+        entry.input              = &plaintext[i * kMessageLength];
+        entry.input_length       = kMessageLength;
+        entry.aad                = aad;
+        entry.aad_length         = sizeof(aad);
+        entry.nonce              = &nonces[i * kNonceLength];
+        entry.nonce_length       = kNonceLength;
+        entry.output             = &ciphertext[i * kMessageLength];
+        entry.tag                = &tags[i * kTagLength];
+        entry.tag_length         = kTagLength;
+
+        decryptEntries[i]        = entry;
+        decryptEntries[i].input  = entry.output;
+        decryptEntries[i].output = &decrypted[i * kMessageLength];
+    }
+
+    for (auto & entry : encryptEntries)
+    {
+        ASSERT_EQ(AES_CCM_encrypt(entry.input, entry.input_length, entry.aad, entry.aad_length, key.key, entry.nonce,
+                                  entry.nonce_length, entry.output, entry.tag, entry.tag_length),
+                  CHIP_NO_ERROR);
+    }
+    for (auto & entry : decryptEntries)
+    {
+        ASSERT_EQ(AES_CCM_decrypt(entry.input, entry.input_length, entry.aad, entry.aad_length, entry.tag, entry.tag_length,
+                                  key.key, entry.nonce, entry.nonce_length, entry.output),
+                  CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(plaintext, decrypted);
+
+    const std::vector<uint8_t> singleCiphertext = ciphertext;
+    const std::vector<uint8_t> singleTags       = tags;
+    ciphertext.assign(ciphertext.size(), 0);
+    tags.assign(tags.size(), 0);
+    decrypted.assign(decrypted.size(), 0);
+
+    // The batch calls produce the same messages and tags as the per-message calls.
+    ASSERT_EQ(AES_CCM_encrypt_batch(encryptEntries.data(), encryptEntries.size(), key.key), CHIP_NO_ERROR);
+    EXPECT_EQ(ciphertext, singleCiphertext);
+    EXPECT_EQ(tags, singleTags);
+    ASSERT_EQ(AES_CCM_decrypt_batch(decryptEntries.data(), decryptEntries.size(), key.key), CHIP_NO_ERROR);
+    EXPECT_EQ(plaintext, decrypted);
+}
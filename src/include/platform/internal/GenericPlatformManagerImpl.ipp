@@ -37,6 +37,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemPacketBufferSlab.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -153,6 +154,11 @@ void GenericPlatformManagerImpl<ImplClass>::_Shutdown()
 
     ChipLogProgress(DeviceLayer, "System Layer shutdown");
     SystemLayer().Shutdown();
+
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    // Return the packet buffers kept for reuse to the heap before it is shut down.
+    System::PacketBufferSlabAllocator::ReleaseCachedBlocks();
+#endif
 }
 
 template <class ImplClass>
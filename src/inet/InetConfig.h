@@ -101,6 +101,23 @@
 #define INET_CONFIG_NUM_TCP_ENDPOINTS                       64
 #endif // INET_CONFIG_NUM_TCP_ENDPOINTS
 
+/**
+ *  @def INET_CONFIG_TCP_SEND_MAX_BUFFERS_PER_CALL
+ *
+ *  @brief
+ *    This is the maximum number of queued packet buffers that a
+ *    sockets-based TCP end point hands to the kernel in a single
+ *    send call.
+ *
+ *    Messages that are queued back to back (e.g. while a
+ *    connection is being established) are then sent together
+ *    rather than with one system call each.
+ *
+ */
+#ifndef INET_CONFIG_TCP_SEND_MAX_BUFFERS_PER_CALL
+#define INET_CONFIG_TCP_SEND_MAX_BUFFERS_PER_CALL           8
+#endif // INET_CONFIG_TCP_SEND_MAX_BUFFERS_PER_CALL
+
 /**
  *  @def INET_CONFIG_NUM_UDP_ENDPOINTS
  *
@@ -272,6 +289,41 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG
+ *
+ *  @brief
+ *    Use recvmmsg() to receive several UDP datagrams per system call in the
+ *    socket-based implementation of UDP endpoints.
+ *
+ *  @details
+ *    Each received datagram is still delivered to the endpoint's
+ *    OnMessageReceived callback in its own packet buffer. Enabled by default
+ *    on Linux, where recvmmsg() is available.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG
+#if defined(__linux__) && !defined(__ZEPHYR__)
+#define INET_CONFIG_UDP_SOCKET_MMSG 1
+#else
+#define INET_CONFIG_UDP_SOCKET_MMSG 0
+#endif
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of UDP datagrams received per recvmmsg() call, when
+ *    INET_CONFIG_UDP_SOCKET_MMSG is enabled.
+ *
+ *  @details
+ *    A packet buffer is allocated for each datagram that may be received when
+ *    a UDP socket becomes readable; the ones left unused are freed right away.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE 8
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
@@ -41,6 +41,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 // SOCK_CLOEXEC not defined on all platforms, e.g. iOS/macOS:
@@ -483,9 +484,24 @@ CHIP_ERROR TCPEndPointImplSockets::DriveSendingImpl()
 
     while (!mSendQueue.IsNull())
     {
-        size_t bufLen = mSendQueue->DataLength();
+        // Gather the head of the send queue, so that queued messages go out with a single system call.
+        struct iovec sendVector[INET_CONFIG_TCP_SEND_MAX_BUFFERS_PER_CALL];
+        size_t sendVectorLen = 0;
+        size_t bufLen        = 0;
+        for (System::PacketBufferHandle buf = mSendQueue.Retain();
+             !buf.IsNull() && sendVectorLen < INET_CONFIG_TCP_SEND_MAX_BUFFERS_PER_CALL; buf.Advance())
+        {
+            sendVector[sendVectorLen].iov_base = buf->Start();
+            sendVector[sendVectorLen].iov_len  = buf->DataLength();
+            bufLen += buf->DataLength();
+            sendVectorLen++;
+        }
 
-        ssize_t lenSentRaw = send(mSocket, mSendQueue->Start(), bufLen, sendFlags);
+        struct msghdr msg = {};
+        msg.msg_iov       = sendVector;
+        msg.msg_iovlen    = static_cast<decltype(msg.msg_iovlen)>(sendVectorLen);
+
+        ssize_t lenSentRaw = sendmsg(mSocket, &msg, sendFlags);
 
         if (lenSentRaw == -1)
         {
@@ -507,21 +523,27 @@ CHIP_ERROR TCPEndPointImplSockets::DriveSendingImpl()
         // Mark the connection as being active.
         MarkActive();
 
-        if (lenSent < bufLen)
+        // Release the buffers that were sent completely, including empty ones.
+        size_t lenToRelease = lenSent;
+        while (!mSendQueue.IsNull() && (lenToRelease > 0 || mSendQueue->DataLength() == 0))
         {
-            mSendQueue->ConsumeHead(lenSent);
+            const size_t headLen = mSendQueue->DataLength();
+            if (lenToRelease < headLen)
+            {
+                mSendQueue->ConsumeHead(lenToRelease);
+                break;
+            }
+            lenToRelease -= headLen;
+            mSendQueue.FreeHead();
         }
-        else
+
+        if (mSendQueue.IsNull())
         {
-            mSendQueue.FreeHead();
-            if (mSendQueue.IsNull())
+            // Do not wait for ability to write on this endpoint.
+            err = static_cast<System::LayerSockets &>(GetSystemLayer()).ClearCallbackOnPendingWrite(mWatch);
+            if (err != CHIP_NO_ERROR)
             {
-                // Do not wait for ability to write on this endpoint.
-                err = static_cast<System::LayerSockets &>(GetSystemLayer()).ClearCallbackOnPendingWrite(mWatch);
-                if (err != CHIP_NO_ERROR)
-                {
-                    break;
-                }
+                break;
             }
         }
 
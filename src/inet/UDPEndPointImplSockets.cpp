@@ -167,6 +167,79 @@ CHIP_ERROR IPv4Bind(int socket, const IPAddress & address, uint16_t port)
 }
 #endif // INET_CONFIG_ENABLE_IPV4
 
+// Size of the control message buffer for a received or sent datagram.
+constexpr size_t kControlDataSize = 256;
+
+// Fill in the source address and port, and the interface and destination address (if available), of a received datagram.
+CHIP_ERROR GetReceivedPacketInfo(struct msghdr & msgHeader, IPPacketInfo & packetInfo)
+{
+    const auto * peerSockAddr = static_cast<const SockAddr *>(msgHeader.msg_name);
+    if (peerSockAddr->any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr->in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr->in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (peerSockAddr->any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr->in.sin_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr->in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+#if INET_CONFIG_UDP_SOCKET_MMSG
+constexpr size_t kReceiveBatchSize = INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE;
+using ReceiveMsgHeader             = struct mmsghdr;
+#else
+constexpr size_t kReceiveBatchSize = 1;
+// Like struct mmsghdr, for receiving a single datagram with recvmsg().
+struct ReceiveMsgHeader
+{
+    struct msghdr msg_hdr;
+};
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
+
 } // anonymous namespace
 
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
@@ -297,7 +370,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     msgIOV.iov_len  = msg->DataLength();
 
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-    uint8_t controlData[256];
+    uint8_t controlData[kControlDataSize];
     memset(controlData, 0, sizeof(controlData));
 #endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
 
@@ -577,125 +650,120 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
-    CHIP_ERROR lStatus = CHIP_NO_ERROR;
-    IPPacketInfo lPacketInfo;
-    System::PacketBufferHandle lBuffer;
-
-    lPacketInfo.Clear();
-    lPacketInfo.DestPort  = mBoundPort;
-    lPacketInfo.Interface = mBoundIntfId;
+    System::PacketBufferHandle lBuffers[kReceiveBatchSize];
+    struct iovec msgIOVs[kReceiveBatchSize];
+    SockAddr lPeerSockAddrs[kReceiveBatchSize];
+    uint8_t controlData[kReceiveBatchSize][kControlDataSize];
+    ReceiveMsgHeader msgHeaders[kReceiveBatchSize];
 
-    lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
-
-    if (!lBuffer.IsNull())
+    // Allocate a buffer for each datagram that may be received.  If buffers are scarce, receive fewer datagrams.
+    unsigned int bufferCount = 0;
+    for (; bufferCount < kReceiveBatchSize; bufferCount++)
     {
-        struct iovec msgIOV;
-        SockAddr lPeerSockAddr;
-        uint8_t controlData[256];
-        struct msghdr msgHeader;
+        System::PacketBufferHandle & lBuffer = lBuffers[bufferCount];
+
+        lBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        if (lBuffer.IsNull())
+        {
+            break;
+        }
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
+        msgIOVs[bufferCount].iov_base = lBuffer->Start();
+        msgIOVs[bufferCount].iov_len  = lBuffer->AvailableDataLength();
 
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
+        memset(&lPeerSockAddrs[bufferCount], 0, sizeof(lPeerSockAddrs[bufferCount]));
 
+        struct msghdr & msgHeader = msgHeaders[bufferCount].msg_hdr;
         memset(&msgHeader, 0, sizeof(msgHeader));
 
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
+        msgHeader.msg_name       = &lPeerSockAddrs[bufferCount];
+        msgHeader.msg_namelen    = sizeof(lPeerSockAddrs[bufferCount]);
+        msgHeader.msg_iov        = &msgIOVs[bufferCount];
         msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        msgHeader.msg_control    = controlData[bufferCount];
+        msgHeader.msg_controllen = sizeof(controlData[bufferCount]);
+    }
 
-        ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+    CHIP_ERROR lStatus = CHIP_NO_ERROR;
+    size_t rcvCount    = 0;
+    size_t rcvLens[kReceiveBatchSize];
 
-        if (rcvLen == -1)
+    if (bufferCount == 0)
+    {
+        lStatus = CHIP_ERROR_NO_MEMORY;
+    }
+    else
+    {
+#if INET_CONFIG_UDP_SOCKET_MMSG
+        const int rcvResult = recvmmsg(mSocket, msgHeaders, bufferCount, MSG_DONTWAIT, nullptr);
+        if (rcvResult == -1)
         {
             lStatus = CHIP_ERROR_POSIX(errno);
         }
-        else if (lBuffer->AvailableDataLength() < static_cast<size_t>(rcvLen))
-        {
-            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
-        }
         else
         {
-            lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
+            rcvCount = static_cast<size_t>(rcvResult);
+            for (size_t i = 0; i < rcvCount; i++)
             {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
+                rcvLens[i] = msgHeaders[i].msg_len;
             }
         }
-
-        if (lStatus == CHIP_NO_ERROR)
+#else
+        const ssize_t rcvLen = recvmsg(mSocket, &msgHeaders[0].msg_hdr, MSG_DONTWAIT);
+        if (rcvLen == -1)
         {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = CHIP_ERROR_POSIX(errno);
         }
-    }
-    else
-    {
-        lStatus = CHIP_ERROR_NO_MEMORY;
+        else
+        {
+            rcvCount   = 1;
+            rcvLens[0] = static_cast<size_t>(rcvLen);
+        }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG
     }
 
-    if (lStatus == CHIP_NO_ERROR)
+    if (lStatus != CHIP_NO_ERROR)
     {
-        lBuffer.RightSize();
-        OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+        return;
     }
-    else
+
+    // A callback may close or free this endpoint, so hold a reference while delivering the datagrams, and stop delivering
+    // once the endpoint is no longer listening.
+    Retain();
+    for (size_t i = 0; i < rcvCount && mState == State::kListening && OnMessageReceived != nullptr; i++)
     {
-        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        System::PacketBufferHandle & lBuffer = lBuffers[i];
+        IPPacketInfo lPacketInfo;
+
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort  = mBoundPort;
+        lPacketInfo.Interface = mBoundIntfId;
+
+        if (lBuffer->AvailableDataLength() < rcvLens[i])
+        {
+            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            lBuffer->SetDataLength(static_cast<uint16_t>(rcvLens[i]));
+            lStatus = GetReceivedPacketInfo(msgHeaders[i].msg_hdr, lPacketInfo);
+        }
+
+        if (lStatus == CHIP_NO_ERROR)
+        {
+            lBuffer.RightSize();
+            OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        }
+        else if (OnReceiveError != nullptr)
         {
             OnReceiveError(this, lStatus, nullptr);
         }
     }
+    Release();
 }
 
 #ifdef IPV6_MULTICAST_LOOP
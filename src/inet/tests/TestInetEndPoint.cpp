@@ -364,6 +364,60 @@ TEST_F(TestInetEndPoint, TestInetEndPointInternal)
     EXPECT_TRUE(SYSTEM_STATS_TEST_HIGH_WATER_MARK(System::Stats::kInetLayer_NumTCPEps, 1));
 }
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+namespace {
+
+constexpr size_t kUDPBatchMessageCount = 20;
+
+bool gUDPBatchReceived[kUDPBatchMessageCount];
+size_t gUDPBatchReceivedCount = 0;
+
+void HandleUDPBatchMessage(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    ASSERT_EQ(msg->DataLength(), 2u);
+    const size_t index = msg->Start()[0];
+    ASSERT_LT(index, kUDPBatchMessageCount);
+    EXPECT_EQ(msg->Start()[1], static_cast<uint8_t>(~index));
+    EXPECT_FALSE(gUDPBatchReceived[index]);
+    gUDPBatchReceived[index] = true;
+    gUDPBatchReceivedCount++;
+}
+
+} // namespace
+
+// Send more messages than are received in one batch, and check that each is received in its own buffer.
+TEST_F(TestInetEndPoint, TestInetUDPReceiveBatch)
+{
+    UDPEndPoint * receiver   = nullptr;
+    UDPEndPoint * sender     = nullptr;
+    const IPAddress loopback = IPAddress::Loopback(IPAddressType::kIPv6);
+
+    ASSERT_EQ(gUDP.NewEndPoint(&receiver), CHIP_NO_ERROR);
+    ASSERT_EQ(gUDP.NewEndPoint(&sender), CHIP_NO_ERROR);
+    ASSERT_EQ(receiver->Bind(IPAddressType::kIPv6, loopback, 0), CHIP_NO_ERROR);
+    ASSERT_EQ(receiver->Listen(HandleUDPBatchMessage, nullptr), CHIP_NO_ERROR);
+    ASSERT_EQ(sender->Bind(IPAddressType::kIPv6, loopback, 0), CHIP_NO_ERROR);
+
+    // Queue all the messages before servicing the receiver.
+    for (size_t i = 0; i < kUDPBatchMessageCount; i++)
+    {
+        const uint8_t payload[] = { static_cast<uint8_t>(i), static_cast<uint8_t>(~i) };
+        PacketBufferHandle msg  = PacketBufferHandle::NewWithData(payload, sizeof(payload));
+        ASSERT_FALSE(msg.IsNull());
+        EXPECT_EQ(sender->SendTo(loopback, receiver->GetBoundPort(), std::move(msg)), CHIP_NO_ERROR);
+    }
+
+    for (int i = 0; i < 100 && gUDPBatchReceivedCount < kUDPBatchMessageCount; i++)
+    {
+        ServiceEvents(10);
+    }
+    EXPECT_EQ(gUDPBatchReceivedCount, kUDPBatchMessageCount);
+
+    sender->Free();
+    receiver->Free();
+}
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 // Test the Inet resource limitations.
 TEST_F(TestInetEndPoint, TestInetEndPointLimit)
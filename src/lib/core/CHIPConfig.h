@@ -931,6 +931,72 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_NUM_DIRTY_SET_INDEX_BUCKETS
+ *
+ * @brief Defines the number of hash buckets the reporting engine uses to look up the paths of its dirty set. When the object
+ *        pools are allocated on the heap, the dirty set is not bounded by CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, so more buckets
+ *        are used.
+ */
+#ifndef CHIP_IM_SERVER_NUM_DIRTY_SET_INDEX_BUCKETS
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_IM_SERVER_NUM_DIRTY_SET_INDEX_BUCKETS 64
+#else
+#define CHIP_IM_SERVER_NUM_DIRTY_SET_INDEX_BUCKETS CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
+#endif
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_REPORT_CACHE_ENTRIES
+ *
+ * @brief Defines the number of attribute values the reporting engine keeps encoded during one run, so that an attribute
+ *        reported to several subscribers is only read and encoded once, when the application enables the cache with
+ *        reporting::Engine::SetAttributeReportCacheEnabled(). The entries, and a scratch buffer as large as a report, are
+ *        allocated from the heap on first use. Defaults to 0, which leaves the cache out, when the object pools are not
+ *        allocated on the heap.
+ */
+#ifndef CHIP_IM_SERVER_REPORT_CACHE_ENTRIES
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_IM_SERVER_REPORT_CACHE_ENTRIES 32
+#else
+#define CHIP_IM_SERVER_REPORT_CACHE_ENTRIES 0
+#endif
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_REPORT_CACHE_ENTRY_SIZE
+ *
+ * @brief Defines the largest encoded attribute report, in bytes, the reporting engine keeps in one entry of its report cache.
+ *        Larger values are read and encoded for each subscriber.
+ */
+#ifndef CHIP_IM_SERVER_REPORT_CACHE_ENTRY_SIZE
+#define CHIP_IM_SERVER_REPORT_CACHE_ENTRY_SIZE 256
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_NUM_READ_HANDLER_NODE_INDEX_BUCKETS
+ *
+ * @brief Defines the number of hash buckets the report scheduler uses to look up the node of a ReadHandler. When the object
+ *        pools are allocated on the heap, the number of ReadHandlers is not bounded by the pool sizes, so more buckets are used.
+ */
+#ifndef CHIP_IM_SERVER_NUM_READ_HANDLER_NODE_INDEX_BUCKETS
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_IM_SERVER_NUM_READ_HANDLER_NODE_INDEX_BUCKETS 64
+#else
+#define CHIP_IM_SERVER_NUM_READ_HANDLER_NODE_INDEX_BUCKETS (CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS)
+#endif
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_NUM_INTEREST_INDEX_BUCKETS
+ *
+ * @brief Defines the number of buckets, selected by cluster ID, of the index the reporting engine keeps of the attribute
+ *        paths of the read handlers, so that marking an attribute dirty only looks at the handlers interested in its cluster.
+ */
+#ifndef CHIP_IM_SERVER_NUM_INTEREST_INDEX_BUCKETS
+#define CHIP_IM_SERVER_NUM_INTEREST_INDEX_BUCKETS 16
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1116,6 +1182,44 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_NAME_LENGTH 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_CACHE
+ *
+ * Have GroupDataProviderImpl keep the operational keys of all group sessions
+ * in RAM, so that incoming group messages are matched to their sessions
+ * without reading the fabrics, group-key maps and key sets from storage. The
+ * copy is allocated on the heap and rebuilt on the first lookup after the maps
+ * or key sets change. Can also be changed at runtime with
+ * GroupDataProviderImpl::SetGroupSessionCacheEnabled().
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE
+#define CHIP_CONFIG_GROUP_SESSION_CACHE 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+ *
+ * Have AccessControl::Check look up the access control entries that apply to
+ * the subject in an index instead of iterating over all of them. The index is
+ * allocated on the heap, with one element per (subject, target) pair of each
+ * entry, and rebuilt on the first check after the entries change.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+#define CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE
+ *
+ * Number of (endpoint, cluster, privilege) access decisions remembered by an
+ * AccessControl::CheckCache, such as the one used while building each report.
+ * Reports visit the attributes of a cluster one after the other, so a few
+ * entries are enough.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_CHECK_CACHE_SIZE 4
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
  *
@@ -1785,6 +1889,66 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS 5
 #endif // CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS
 
+/**
+ *  @def CHIP_CONFIG_EMBER_METADATA_LOOKUP_CACHE_SIZE
+ *
+ *  @brief
+ *    Number of entries in each of the cluster and attribute metadata lookup caches used by
+ *    attribute-storage.cpp. The caches are keyed by endpoint type and cluster metadata, which
+ *    are shared by all endpoints of the same type, so this should cover the distinct (endpoint
+ *    type, cluster) and (cluster, attribute) pairs that are accessed frequently.
+ *
+ *    Must be a power of two.
+ */
+#ifndef CHIP_CONFIG_EMBER_METADATA_LOOKUP_CACHE_SIZE
+#define CHIP_CONFIG_EMBER_METADATA_LOOKUP_CACHE_SIZE 32
+#endif // CHIP_CONFIG_EMBER_METADATA_LOOKUP_CACHE_SIZE
+
+/**
+ *  @def CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS
+ *
+ *  @brief
+ *    Number of worker threads that decrypt incoming secure unicast messages.
+ *
+ *    When non-zero, SessionManager hands the decryption and authentication of each incoming
+ *    secure unicast message to a pool of this many worker threads, sharded by session so that
+ *    messages on one session are still delivered in order. The rest of the message processing
+ *    (message counters, exchange dispatch) runs on the worker with the Matter stack lock held, so
+ *    it stays serialized with the event loop.
+ *
+ *    Requires CHIP_SYSTEM_CONFIG_POSIX_LOCKING. Defaults to 0 (decrypt on the event loop thread).
+ *
+ *    Experimental: only the transport layer supports a non-zero value. The messaging, app and
+ *    controller layers assume that a received message has been dispatched by the time the
+ *    transport returns, which no longer holds once decryption is asynchronous.
+ */
+#ifndef CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS
+#define CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS 0
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS
+
+/**
+ *  @def CHIP_CONFIG_SECURE_MESSAGE_WORKER_QUEUE_DEPTH
+ *
+ *  @brief
+ *    Maximum number of incoming secure unicast messages queued for, or being decrypted by, the
+ *    worker threads enabled by CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS. Messages received while
+ *    the queue is full are dropped, as they would be if the socket's receive buffer were full.
+ */
+#ifndef CHIP_CONFIG_SECURE_MESSAGE_WORKER_QUEUE_DEPTH
+#define CHIP_CONFIG_SECURE_MESSAGE_WORKER_QUEUE_DEPTH 64
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_QUEUE_DEPTH
+
+/**
+ *  @def CHIP_CONFIG_WRITE_COALESCING_STORAGE_MAX_PENDING_WRITES
+ *
+ *  @brief
+ *    Maximum number of distinct keys whose writes or deletions a WriteCoalescingPersistentStorageDelegate
+ *    holds back at a time. A write to another key once this many are pending flushes them first.
+ */
+#ifndef CHIP_CONFIG_WRITE_COALESCING_STORAGE_MAX_PENDING_WRITES
+#define CHIP_CONFIG_WRITE_COALESCING_STORAGE_MAX_PENDING_WRITES 8
+#endif // CHIP_CONFIG_WRITE_COALESCING_STORAGE_MAX_PENDING_WRITES
+
 /**
  * @}
  */
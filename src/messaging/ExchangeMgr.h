@@ -238,11 +238,21 @@ private:
 
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextPool;
 
+    // Exchanges chained by exchange ID, so that an incoming message is matched to its exchange without
+    // walking the whole pool. Exchanges are added when they are constructed and removed when they are destroyed.
+    static constexpr size_t kExchangeIndexSize = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS;
+    ExchangeContext * mExchangeIndex[kExchangeIndexSize] = {};
+
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
 
     UnsolicitedMessageHandlerSlot UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
 
+    void AddToExchangeIndex(ExchangeContext * ec);
+    void RemoveFromExchangeIndex(ExchangeContext * ec);
+    ExchangeContext * FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                   const PayloadHeader & payloadHeader);
+
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
 
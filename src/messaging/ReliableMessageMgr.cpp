@@ -21,8 +21,11 @@
  *
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <inttypes.h>
+#include <string.h>
+#include <utility>
 
 #include <app/icd/server/ICDServerConfig.h>
 #include <lib/support/BitFlags.h>
@@ -51,7 +54,7 @@ namespace Messaging {
 System::Clock::Timeout ReliableMessageMgr::sAdditionalMRPBackoffTime = CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST;
 
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
-    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
+    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0), scheduleIndex(kNotScheduled)
 {
     ec->SetWaitingForAck(true);
 }
@@ -78,10 +81,15 @@ void ReliableMessageMgr::Shutdown()
 
     // Clear the retransmit table
     mRetransTable.ForEachActiveObject([&](auto * entry) {
-        mRetransTable.ReleaseObject(entry);
+        ReleaseRetransTableEntry(*entry);
         return Loop::Continue;
     });
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    mRetransSchedule.Free();
+    mRetransScheduleCapacity = 0;
+#endif
+
     mSystemLayer = nullptr;
 }
 
@@ -122,10 +130,13 @@ void ReliableMessageMgr::ExecuteActions()
         }
     });
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
+    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired, earliest first. The number
+    // of entries visited is bounded so that an entry whose next retransmission is due right away cannot keep this going.
+    for (size_t remaining = mRetransScheduleSize; remaining > 0 && mRetransScheduleSize > 0; remaining--)
+    {
+        RetransTableEntry * entry = mRetransSchedule[0];
         if (entry->nextRetransTime > now)
-            return Loop::Continue;
+            break;
 
         VerifyOrDie(!entry->retainedBuf.IsNull());
 
@@ -161,9 +172,9 @@ void ReliableMessageMgr::ExecuteActions()
             }
 
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
+            ReleaseRetransTableEntry(*entry);
 
-            return Loop::Continue;
+            continue;
         }
 
         entry->sendCount++;
@@ -175,9 +186,7 @@ void ReliableMessageMgr::ExecuteActions()
 
         CalculateNextRetransTime(*entry);
         SendFromRetransTable(entry);
-
-        return Loop::Continue;
-    });
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
@@ -203,7 +212,8 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
 {
     VerifyOrReturnError(!rc->IsWaitingForAck(), CHIP_ERROR_INCORRECT_STATE);
 
-    *rEntry = mRetransTable.CreateObject(rc);
+    // Make room in the schedule up front, so that scheduling the entry later on cannot fail.
+    *rEntry = ReserveRetransSchedule(mRetransTable.Allocated() + 1) ? mRetransTable.CreateObject(rc) : nullptr;
     if (*rEntry == nullptr)
     {
         ChipLogError(ExchangeManager, "mRetransTable Already Full");
@@ -276,6 +286,9 @@ System::Clock::Timeout ReliableMessageMgr::GetBackoff(System::Clock::Timeout bas
 
 void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    entry->firstSendTime = System::SystemClock().GetMonotonicTimestamp();
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     CalculateNextRetransTime(*entry);
     StartTimer();
 }
@@ -286,6 +299,17 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
         {
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+            // Only a message that was sent once tells how long the peer took to acknowledge it (Karn's algorithm).
+            if (entry->sendCount == 0 && entry->ec->HasSessionHandle())
+            {
+                auto roundTripTime = std::chrono::duration_cast<System::Clock::Milliseconds32>(
+                    System::SystemClock().GetMonotonicTimestamp() - entry->firstSendTime);
+                entry->ec->GetSessionHandle()->GetRoundTripTimeEstimator().AddSample(roundTripTime);
+                MATTER_LOG_METRIC(Tracing::kMetricDeviceRMPRoundTripTime, roundTripTime.count());
+            }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
             // Clear the entry from the retransmision table.
             ClearRetransTable(*entry);
 
@@ -358,6 +382,10 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
 
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
+    // Exchanges that never sent a reliable message, e.g. all the exchanges of sessions over TCP, have no
+    // entry in the table, so there is nothing to look for.
+    VerifyOrReturn(rc->IsWaitingForAck());
+
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc)
         {
@@ -370,7 +398,7 @@ void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
-    mRetransTable.ReleaseObject(&entry);
+    ReleaseRetransTableEntry(entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
 }
@@ -388,13 +416,10 @@ void ReliableMessageMgr::StartTimer()
     });
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    if (mRetransScheduleSize > 0 && mRetransSchedule[0]->nextRetransTime < nextWakeTime)
+    {
+        nextWakeTime = mRetransSchedule[0]->nextRetransTime;
+    }
 
     StopTimer();
 
@@ -459,6 +484,18 @@ CHIP_ERROR ReliableMessageMgr::MapSendError(CHIP_ERROR error, uint16_t exchangeI
     return error;
 }
 
+System::Clock::Timeout ReliableMessageMgr::GetAdaptiveBaseInterval(const ReliableMessageProtocolConfig & remoteMRPConfig,
+                                                                   const Transport::RoundTripTimeEstimator & roundTripTime)
+{
+    VerifyOrReturnValue(roundTripTime.HasEstimate(), remoteMRPConfig.mActiveRetransTimeout);
+
+    // Wait as long as the peer has been measured to take to acknowledge, but no less than its active interval and no more
+    // than its idle interval.
+    return std::max<System::Clock::Timeout>(
+        remoteMRPConfig.mActiveRetransTimeout,
+        std::min<System::Clock::Timeout>(roundTripTime.GetRetransmissionTimeout(), remoteMRPConfig.mIdleRetransTimeout));
+}
+
 void ReliableMessageMgr::SetAdditionalMRPBackoffTime(const Optional<System::Clock::Timeout> & additionalTime)
 {
     sAdditionalMRPBackoffTime = additionalTime.ValueOr(CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST);
@@ -472,7 +509,12 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
     if (entry.ec->HasReceivedAtLeastOneMessage())
     {
         // If we have received at least one message, assume peer is active and use ActiveRetransTimeout
-        baseTimeout = entry.ec->GetSessionHandle()->GetRemoteMRPConfig().mActiveRetransTimeout;
+        const auto & remoteMRPConfig = entry.ec->GetSessionHandle()->GetRemoteMRPConfig();
+        baseTimeout                  = remoteMRPConfig.mActiveRetransTimeout;
+
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+        baseTimeout = GetAdaptiveBaseInterval(remoteMRPConfig, entry.ec->GetSessionHandle()->GetRoundTripTimeEstimator());
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     }
     else
     {
@@ -483,6 +525,112 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 
     System::Clock::Timeout backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime          = System::SystemClock().GetMonotonicTimestamp() + backoff;
+
+    ScheduleRetransmission(entry);
+}
+
+bool ReliableMessageMgr::ReserveRetransSchedule(size_t size)
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    VerifyOrReturnValue(size > mRetransScheduleCapacity, true);
+
+    const size_t capacity = (mRetransScheduleCapacity == 0) ? CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE : 2 * mRetransScheduleCapacity;
+    Platform::ScopedMemoryBuffer<RetransTableEntry *> schedule;
+    VerifyOrReturnValue(schedule.Calloc(capacity), false);
+    if (mRetransScheduleSize > 0)
+    {
+        memcpy(schedule.Get(), mRetransSchedule.Get(), mRetransScheduleSize * sizeof(RetransTableEntry *));
+    }
+
+    mRetransSchedule         = std::move(schedule);
+    mRetransScheduleCapacity = capacity;
+    return true;
+#else
+    return size <= ArraySize(mRetransSchedule);
+#endif
+}
+
+void ReliableMessageMgr::ScheduleRetransmission(RetransTableEntry & entry)
+{
+    if (entry.scheduleIndex == RetransTableEntry::kNotScheduled)
+    {
+        // AddToRetransTable reserved a slot for every entry of the table.
+        entry.scheduleIndex                      = mRetransScheduleSize;
+        mRetransSchedule[mRetransScheduleSize++] = &entry;
+    }
+
+    // The retransmission time of an entry that was already scheduled may have moved either way.
+    SiftDownRetransmission(SiftUpRetransmission(entry.scheduleIndex));
+}
+
+void ReliableMessageMgr::UnscheduleRetransmission(RetransTableEntry & entry)
+{
+    VerifyOrReturn(entry.scheduleIndex != RetransTableEntry::kNotScheduled);
+
+    const size_t index  = entry.scheduleIndex;
+    entry.scheduleIndex = RetransTableEntry::kNotScheduled;
+
+    // Move the last entry into the hole and restore the heap order around it.
+    mRetransScheduleSize--;
+    if (index != mRetransScheduleSize)
+    {
+        mRetransSchedule[index]                = mRetransSchedule[mRetransScheduleSize];
+        mRetransSchedule[index]->scheduleIndex = index;
+        SiftDownRetransmission(SiftUpRetransmission(index));
+    }
+}
+
+size_t ReliableMessageMgr::SiftUpRetransmission(size_t index)
+{
+    while (index > 0)
+    {
+        const size_t parent = (index - 1) / 2;
+        if (mRetransSchedule[parent]->nextRetransTime <= mRetransSchedule[index]->nextRetransTime)
+        {
+            break;
+        }
+        SwapRetransmissions(index, parent);
+        index = parent;
+    }
+    return index;
+}
+
+size_t ReliableMessageMgr::SiftDownRetransmission(size_t index)
+{
+    while (true)
+    {
+        const size_t left  = 2 * index + 1;
+        const size_t right = left + 1;
+        size_t earliest    = index;
+
+        if (left < mRetransScheduleSize && mRetransSchedule[left]->nextRetransTime < mRetransSchedule[earliest]->nextRetransTime)
+        {
+            earliest = left;
+        }
+        if (right < mRetransScheduleSize && mRetransSchedule[right]->nextRetransTime < mRetransSchedule[earliest]->nextRetransTime)
+        {
+            earliest = right;
+        }
+        if (earliest == index)
+        {
+            return index;
+        }
+        SwapRetransmissions(index, earliest);
+        index = earliest;
+    }
+}
+
+void ReliableMessageMgr::SwapRetransmissions(size_t index1, size_t index2)
+{
+    std::swap(mRetransSchedule[index1], mRetransSchedule[index2]);
+    mRetransSchedule[index1]->scheduleIndex = index1;
+    mRetransSchedule[index2]->scheduleIndex = index2;
+}
+
+void ReliableMessageMgr::ReleaseRetransTableEntry(RetransTableEntry & entry)
+{
+    UnscheduleRetransmission(entry);
+    mRetransTable.ReleaseObject(&entry);
 }
 
 #if CHIP_CONFIG_TEST
@@ -30,10 +30,12 @@
 #include <lib/core/Optional.h>
 #include <lib/support/BitFlags.h>
 #include <lib/support/Pool.h>
+#include <lib/support/ScopedBuffer.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <system/SystemLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <transport/RoundTripTimeEstimator.h>
 #include <transport/SessionUpdateDelegate.h>
 #include <transport/raw/MessageHeader.h>
 
@@ -66,6 +68,13 @@ public:
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
+        size_t scheduleIndex;                     /**< The position of the entry in the retransmission schedule,
+                                                       or kNotScheduled before its first transmission. */
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+        System::Clock::Timestamp firstSendTime = System::Clock::kZero; /**< The time at which the message was first sent. */
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
+        static constexpr size_t kNotScheduled = SIZE_MAX;
     };
 
     ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
@@ -115,6 +124,19 @@ public:
     static System::Clock::Timeout GetBackoff(System::Clock::Timeout baseInterval, uint8_t sendCount,
                                              bool computeMaxPossible = false);
 
+    /**
+     *  Calculate the base interval of the retransmissions to a peer known to be active, when
+     *  CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT is set.
+     *
+     *  @param[in]   remoteMRPConfig      The MRP parameters of the peer.
+     *  @param[in]   roundTripTime        The round-trip time measured on the session with the peer.
+     *
+     *  @retval  The retransmission timeout of roundTripTime kept between the active and idle intervals of the peer, or the
+     *           active interval when nothing was measured yet.
+     */
+    static System::Clock::Timeout GetAdaptiveBaseInterval(const ReliableMessageProtocolConfig & remoteMRPConfig,
+                                                          const Transport::RoundTripTimeEstimator & roundTripTime);
+
     /**
      *  Start retranmisttion of cached encryped packet for current entry.
      *
@@ -230,6 +252,22 @@ private:
      */
     void CalculateNextRetransTime(RetransTableEntry & entry);
 
+    /**
+     * The retransmission schedule is a binary min-heap of the entries that were transmitted, ordered by
+     * nextRetransTime, so that finding the next entry to retransmit does not require walking the whole table.
+     */
+    bool ReserveRetransSchedule(size_t size);
+    void ScheduleRetransmission(RetransTableEntry & entry);
+    void UnscheduleRetransmission(RetransTableEntry & entry);
+    size_t SiftUpRetransmission(size_t index);
+    size_t SiftDownRetransmission(size_t index);
+    void SwapRetransmissions(size_t index1, size_t index2);
+
+    /**
+     * Remove an entry from the retransmission schedule and release it, without restarting the timer.
+     */
+    void ReleaseRetransTableEntry(RetransTableEntry & entry);
+
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
 
@@ -248,6 +286,15 @@ private:
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // The table is not bounded in heap builds, so the schedule grows with it.
+    Platform::ScopedMemoryBuffer<RetransTableEntry *> mRetransSchedule;
+    size_t mRetransScheduleCapacity = 0;
+#else
+    RetransTableEntry * mRetransSchedule[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE];
+#endif
+    size_t mRetransScheduleSize = 0;
+
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 
     static System::Clock::Timeout sAdditionalMRPBackoffTime;
@@ -183,6 +183,26 @@ namespace chip {
 #endif
 #endif // CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST
 
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    Base the retransmission timeout of a session on the round-trip time
+ *    measured from the acknowledgements received on it, rather than only on
+ *    the active retransmission interval advertised by the peer.
+ *
+ *  The measured timeout (SRTT + 4 * RTTVAR, as in RFC 6298) is only used once
+ *  the peer is known to be active, and is kept between the active and idle
+ *  retransmission intervals of the peer, so that it never retransmits sooner
+ *  than the specification allows.
+ *
+ *  The round-trip time is neither measured nor stored in the sessions unless
+ *  this is set.
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+#define CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT 0
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
 inline constexpr System::Clock::Milliseconds32 kDefaultActiveTime = System::Clock::Milliseconds16(4000);
 
 /**
@@ -86,6 +86,18 @@ public:
     bool IsOnMessageReceivedCalled = false;
 };
 
+class RespondingAppDelegate : public MockAppDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        MockAppDelegate::OnMessageReceived(ec, payloadHeader, std::move(buffer));
+        return ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                               SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    }
+};
+
 class WaitForTimeoutDelegate : public ExchangeDelegate
 {
 public:
@@ -260,4 +272,28 @@ TEST_F(TestExchangeMgr, CheckExchangeMessages)
     EXPECT_EQ(err, CHIP_NO_ERROR);
 }
 
+TEST_F(TestExchangeMgr, CheckResponseMatchesInitiatorExchange)
+{
+    MockAppDelegate mockSolicitedAppDelegate;
+    RespondingAppDelegate respondingAppDelegate;
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1,
+                                                                            &respondingAppDelegate),
+              CHIP_NO_ERROR);
+
+    // Alice and Bob share the exchange manager, so the initiator and responder exchanges have the same exchange ID and
+    // have to be told apart by their session and role.
+    ExchangeContext * ec1 = NewExchangeToBob(&mockSolicitedAppDelegate);
+    ASSERT_NE(ec1, nullptr);
+    SendFlags sendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck, Messaging::SendMessageFlags::kExpectResponse);
+    EXPECT_EQ(ec1->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                               sendFlags),
+              CHIP_NO_ERROR);
+
+    DrainAndServiceIO();
+    EXPECT_TRUE(respondingAppDelegate.IsOnMessageReceivedCalled);
+    EXPECT_TRUE(mockSolicitedAppDelegate.IsOnMessageReceivedCalled);
+
+    EXPECT_EQ(GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1), CHIP_NO_ERROR);
+}
+
 } // namespace
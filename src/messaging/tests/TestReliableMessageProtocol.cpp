@@ -354,6 +354,119 @@ TEST_F(TestReliableMessageProtocol, CheckAddClearRetrans)
     exchange->Close();
 }
 
+TEST_F(TestReliableMessageProtocol, CheckClearRetransNotWaitingForAck)
+{
+    MockAppDelegate mockAppDelegate(*this);
+    ExchangeContext * waitingExchange = NewExchangeToAlice(&mockAppDelegate);
+    ASSERT_NE(waitingExchange, nullptr);
+    ExchangeContext * idleExchange = NewExchangeToAlice(&mockAppDelegate);
+    ASSERT_NE(idleExchange, nullptr);
+
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+
+    ReliableMessageMgr::RetransTableEntry * entry;
+
+    rm->AddToRetransTable(waitingExchange->GetReliableMessageContext(), &entry);
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 1);
+
+    // Clearing the table for an exchange without any reliable message in flight must leave the entries of the other
+    // exchanges alone.
+    ReliableMessageContext * idleRc = idleExchange->GetReliableMessageContext();
+    EXPECT_FALSE(idleRc->IsWaitingForAck());
+    rm->ClearRetransTable(idleRc);
+
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 1);
+    EXPECT_TRUE(waitingExchange->GetReliableMessageContext()->IsWaitingForAck());
+
+    bool foundEntry = false;
+    rm->EnumerateRetransTable([&](auto * e) {
+        foundEntry = foundEntry || (e == entry && &e->ec.Get() == waitingExchange);
+        return Loop::Continue;
+    });
+    EXPECT_TRUE(foundEntry);
+
+    rm->ClearRetransTable(*entry);
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+
+    idleExchange->Close();
+    waitingExchange->Close();
+}
+
+TEST_F(TestReliableMessageProtocol, CheckRetransTableBeyondConfiguredSize)
+{
+    constexpr size_t kNumMessages = CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE + 2;
+
+    MockAppDelegate mockAppDelegate(*this);
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+
+    ExchangeContext * exchanges[kNumMessages]                     = {};
+    ReliableMessageMgr::RetransTableEntry * entries[kNumMessages] = {};
+    size_t numEntries                                             = 0;
+
+    for (size_t i = 0; i < kNumMessages; i++)
+    {
+        exchanges[i] = NewExchangeToAlice(&mockAppDelegate);
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        // Neither the exchanges nor the retransmission table are bounded, so every message is tracked.
+        ASSERT_NE(exchanges[i], nullptr);
+        ASSERT_EQ(rm->AddToRetransTable(exchanges[i]->GetReliableMessageContext(), &entries[i]), CHIP_NO_ERROR);
+#else
+        if (exchanges[i] == nullptr)
+        {
+            break;
+        }
+        // Messages that do not fit in the table are refused rather than taking the device down.
+        CHIP_ERROR err = rm->AddToRetransTable(exchanges[i]->GetReliableMessageContext(), &entries[i]);
+        if (i >= CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE)
+        {
+            EXPECT_EQ(err, CHIP_ERROR_RETRANS_TABLE_FULL);
+            entries[i] = nullptr;
+            continue;
+        }
+        ASSERT_EQ(err, CHIP_NO_ERROR);
+#endif
+        rm->StartRetransmision(entries[i]);
+        numEntries++;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    EXPECT_EQ(numEntries, kNumMessages);
+#else
+    EXPECT_EQ(numEntries, static_cast<size_t>(CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE));
+#endif
+    EXPECT_EQ(rm->TestGetCountRetransTable(), static_cast<int>(numEntries));
+
+    // Clear the entries out of order, so that they are removed from the middle of the schedule as well.
+    for (size_t i = 0; i < kNumMessages; i += 2)
+    {
+        if (entries[i] != nullptr)
+        {
+            rm->ClearRetransTable(*entries[i]);
+            numEntries--;
+        }
+    }
+    EXPECT_EQ(rm->TestGetCountRetransTable(), static_cast<int>(numEntries));
+
+    for (size_t i = 1; i < kNumMessages; i += 2)
+    {
+        if (entries[i] != nullptr)
+        {
+            rm->ClearRetransTable(*entries[i]);
+        }
+    }
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+
+    for (ExchangeContext * exchange : exchanges)
+    {
+        if (exchange != nullptr)
+        {
+            exchange->Close();
+        }
+    }
+}
+
 /**
  * Tests MRP retransmission logic with the following scenario:
  *
@@ -1751,6 +1864,32 @@ TEST_F(TestReliableMessageProtocol, CheckGetBackoffAdditionalTime)
     CheckGetBackoffImpl(System::Clock::Seconds32(1));
 }
 
+TEST_F(TestReliableMessageProtocol, CheckAdaptiveBaseInterval)
+{
+    const ReliableMessageProtocolConfig remoteMRPConfig(2000_ms32, 300_ms32);
+
+    // Without any measurement, the active interval of the peer is used as is.
+    RoundTripTimeEstimator roundTripTime;
+    EXPECT_EQ(ReliableMessageMgr::GetAdaptiveBaseInterval(remoteMRPConfig, roundTripTime), 300_ms32);
+
+    // A peer faster than it advertised still gets its active interval.
+    roundTripTime.AddSample(10_ms32);
+    EXPECT_LT(roundTripTime.GetRetransmissionTimeout(), 300_ms32);
+    EXPECT_EQ(ReliableMessageMgr::GetAdaptiveBaseInterval(remoteMRPConfig, roundTripTime), 300_ms32);
+
+    // A first sample of 500 ms gives SRTT = 500 ms and RTTVAR = 250 ms, so a timeout of 1500 ms.
+    roundTripTime.Reset();
+    roundTripTime.AddSample(500_ms32);
+    EXPECT_EQ(roundTripTime.GetRetransmissionTimeout(), 1500_ms32);
+    EXPECT_EQ(ReliableMessageMgr::GetAdaptiveBaseInterval(remoteMRPConfig, roundTripTime), 1500_ms32);
+
+    // A peer slower than its idle interval is never waited for longer than that.
+    roundTripTime.Reset();
+    roundTripTime.AddSample(5000_ms32);
+    EXPECT_GT(roundTripTime.GetRetransmissionTimeout(), 2000_ms32);
+    EXPECT_EQ(ReliableMessageMgr::GetAdaptiveBaseInterval(remoteMRPConfig, roundTripTime), 2000_ms32);
+}
+
 TEST_F(TestReliableMessageProtocol, CheckApplicationResponseDelayed)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -54,6 +54,34 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+ *
+ * Keep the key-value store in an append-only log (ChipLinuxStorageLog) rather than in an INI file that is rewritten
+ * as a whole on every change. The log uses its own file format; existing INI files are not converted.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_MIN_BYTES
+ *
+ * Size below which the key-value store log is never compacted.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_MIN_BYTES
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_MIN_BYTES (16 * 1024)
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_MIN_BYTES
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_RATIO
+ *
+ * The key-value store log is compacted once it is this many times larger than its live records.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_RATIO
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_RATIO 2
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_RATIO
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
@@ -0,0 +1,475 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides a log-structured implementation of the key-value store
+ *          object on Linux platform.
+ *
+ */
+
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+#include <lib/support/BufferReader.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceConfig.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+// The file starts with a magic number and a format version, followed by the records.
+constexpr uint8_t kLogFileHeader[] = { 'C', 'H', 'I', 'P', 'K', 'V', 'L', 1 };
+
+// Each record is: CRC-32 of the rest of the record, type, key length, value length, key, value.
+constexpr size_t kRecordHeaderSize = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+uint32_t ComputeCrc32(const uint8_t * data, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+} // namespace
+
+ChipLinuxStorageLog::~ChipLinuxStorageLog()
+{
+    Shutdown();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Init(const char * logFile)
+{
+    VerifyOrReturnError(logFile != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxStorageLog::Init: Using KVS log file: %s", logFile);
+    if (mFd != -1)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog::Init: Attempt to re-initialize with KVS log file: %s", logFile);
+        return CHIP_NO_ERROR;
+    }
+
+    mLogPath.assign(logFile);
+    mFd = open(logFile, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (mFd == -1)
+    {
+        ChipLogError(DeviceLayer, "failed to open file (%s), %s (%d)", logFile, strerror(errno), errno);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = Load();
+    if (err != CHIP_NO_ERROR)
+    {
+        close(mFd);
+        mFd = -1;
+        mEntries.clear();
+    }
+    return err;
+}
+
+void ChipLinuxStorageLog::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    if (mFd != -1)
+    {
+        if (mDirty)
+        {
+            fdatasync(mFd);
+        }
+        close(mFd);
+        mFd = -1;
+    }
+    mEntries.clear();
+    mLogSize      = 0;
+    mLiveSize     = 0;
+    mBytesWritten = 0;
+    mDirty        = false;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Load()
+{
+    struct stat st;
+    VerifyOrReturnError(fstat(mFd, &st) == 0, CHIP_ERROR_READ_FAILED);
+
+    mEntries.clear();
+    mLogSize  = 0;
+    mLiveSize = sizeof(kLogFileHeader);
+
+    if (st.st_size == 0)
+    {
+        // New store: write the file header.
+        ReturnErrorOnFailure(WriteFully(mFd, kLogFileHeader, sizeof(kLogFileHeader)));
+        VerifyOrReturnError(fsync(mFd) == 0, CHIP_ERROR_WRITE_FAILED);
+        mLogSize = sizeof(kLogFileHeader);
+        return SyncDirectory();
+    }
+
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    std::vector<uint8_t> contents(fileSize);
+    size_t readSize = 0;
+    while (readSize < fileSize)
+    {
+        ssize_t count = pread(mFd, contents.data() + readSize, fileSize - readSize, static_cast<off_t>(readSize));
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(count > 0, CHIP_ERROR_READ_FAILED);
+        readSize += static_cast<size_t>(count);
+    }
+
+    if (fileSize < sizeof(kLogFileHeader) || memcmp(contents.data(), kLogFileHeader, sizeof(kLogFileHeader)) != 0)
+    {
+        ChipLogError(DeviceLayer, "%s is not a KVS log file", mLogPath.c_str());
+        return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+
+    size_t offset = sizeof(kLogFileHeader);
+    while (offset < fileSize)
+    {
+        const uint8_t * record = contents.data() + offset;
+        Encoding::LittleEndian::Reader reader(record, fileSize - offset);
+
+        uint32_t crc      = 0;
+        uint8_t type      = 0;
+        uint16_t keyLen   = 0;
+        uint32_t valueLen = 0;
+        if (!reader.Read32(&crc).Read8(&type).Read16(&keyLen).Read32(&valueLen).IsSuccess() ||
+            !reader.HasAtLeast(static_cast<size_t>(keyLen) + valueLen))
+        {
+            break;
+        }
+
+        const size_t recordSize = RecordSize(keyLen, valueLen);
+        if (ComputeCrc32(record + sizeof(crc), recordSize - sizeof(crc)) != crc)
+        {
+            break;
+        }
+
+        std::string key(reinterpret_cast<const char *>(record + kRecordHeaderSize), keyLen);
+        const uint8_t * value = record + kRecordHeaderSize + keyLen;
+        auto existing         = mEntries.find(key);
+        if (existing != mEntries.end())
+        {
+            mLiveSize -= RecordSize(existing->first.size(), existing->second.size());
+        }
+
+        switch (static_cast<RecordType>(type))
+        {
+        case RecordType::kPut:
+            mEntries[key].assign(value, value + valueLen);
+            mLiveSize += recordSize;
+            break;
+        case RecordType::kDelete:
+            if (existing != mEntries.end())
+            {
+                mEntries.erase(existing);
+            }
+            break;
+        default:
+            // A complete record this version does not know: do not discard anything.
+            ChipLogError(DeviceLayer, "Unknown record type %u in KVS log file %s", type, mLogPath.c_str());
+            return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+        }
+
+        offset += recordSize;
+    }
+
+    if (offset < fileSize)
+    {
+        // The last write did not complete, or was damaged. Drop what is left of it, so that new records are appended
+        // after the last valid one.
+        ChipLogError(DeviceLayer, "Discarding %u bytes of incomplete or corrupted record at the end of %s",
+                     static_cast<unsigned>(fileSize - offset), mLogPath.c_str());
+        VerifyOrReturnError(ftruncate(mFd, static_cast<off_t>(offset)) == 0, CHIP_ERROR_WRITE_FAILED);
+        VerifyOrReturnError(fsync(mFd) == 0, CHIP_ERROR_WRITE_FAILED);
+    }
+
+    VerifyOrReturnError(lseek(mFd, static_cast<off_t>(offset), SEEK_SET) == static_cast<off_t>(offset), CHIP_ERROR_READ_FAILED);
+    mLogSize = offset;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mEntries.find(key);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    outLen = it->second.size();
+    VerifyOrReturnError(outLen <= bufSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+    if (outLen > 0)
+    {
+        memcpy(buf, it->second.data(), outLen);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::WriteValueBin(const char * key, const uint8_t * data, size_t dataLen)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(data != nullptr || dataLen == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(CanCastTo<uint32_t>(dataLen), CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    std::string keyString(key);
+    ReturnErrorOnFailure(AppendRecord(RecordType::kPut, keyString, data, dataLen));
+
+    auto result  = mEntries.emplace(std::move(keyString), std::vector<uint8_t>());
+    auto & entry = *result.first;
+    if (!result.second)
+    {
+        // The previous record of the key is now obsolete.
+        mLiveSize -= RecordSize(entry.first.size(), entry.second.size());
+    }
+    mLiveSize += RecordSize(entry.first.size(), dataLen);
+    entry.second.assign(data, data + dataLen);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::ClearValue(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mEntries.find(key);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    ReturnErrorOnFailure(AppendRecord(RecordType::kDelete, it->first, nullptr, 0));
+
+    mLiveSize -= RecordSize(it->first.size(), it->second.size());
+    mEntries.erase(it);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::ClearAll()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    mEntries.clear();
+    mLiveSize = sizeof(kLogFileHeader);
+
+    return CompactLocked();
+}
+
+bool ChipLinuxStorageLog::HasValue(const char * key)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    return key != nullptr && mEntries.find(key) != mEntries.end();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Commit()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    if (mLogSize >= CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_MIN_BYTES &&
+        mLogSize / CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_RATIO > mLiveSize)
+    {
+        // The new file holds everything that was appended, so it makes the pending records durable as well.
+        return CompactLocked();
+    }
+
+    if (mDirty)
+    {
+        VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_WRITE_FAILED);
+        mDirty = false;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Compact()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    return CompactLocked();
+}
+
+size_t ChipLinuxStorageLog::RecordSize(size_t keyLen, size_t valueLen)
+{
+    return kRecordHeaderSize + keyLen + valueLen;
+}
+
+void ChipLinuxStorageLog::EncodeRecord(RecordType type, const std::string & key, const uint8_t * value, size_t valueLen,
+                                       std::vector<uint8_t> & out)
+{
+    const size_t start = out.size();
+    out.resize(start + RecordSize(key.size(), valueLen));
+    uint8_t * record = out.data() + start;
+
+    Encoding::LittleEndian::BufferWriter writer(record + sizeof(uint32_t), RecordSize(key.size(), valueLen) - sizeof(uint32_t));
+    writer.Put8(to_underlying(type))
+        .Put16(static_cast<uint16_t>(key.size()))
+        .Put32(static_cast<uint32_t>(valueLen))
+        .Put(key.data(), key.size());
+    if (valueLen > 0)
+    {
+        writer.Put(value, valueLen);
+    }
+
+    Encoding::LittleEndian::BufferWriter(record, sizeof(uint32_t)).Put32(ComputeCrc32(writer.Buffer(), writer.Needed()));
+}
+
+CHIP_ERROR ChipLinuxStorageLog::AppendRecord(RecordType type, const std::string & key, const uint8_t * value, size_t valueLen)
+{
+    VerifyOrReturnError(CanCastTo<uint16_t>(key.size()), CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::vector<uint8_t> record;
+    EncodeRecord(type, key, value, valueLen, record);
+
+    CHIP_ERROR err = WriteFully(mFd, record.data(), record.size());
+    if (err != CHIP_NO_ERROR)
+    {
+        // Do not leave a partial record behind: records appended after it would be lost when the log is next loaded.
+        if (ftruncate(mFd, static_cast<off_t>(mLogSize)) != 0 || lseek(mFd, static_cast<off_t>(mLogSize), SEEK_SET) == -1)
+        {
+            ChipLogError(DeviceLayer, "failed to roll back KVS log file (%s), %s (%d)", mLogPath.c_str(), strerror(errno), errno);
+        }
+        return err;
+    }
+
+    mLogSize += record.size();
+    mDirty = true;
+
+    return CHIP_NO_ERROR;
+}
+
+// Like ChipLinuxStorageIni::CommitConfig, the log is replaced atomically and durably by writing the live records to a
+// temporary file, syncing it and then renaming it over the log.
+CHIP_ERROR ChipLinuxStorageLog::CompactLocked()
+{
+    std::vector<uint8_t> contents(kLogFileHeader, kLogFileHeader + sizeof(kLogFileHeader));
+    contents.reserve(mLiveSize);
+    for (const auto & entry : mEntries)
+    {
+        EncodeRecord(RecordType::kPut, entry.first, entry.second.data(), entry.second.size(), contents);
+    }
+
+    std::string tmpPath = mLogPath + "-XXXXXX";
+    int fd              = mkostemp(&tmpPath[0], O_CLOEXEC);
+    if (fd == -1)
+    {
+        ChipLogError(DeviceLayer, "failed to open file (%s) for writing", tmpPath.c_str());
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = WriteFully(fd, contents.data(), contents.size());
+    if (err == CHIP_NO_ERROR && fsync(fd) != 0)
+    {
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (err == CHIP_NO_ERROR && rename(tmpPath.c_str(), mLogPath.c_str()) != 0)
+    {
+        ChipLogError(DeviceLayer, "failed to rename (%s), %s (%d)", tmpPath.c_str(), strerror(errno), errno);
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        close(fd);
+        unlink(tmpPath.c_str());
+        return err;
+    }
+
+    // The temporary file is now the log; keep appending to it.
+    close(mFd);
+    mFd       = fd;
+    mLogSize  = contents.size();
+    mLiveSize = contents.size();
+    mDirty    = false;
+
+    ChipLogProgress(DeviceLayer, "compacted KVS log file (%s) to %u bytes", mLogPath.c_str(), static_cast<unsigned>(mLogSize));
+
+    return SyncDirectory();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::WriteFully(int fd, const uint8_t * data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t count = write(fd, data, len);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            ChipLogError(DeviceLayer, "failed to write KVS log file (%s), %s (%d)", mLogPath.c_str(), strerror(errno), errno);
+            return CHIP_ERROR_WRITE_FAILED;
+        }
+        data += count;
+        len -= static_cast<size_t>(count);
+        mBytesWritten += static_cast<uint64_t>(count);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Makes the creation or replacement of the log file itself durable.
+CHIP_ERROR ChipLinuxStorageLog::SyncDirectory()
+{
+    const size_t separator = mLogPath.find_last_of('/');
+    std::string directory  = (separator == std::string::npos) ? "." : mLogPath.substr(0, separator + 1);
+
+    int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    VerifyOrReturnError(fd != -1, CHIP_ERROR_OPEN_FAILED);
+    int result = fsync(fd);
+    close(fd);
+
+    return (result == 0) ? CHIP_NO_ERROR : CHIP_ERROR_WRITE_FAILED;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines a log-structured key-value store for Linux.
+ *
+ *         Every change is appended to the storage file as a checksummed record,
+ *         so the cost of a write does not depend on the size of the store. An
+ *         in-memory index holds the current value of every key. The file is
+ *         compacted, by writing the live records to a new file that replaces it,
+ *         once obsolete records make up most of it.
+ *
+ *         A record that was not completely written when the process stopped is
+ *         detected by its checksum and discarded when the file is next opened.
+ *
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageLog
+{
+public:
+    ChipLinuxStorageLog() = default;
+    ~ChipLinuxStorageLog();
+
+    ChipLinuxStorageLog(const ChipLinuxStorageLog &)             = delete;
+    ChipLinuxStorageLog & operator=(const ChipLinuxStorageLog &) = delete;
+
+    /**
+     * Open the log at the given path, creating it if needed, and load its records.
+     */
+    CHIP_ERROR Init(const char * logFile);
+
+    /**
+     * Close the log. Init() may be called again afterwards.
+     */
+    void Shutdown();
+
+    /**
+     * Read a value. Returns CHIP_ERROR_BUFFER_TOO_SMALL, with outLen set to the size of the value, if it does not fit
+     * into the buffer, and CHIP_ERROR_KEY_NOT_FOUND if there is no such key.
+     */
+    CHIP_ERROR ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen);
+
+    /**
+     * Append a new value for the key to the log. It is durable once Commit() returns.
+     */
+    CHIP_ERROR WriteValueBin(const char * key, const uint8_t * data, size_t dataLen);
+
+    /**
+     * Append the removal of the key to the log. It is durable once Commit() returns.
+     */
+    CHIP_ERROR ClearValue(const char * key);
+
+    /**
+     * Remove all the keys. Replaces the log with an empty one.
+     */
+    CHIP_ERROR ClearAll();
+
+    /**
+     * Flush the records appended since the last call to the storage device, then compact the log if it has grown
+     * too large.
+     */
+    CHIP_ERROR Commit();
+
+    /**
+     * Replace the log with one holding only the current value of each key.
+     */
+    CHIP_ERROR Compact();
+
+    bool HasValue(const char * key);
+
+    /**
+     * Current size of the log file.
+     */
+    size_t GetLogSize() const { return mLogSize; }
+
+    /**
+     * Total number of bytes written to storage since Init(), compactions included.
+     */
+    uint64_t GetBytesWritten() const { return mBytesWritten; }
+
+private:
+    enum class RecordType : uint8_t
+    {
+        kPut    = 1,
+        kDelete = 2,
+    };
+
+    static size_t RecordSize(size_t keyLen, size_t valueLen);
+    static void EncodeRecord(RecordType type, const std::string & key, const uint8_t * value, size_t valueLen,
+                             std::vector<uint8_t> & out);
+
+    CHIP_ERROR Load();
+    CHIP_ERROR AppendRecord(RecordType type, const std::string & key, const uint8_t * value, size_t valueLen);
+    CHIP_ERROR CompactLocked();
+    CHIP_ERROR WriteFully(int fd, const uint8_t * data, size_t len);
+    CHIP_ERROR SyncDirectory();
+
+    std::mutex mLock;
+    std::string mLogPath;
+    int mFd = -1;
+
+    // Current value of each key.
+    std::unordered_map<std::string, std::vector<uint8_t>> mEntries;
+
+    // Size of the log file, and the size it would have if it only held live records.
+    size_t mLogSize  = 0;
+    size_t mLiveSize = 0;
+
+    uint64_t mBytesWritten = 0;
+    bool mDirty            = false;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
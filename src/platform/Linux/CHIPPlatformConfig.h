@@ -64,6 +64,14 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+#define CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX 1
+#endif // CHIP_CONFIG_ACCESS_CONTROL_CHECK_INDEX
+
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE
+#define CHIP_CONFIG_GROUP_SESSION_CACHE 1
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_KVS_PATH
@@ -0,0 +1,303 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the log-structured
+ *      key-value store of the Linux platform.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr char kLogPathTemplate[] = "/tmp/chip_kvs_log_test-XXXXXX";
+constexpr char kIniPathTemplate[] = "/tmp/chip_kvs_ini_test-XXXXXX";
+
+size_t FileSize(const char * path)
+{
+    struct stat st;
+    return (stat(path, &st) == 0) ? static_cast<size_t>(st.st_size) : 0;
+}
+
+class TestLinuxStorageLog : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    // Each test gets its own empty files, so that tests running concurrently do not share them.
+    void SetUp() override
+    {
+        ASSERT_TRUE(MakeTempFile(kLogPathTemplate, mLogPath));
+        ASSERT_TRUE(MakeTempFile(kIniPathTemplate, mIniPath));
+    }
+    void TearDown() override
+    {
+        mStorage.Shutdown();
+        unlink(mLogPath);
+        unlink(mIniPath);
+    }
+
+protected:
+    static bool MakeTempFile(const char * pathTemplate, char * path)
+    {
+        strcpy(path, pathTemplate);
+        int fd = mkstemp(path);
+        if (fd == -1)
+        {
+            return false;
+        }
+        close(fd);
+        return true;
+    }
+
+    char mLogPath[sizeof(kLogPathTemplate)];
+    char mIniPath[sizeof(kIniPathTemplate)];
+    ChipLinuxStorageLog mStorage;
+};
+
+} // namespace
+
+TEST_F(TestLinuxStorageLog, PutGetDelete)
+{
+    const uint8_t value[]        = { 1, 2, 3, 4, 5 };
+    const uint8_t updatedValue[] = { 6, 7 };
+    uint8_t readValue[sizeof(value)];
+    size_t readSize = 0;
+
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.ReadValueBin("key", readValue, sizeof(readValue), readSize), CHIP_ERROR_KEY_NOT_FOUND);
+
+    EXPECT_EQ(mStorage.WriteValueBin("key", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.WriteValueBin("empty", nullptr, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+    EXPECT_TRUE(mStorage.HasValue("key"));
+    EXPECT_TRUE(mStorage.HasValue("empty"));
+
+    EXPECT_EQ(mStorage.ReadValueBin("key", readValue, sizeof(readValue), readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, sizeof(value));
+    EXPECT_EQ(memcmp(readValue, value, sizeof(value)), 0);
+
+    // Too small a buffer reports the size of the value.
+    EXPECT_EQ(mStorage.ReadValueBin("key", nullptr, 0, readSize), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(readSize, sizeof(value));
+    EXPECT_EQ(mStorage.ReadValueBin("empty", nullptr, 0, readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, 0u);
+
+    EXPECT_EQ(mStorage.WriteValueBin("key", updatedValue, sizeof(updatedValue)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.ReadValueBin("key", readValue, sizeof(readValue), readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, sizeof(updatedValue));
+    EXPECT_EQ(memcmp(readValue, updatedValue, sizeof(updatedValue)), 0);
+
+    EXPECT_EQ(mStorage.ClearValue("key"), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.ClearValue("key"), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_FALSE(mStorage.HasValue("key"));
+    EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(mStorage.ClearAll(), CHIP_NO_ERROR);
+    EXPECT_FALSE(mStorage.HasValue("empty"));
+}
+
+TEST_F(TestLinuxStorageLog, PersistsAcrossReopen)
+{
+    const uint8_t value[] = { 0xAA, 0xBB, 0xCC };
+    uint8_t readValue[sizeof(value)];
+    size_t readSize = 0;
+
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.WriteValueBin("kept", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.WriteValueBin("removed", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.ClearValue("removed"), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+    mStorage.Shutdown();
+
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.ReadValueBin("kept", readValue, sizeof(readValue), readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(readSize, sizeof(value));
+    EXPECT_EQ(memcmp(readValue, value, sizeof(value)), 0);
+    EXPECT_FALSE(mStorage.HasValue("removed"));
+}
+
+TEST_F(TestLinuxStorageLog, DiscardsIncompleteRecord)
+{
+    const uint8_t value[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    size_t readSize       = 0;
+
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.WriteValueBin("first", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+    const size_t completeSize = mStorage.GetLogSize();
+    EXPECT_EQ(mStorage.WriteValueBin("second", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+    mStorage.Shutdown();
+
+    // Simulate a crash in the middle of writing the second record.
+    ASSERT_EQ(truncate(mLogPath, static_cast<off_t>(FileSize(mLogPath) - 3)), 0);
+
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    EXPECT_TRUE(mStorage.HasValue("first"));
+    EXPECT_FALSE(mStorage.HasValue("second"));
+    EXPECT_EQ(mStorage.GetLogSize(), completeSize);
+    EXPECT_EQ(FileSize(mLogPath), completeSize);
+
+    // Records appended after the recovery are kept.
+    EXPECT_EQ(mStorage.WriteValueBin("third", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+    mStorage.Shutdown();
+
+    // A record whose contents do not match its checksum is discarded as well.
+    FILE * file = fopen(mLogPath, "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fseek(file, -1, SEEK_END), 0);
+    fputc(0xFF, file);
+    fclose(file);
+
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    EXPECT_TRUE(mStorage.HasValue("first"));
+    EXPECT_FALSE(mStorage.HasValue("third"));
+    EXPECT_EQ(mStorage.ReadValueBin("first", nullptr, 0, readSize), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(readSize, sizeof(value));
+}
+
+TEST_F(TestLinuxStorageLog, RejectsForeignFile)
+{
+    FILE * file = fopen(mLogPath, "w");
+    ASSERT_NE(file, nullptr);
+    fputs("[DEFAULT]\nkey=value\n", file);
+    fclose(file);
+
+    EXPECT_EQ(mStorage.Init(mLogPath), CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    EXPECT_EQ(mStorage.WriteValueBin("key", nullptr, 0), CHIP_ERROR_INCORRECT_STATE);
+}
+
+TEST_F(TestLinuxStorageLog, CompactsObsoleteRecords)
+{
+    uint8_t value[64] = {};
+    uint8_t readValue[sizeof(value)];
+    size_t readSize = 0;
+
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.WriteValueBin("static", value, sizeof(value)), CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < 4 * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_MIN_BYTES / sizeof(value); i++)
+    {
+        memcpy(value, &i, sizeof(i));
+        EXPECT_EQ(mStorage.WriteValueBin("counter", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+        EXPECT_LT(mStorage.GetLogSize(), CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_MIN_BYTES + 128u);
+    }
+    EXPECT_EQ(FileSize(mLogPath), mStorage.GetLogSize());
+
+    mStorage.Shutdown();
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    EXPECT_TRUE(mStorage.HasValue("static"));
+    EXPECT_EQ(mStorage.ReadValueBin("counter", readValue, sizeof(readValue), readSize), CHIP_NO_ERROR);
+    EXPECT_EQ(memcmp(readValue, value, sizeof(value)), 0);
+
+    EXPECT_EQ(mStorage.Compact(), CHIP_NO_ERROR);
+    EXPECT_LT(mStorage.GetLogSize(), 2 * sizeof(value) + 64);
+}
+
+TEST_F(TestLinuxStorageLog, DoesNotCompactLiveRecords)
+{
+    const uint8_t value[] = { 1 };
+    char key[32];
+
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+
+    // Every record stays live, so the log never grows beyond its live size and must not be compacted, however
+    // large the record headers are compared to the values.
+    for (uint32_t i = 0; mStorage.GetLogSize() < 2 * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_MIN_BYTES; i++)
+    {
+        snprintf(key, sizeof(key), "f/1/k/%u", static_cast<unsigned>(i));
+        ASSERT_EQ(mStorage.WriteValueBin(key, value, sizeof(value)), CHIP_NO_ERROR);
+        ASSERT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+        ASSERT_EQ(mStorage.GetBytesWritten(), mStorage.GetLogSize());
+    }
+
+    // Neither once an explicit compaction has accounted for the live records again.
+    EXPECT_EQ(mStorage.Compact(), CHIP_NO_ERROR);
+    const uint64_t bytesWritten = mStorage.GetBytesWritten();
+    const size_t logSize        = mStorage.GetLogSize();
+    EXPECT_EQ(mStorage.WriteValueBin("f/1/k/new", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+    EXPECT_EQ(mStorage.GetBytesWritten() - bytesWritten, mStorage.GetLogSize() - logSize);
+}
+
+// Compares the bytes written to storage per update of a small counter, in a store that also holds other keys, with
+// the INI backend, which rewrites the whole file on every commit.
+TEST_F(TestLinuxStorageLog, WriteAmplification)
+{
+    constexpr size_t kOtherKeys   = 64;
+    constexpr size_t kValueLength = 128;
+    constexpr uint32_t kUpdates   = 1000;
+
+    uint8_t value[kValueLength];
+    memset(value, 0x5A, sizeof(value));
+    char key[32];
+
+    ChipLinuxStorage iniStorage;
+    ASSERT_EQ(iniStorage.Init(mIniPath), CHIP_NO_ERROR);
+    ASSERT_EQ(mStorage.Init(mLogPath), CHIP_NO_ERROR);
+    for (size_t i = 0; i < kOtherKeys; i++)
+    {
+        snprintf(key, sizeof(key), "f/1/k/%u", static_cast<unsigned>(i));
+        ASSERT_EQ(iniStorage.WriteValueBin(key, value, sizeof(value)), CHIP_NO_ERROR);
+        ASSERT_EQ(mStorage.WriteValueBin(key, value, sizeof(value)), CHIP_NO_ERROR);
+    }
+    ASSERT_EQ(iniStorage.Commit(), CHIP_NO_ERROR);
+    ASSERT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+
+    uint64_t iniBytes = 0;
+    for (uint32_t i = 0; i < kUpdates; i++)
+    {
+        ASSERT_EQ(iniStorage.WriteValueBin("g/gcc", reinterpret_cast<const uint8_t *>(&i), sizeof(i)), CHIP_NO_ERROR);
+        ASSERT_EQ(iniStorage.Commit(), CHIP_NO_ERROR);
+        iniBytes += FileSize(mIniPath);
+    }
+
+    const uint64_t logBytesBefore = mStorage.GetBytesWritten();
+    for (uint32_t i = 0; i < kUpdates; i++)
+    {
+        ASSERT_EQ(mStorage.WriteValueBin("g/gcc", reinterpret_cast<const uint8_t *>(&i), sizeof(i)), CHIP_NO_ERROR);
+        ASSERT_EQ(mStorage.Commit(), CHIP_NO_ERROR);
+    }
+    const uint64_t logBytes = mStorage.GetBytesWritten() - logBytesBefore;
+
+    uint32_t readCounter = 0;
+    size_t readSize      = 0;
+    EXPECT_EQ(mStorage.ReadValueBin("g/gcc", reinterpret_cast<uint8_t *>(&readCounter), sizeof(readCounter), readSize),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(readCounter, kUpdates - 1);
+    EXPECT_LT(logBytes, iniBytes);
+}
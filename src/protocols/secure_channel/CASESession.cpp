@@ -401,6 +401,19 @@ void CASESession::Clear()
         mHandleSigma3Helper.reset();
     }
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    if (mPeerConnState != nullptr)
+    {
+        // Release the hold of this session on the connection, whatever state it
+        // is in. Other sessions may share the connection; otherwise it is
+        // aborted if it is still being set up, and closed if it is established.
+        mSessionManager->TCPDisconnect(mPeerConnState,
+                                       /* shouldAbort = */ mPeerConnState->mConnectionState != Transport::TCPState::kConnected,
+                                       &mTCPConnCbCtxt);
+        mPeerConnState = nullptr;
+    }
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
     // This function zeroes out and resets the memory used by the object.
     // It's done so that no security related information will be leaked.
     mCommissioningHash.Clear();
@@ -427,14 +440,6 @@ void CASESession::Clear()
     mTCPConnCbCtxt.connCompleteCb = nullptr;
     mTCPConnCbCtxt.connClosedCb   = nullptr;
     mTCPConnCbCtxt.connReceivedCb = nullptr;
-
-    if (mPeerConnState && mPeerConnState->mConnectionState != Transport::TCPState::kConnected)
-    {
-        // Abort the connection if the CASESession is being destroyed and the
-        // connection is in the middle of being set up.
-        mSessionManager->TCPDisconnect(mPeerConnState, /* shouldAbort = */ true);
-        mPeerConnState = nullptr;
-    }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 }
 
@@ -736,8 +741,9 @@ exit:
         // not holding on to a stale ActiveTCPConnectionState. We call
         // TCPDisconnect() here explicitly in order to abort the connection
         // even after it establishes successfully, but SendSigma1() fails for
-        // some reason.
-        caseSession->mSessionManager->TCPDisconnect(conn, /* shouldAbort = */ true);
+        // some reason. A connection that other sessions share is left open
+        // for them.
+        caseSession->mSessionManager->TCPDisconnect(conn, /* shouldAbort = */ true, &caseSession->mTCPConnCbCtxt);
         caseSession->mPeerConnState = nullptr;
 
         caseSession->Clear();
@@ -767,6 +773,18 @@ void CASESession::HandleConnectionClosed(Transport::ActiveTCPConnectionState * c
 }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
+void CASESession::HandOverTCPConnection()
+{
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    VerifyOrReturn(mPeerConnState != nullptr);
+
+    // The established secure session keeps the connection open once this
+    // CASESession is cleared.
+    mSecureSessionHolder->AsSecureSession()->HoldTCPConnection(&mTCPConnCbCtxt);
+    mPeerConnState = nullptr;
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+}
+
 CHIP_ERROR CASESession::SendSigma1()
 {
     MATTER_TRACE_SCOPE("SendSigma1", "CASESession");
@@ -1314,6 +1332,7 @@ CHIP_ERROR CASESession::HandleSigma2Resume(System::PacketBufferHandle && msg)
     SendStatusReport(mExchangeCtxt, kProtocolCodeSuccess);
 
     mState = State::kFinishedViaResume;
+    HandOverTCPConnection();
     Finish();
 
 exit:
@@ -1933,6 +1952,7 @@ CHIP_ERROR CASESession::HandleSigma3c(HandleSigma3Data & data, CHIP_ERROR status
     SendStatusReport(mExchangeCtxt, kProtocolCodeSuccess);
 
     mState = State::kFinished;
+    HandOverTCPConnection();
     Finish();
 
 exit:
@@ -2123,6 +2143,7 @@ void CASESession::OnSuccessStatusReport()
         break;
     }
 
+    HandOverTCPConnection();
     Finish();
 }
 
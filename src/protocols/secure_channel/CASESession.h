@@ -286,6 +286,10 @@ private:
 
     void InvalidateIfPendingEstablishmentOnFabric(FabricIndex fabricIndex);
 
+    // On success, hand the hold of this session on mPeerConnState over to the
+    // established secure session.
+    void HandOverTCPConnection();
+
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
     static void HandleConnectionAttemptComplete(Transport::ActiveTCPConnectionState * conn, CHIP_ERROR conErr);
     static void HandleConnectionClosed(Transport::ActiveTCPConnectionState * conn, CHIP_ERROR conErr);
@@ -43,6 +43,10 @@
 #include <messaging/tests/MessagingContext.h>
 #include <protocols/secure_channel/CASEServer.h>
 #include <protocols/secure_channel/CASESession.h>
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+#include <crypto/RandUtils.h>
+#include <transport/raw/TCP.h>
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
 #include "credentials/tests/CHIPCert_test_vectors.h"
 
@@ -78,6 +82,10 @@ public:
                                           TestCASESecurePairingDelegate & delegateCommissioner);
 
     void SimulateUpdateNOCInvalidatePendingEstablishment();
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    void SharedTCPConnectionRelease();
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 };
 
 void TestCASESession::ServiceEvents()
@@ -1085,6 +1093,90 @@ TEST_F_FROM_FIXTURE(TestCASESession, SimulateUpdateNOCInvalidatePendingEstablish
 }
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+namespace {
+unsigned gTCPConnectCompleteCount = 0;
+} // namespace
+
+TEST_F_FROM_FIXTURE(TestCASESession, SharedTCPConnectionRelease)
+{
+    using TCPImpl = Transport::TCP<2, 2>;
+
+    // The sessions connect over TCP to a transport of their own, listening on the loopback address.
+    const uint16_t port = static_cast<uint16_t>(CHIP_PORT + 100 + Crypto::GetRandU16() % 100);
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    TransportMgr<TCPImpl> tcpTransportMgr;
+    ASSERT_EQ(tcpTransportMgr.Init(Transport::TcpListenParameters(GetIOContext().GetTCPEndPointManager())
+                                       .SetAddressType(addr.Type())
+                                       .SetListenPort(port)),
+              CHIP_NO_ERROR);
+    TCPImpl & tcp = tcpTransportMgr.GetTransport().GetImplAtIndex<0>();
+
+    TestPersistentStorageDelegate storage;
+    SessionManager tcpSessionManager;
+    ASSERT_EQ(tcpSessionManager.Init(&GetSystemLayer(), &tcpTransportMgr, &GetMessageCounterManager(), &storage,
+                                     &GetFabricTable(), GetSessionKeystore()),
+              CHIP_NO_ERROR);
+
+    // Stand-ins for the CASE handshakes, which are not run here: the sessions only count that they are connected.
+    TestCASESecurePairingDelegate delegate;
+    CASESession first;
+    CASESession second;
+    gTCPConnectCompleteCount = 0;
+    for (CASESession * session : { &first, &second })
+    {
+        session->SetGroupDataProvider(&gCommissionerGroupDataProvider);
+        ASSERT_EQ(session->Init(tcpSessionManager, nullptr, &delegate, ScopedNodeId()), CHIP_NO_ERROR);
+        session->mTCPConnCbCtxt.connCompleteCb = [](ActiveTCPConnectionState * conn, CHIP_ERROR conErr) {
+            EXPECT_EQ(conErr, CHIP_NO_ERROR);
+            gTCPConnectCompleteCount++;
+        };
+    }
+
+    const PeerAddress peer = PeerAddress::TCP(addr, port);
+    EXPECT_EQ(tcpSessionManager.TCPConnect(peer, &first.mTCPConnCbCtxt, &first.mPeerConnState), CHIP_NO_ERROR);
+    GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), []() { return gTCPConnectCompleteCount == 1; });
+    EXPECT_EQ(tcpSessionManager.TCPConnect(peer, &second.mTCPConnCbCtxt, &second.mPeerConnState), CHIP_NO_ERROR);
+    GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), []() { return gTCPConnectCompleteCount == 2; });
+    EXPECT_EQ(gTCPConnectCompleteCount, 2u);
+
+    ActiveTCPConnectionState * conn = first.mPeerConnState;
+    ASSERT_NE(conn, nullptr);
+    EXPECT_EQ(second.mPeerConnState, conn);
+    EXPECT_EQ(conn->mReferenceCount, 2u);
+
+    // Tearing down the first session leaves the connection to the second one, with no trace of the first.
+    first.Clear();
+    EXPECT_EQ(first.mPeerConnState, nullptr);
+    EXPECT_TRUE(conn->IsConnected());
+    EXPECT_EQ(conn->mReferenceCount, 1u);
+    EXPECT_EQ(conn->mUsers[0].mAppState, &second.mTCPConnCbCtxt);
+    EXPECT_EQ(conn->mAppState, &second.mTCPConnCbCtxt);
+
+    // Once the second session is established, its secure session holds the connection in its place.
+    SessionHolder secureSession;
+    EXPECT_TRUE(secureSession.GrabPairingSession(second.mSecureSessionHolder.Get().Value()));
+    secureSession->AsSecureSession()->SetTCPConnection(conn);
+    second.HandOverTCPConnection();
+    EXPECT_EQ(second.mPeerConnState, nullptr);
+
+    second.Clear();
+    EXPECT_TRUE(conn->IsConnected());
+    EXPECT_EQ(conn->mReferenceCount, 1u);
+    EXPECT_NE(conn->mAppState, &second.mTCPConnCbCtxt);
+
+    // The connection is closed along with the last session that holds it.
+    secureSession.Release();
+    EXPECT_FALSE(conn->IsConnected());
+
+    tcpSessionManager.Shutdown();
+    tcpTransportMgr.Close();
+    GetIOContext().DriveIOUntil(System::Clock::Seconds16(5), [&tcp]() { return !tcp.HasActiveConnections(); });
+}
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
 class ExpectErrorExchangeDelegate : public ExchangeDelegate
 {
 public:
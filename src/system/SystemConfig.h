@@ -375,6 +375,42 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+ *
+ *  @brief
+ *      When packet buffers are allocated from the heap (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is 0), round each
+ *      allocation up to one of a few size classes, and keep freed buffers in per-class caches for reuse, so that steady-state
+ *      traffic does not allocate from the heap and small messages do not take full-size buffers.
+ *
+ *      Buffers larger than the largest class (i.e. large TCP buffers) are always allocated from the heap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+ *
+ *  @brief
+ *      With CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES, the number of free buffers of each size class that each thread
+ *      keeps for itself, without locking. Only used with POSIX locking; other configurations only use the shared cache.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE 16
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE
+ *
+ *  @brief
+ *      With CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES, the number of free buffers of each size class kept in the cache
+ *      shared by all threads. Buffers freed beyond this are returned to the heap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE 64
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LWIP_PBUF_RAM
  *
@@ -512,6 +548,34 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+ *
+ *  @brief
+ *      Store pending timers of the sockets-based System::Layer implementations in a hierarchical TimerWheel
+ *      instead of a sorted TimerList.
+ *
+ *  TimerList insertion and lookup by callback are O(n) in the number of pending timers, which is cheapest for the
+ *  handful of timers of a typical device. TimerWheel makes them O(1), at the cost of a few kilobytes of fixed
+ *  state, which pays off on controllers with thousands of pending timers.
+ *
+ *  Not supported together with CHIP_SYSTEM_CONFIG_USE_DISPATCH or CHIP_SYSTEM_CONFIG_USE_LIBEV, which delegate
+ *  timer expiration to the platform event loop.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#define CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL 0
+#endif /* CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_TIMER_WHEEL_INDEX_BITS
+ *
+ *  @brief
+ *      Log2 of the number of buckets in the TimerWheel (onComplete, appState) lookup index.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_TIMER_WHEEL_INDEX_BITS
+#define CHIP_SYSTEM_CONFIG_TIMER_WHEEL_INDEX_BITS 8
+#endif /* CHIP_SYSTEM_CONFIG_TIMER_WHEEL_INDEX_BITS */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
@@ -789,6 +853,32 @@ struct LwIPEvent;
 #endif
 #endif // CHIP_SYSTEM_CONFIG_USE_ZEPHYR_EVENTFD
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *      Maximum number of ready events retrieved by a single epoll_wait() call in LayerImplEpoll.
+ *
+ *  Events beyond this number are not lost; they are returned by the next loop iteration.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+#define CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS 64
+#endif // CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EPOLL_EDGE_TRIGGERED
+ *
+ *  @brief
+ *      Register socket watches with EPOLLET in LayerImplEpoll.
+ *
+ *  Edge-triggered watches only report a socket again once new data arrives, so every watch callback must drain
+ *  its socket until the read returns EAGAIN. Endpoints that consume a single datagram per callback must keep
+ *  this disabled (the default), which gives the same level-triggered semantics as LayerImplSelect.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EPOLL_EDGE_TRIGGERED
+#define CHIP_SYSTEM_CONFIG_EPOLL_EDGE_TRIGGERED 0
+#endif // CHIP_SYSTEM_CONFIG_EPOLL_EDGE_TRIGGERED
+
 /**
  * @def CHIP_SYSTEM_CONFIG_MAX_LARGE_BUFFER_SIZE_BYTES
  *
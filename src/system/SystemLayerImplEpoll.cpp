@@ -0,0 +1,550 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using Linux epoll() and timerfd.
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TimeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemFaultInjection.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+CHIP_ERROR LayerImplEpoll::Init()
+{
+    VerifyOrReturnError(mLayerState.SetInitializing(), CHIP_ERROR_INCORRECT_STATE);
+
+    RegisterPOSIXErrorFormatter();
+
+    for (auto & w : mSocketWatchPool)
+    {
+        w.Clear();
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+    struct epoll_event event = {};
+
+    mEpollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrExit(mEpollFd >= 0, err = CHIP_ERROR_POSIX(errno));
+
+    mTimerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    VerifyOrExit(mTimerFd >= 0, err = CHIP_ERROR_POSIX(errno));
+    mTimerFdArmed = false;
+
+    // The timerfd is the only registration without a SocketWatch; it is identified by a null data pointer.
+    event.events   = EPOLLIN;
+    event.data.ptr = nullptr;
+    VerifyOrExit(::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &event) == 0, err = CHIP_ERROR_POSIX(errno));
+
+    // Create an event to allow an arbitrary thread to wake the thread in the epoll loop.
+    SuccessOrExit(err = mWakeEvent.Open(*this));
+
+    VerifyOrExit(mLayerState.SetInitialized(), err = CHIP_ERROR_INCORRECT_STATE);
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        CloseFds();
+    }
+    return err;
+}
+
+void LayerImplEpoll::CloseFds()
+{
+    if (mTimerFd >= 0)
+    {
+        VerifyOrDie(::close(mTimerFd) == 0);
+        mTimerFd = kInvalidFd;
+    }
+    if (mEpollFd >= 0)
+    {
+        VerifyOrDie(::close(mEpollFd) == 0);
+        mEpollFd = kInvalidFd;
+    }
+    mTimerFdArmed = false;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(mLayerState.SetShuttingDown());
+
+    mTimerList.Clear();
+    mTimerPool.ReleaseAll();
+
+    mWakeEvent.Close(*this);
+
+    CloseFds();
+    mEpollResult = 0;
+
+    mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
+}
+
+void LayerImplEpoll::Signal()
+{
+    /*
+     * Wake up the I/O thread by notifying the wake event.
+     *
+     * If this is being called from within an I/O event callback, then the notification can be skipped, since the I/O thread
+     * is already awake and will re-evaluate timers in PrepareEvents() before waiting again.
+     */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(mHandleSelectThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    CHIP_ERROR status = mWakeEvent.Notify();
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "System wake event notify failed: %" CHIP_ERROR_FORMAT, status.Format());
+    }
+}
+
+CHIP_ERROR LayerImplEpoll::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, delay = System::Clock::kZero);
+
+    CancelTimer(onComplete, appState);
+
+    TimerQueue::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the timerfd needs to be re-armed before the next wait.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(delay.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout remainingTime = mTimerList.GetRemainingTime(onComplete, appState);
+    if (remainingTime.count() < delay.count())
+    {
+        if (remainingTime == Clock::kZero)
+        {
+            // If remaining time is Clock::kZero, it might possible that our timer is in
+            // the mExpiredTimers list and about to be fired. Remove it from that list, since we are extending it.
+            mExpiredTimers.Remove(onComplete, appState);
+        }
+        return StartTimer(delay, onComplete, appState);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool LayerImplEpoll::IsTimerActive(TimerCompleteCallback onComplete, void * appState)
+{
+    bool timerIsActive = (mTimerList.GetRemainingTime(onComplete, appState) > Clock::kZero);
+
+    if (!timerIsActive)
+    {
+        // check if the timer is in the mExpiredTimers list about to be fired.
+        for (TimerList::Node * timer = mExpiredTimers.Earliest(); timer != nullptr; timer = timer->mNextTimer)
+        {
+            if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState)
+            {
+                return true;
+            }
+        }
+    }
+
+    return timerIsActive;
+}
+
+Clock::Timeout LayerImplEpoll::GetRemainingTime(TimerCompleteCallback onComplete, void * appState)
+{
+    return mTimerList.GetRemainingTime(onComplete, appState);
+}
+
+void LayerImplEpoll::CancelTimer(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(mLayerState.IsInitialized());
+
+    TimerList::Node * timer = mTimerList.Remove(onComplete, appState);
+    if (timer == nullptr)
+    {
+        // The timer was not in our "will fire in the future" list, but it might
+        // be in the "we're about to fire these" chunk we already grabbed from
+        // that list.  Check for it there too, and if found there we still want
+        // to cancel it.
+        timer = mExpiredTimers.Remove(onComplete, appState);
+    }
+    VerifyOrReturn(timer != nullptr);
+
+    mTimerPool.Release(static_cast<TimerQueue::Node *>(timer));
+
+    // No need to Signal() here: a timerfd armed for a cancelled timer merely causes one spurious wakeup, after which
+    // PrepareEvents() re-arms it for the new earliest timer.
+}
+
+CHIP_ERROR LayerImplEpoll::ScheduleWork(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    // As in LayerImplSelect, use an expires-ASAP timer as a closure, and do NOT cancel previous timers
+    // with the same onComplete/appState, so ScheduleWork invocations don't stomp on each other.
+    TimerQueue::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StartWatchingSocket(int fd, SocketWatchToken * tokenOut)
+{
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Find a free slot.
+    SocketWatch * watch = nullptr;
+    for (auto & w : mSocketWatchPool)
+    {
+        if (w.mFD == fd)
+        {
+            // Duplicate registration is an error.
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        if ((w.mFD == kInvalidFd) && (watch == nullptr))
+        {
+            watch = &w;
+        }
+    }
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_ENDPOINT_POOL_FULL);
+
+    // Register the descriptor once, with no interest; interest is adjusted with EPOLL_CTL_MOD as callbacks are
+    // requested and cleared.
+    struct epoll_event event = {};
+    event.events             = EpollEventsFromSocketEvents(SocketEvents());
+    event.data.ptr           = watch;
+    VerifyOrReturnError(::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    watch->mFD = fd;
+
+    *tokenOut = reinterpret_cast<SocketWatchToken>(watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mCallback     = callback;
+    watch->mCallbackData = data;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    SocketEvents pendingIO = watch->mPendingIO;
+    return UpdateInterest(*watch, pendingIO.Set(SocketEventFlags::kRead));
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    SocketEvents pendingIO = watch->mPendingIO;
+    return UpdateInterest(*watch, pendingIO.Set(SocketEventFlags::kWrite));
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    SocketEvents pendingIO = watch->mPendingIO;
+    return UpdateInterest(*watch, pendingIO.Clear(SocketEventFlags::kRead));
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    SocketEvents pendingIO = watch->mPendingIO;
+    return UpdateInterest(*watch, pendingIO.Clear(SocketEventFlags::kWrite));
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    *tokenInOut         = InvalidSocketWatchToken();
+
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(watch->mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    // Failure here is not fatal: the descriptor is about to be closed, which also removes it from the epoll set.
+    if (::epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watch->mFD, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "epoll_ctl(DEL) failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+    }
+
+    // Any events for this watch already returned by epoll_wait() are dropped in HandleEvents(), because a
+    // cleared watch has no pending I/O interest.
+    watch->Clear();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::UpdateInterest(SocketWatch & watch, SocketEvents pendingIO)
+{
+    VerifyOrReturnError(watch.mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (pendingIO.Raw() == watch.mPendingIO.Raw())
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    struct epoll_event event = {};
+    event.events             = EpollEventsFromSocketEvents(pendingIO);
+    event.data.ptr           = &watch;
+    VerifyOrReturnError(::epoll_ctl(mEpollFd, EPOLL_CTL_MOD, watch.mFD, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    watch.mPendingIO = pendingIO;
+    return CHIP_NO_ERROR;
+}
+
+uint32_t LayerImplEpoll::EpollEventsFromSocketEvents(SocketEvents requested)
+{
+    uint32_t events = 0;
+
+    if (requested.Has(SocketEventFlags::kRead))
+    {
+        events |= EPOLLIN | EPOLLPRI;
+    }
+    if (requested.Has(SocketEventFlags::kWrite))
+    {
+        events |= EPOLLOUT;
+    }
+#if CHIP_SYSTEM_CONFIG_EPOLL_EDGE_TRIGGERED
+    events |= EPOLLET;
+#endif // CHIP_SYSTEM_CONFIG_EPOLL_EDGE_TRIGGERED
+
+    return events;
+}
+
+/**
+ *  Translate the events reported by epoll_wait() for a socket into the SocketEvents delivered to its callback.
+ *
+ *  Error and hang-up conditions are reported as readiness for whichever directions were requested, which matches
+ *  how select() reports such descriptors, so that endpoints discover the error from their next read or write.
+ *
+ *  @param[in]    epollEvents   The event mask reported by epoll_wait().
+ *
+ *  @param[in]    requested     The events the socket's owner currently wants callbacks for.
+ */
+SocketEvents LayerImplEpoll::SocketEventsFromEpollEvents(uint32_t epollEvents, SocketEvents requested)
+{
+    SocketEvents res;
+
+    const bool failed = (epollEvents & (EPOLLERR | EPOLLHUP)) != 0;
+
+    if (requested.Has(SocketEventFlags::kRead) && (failed || (epollEvents & EPOLLIN)))
+        res.Set(SocketEventFlags::kRead);
+    if (requested.Has(SocketEventFlags::kWrite) && (failed || (epollEvents & EPOLLOUT)))
+        res.Set(SocketEventFlags::kWrite);
+    if (requested.Has(SocketEventFlags::kRead) && (epollEvents & EPOLLPRI))
+        res.Set(SocketEventFlags::kExcept);
+
+    return res;
+}
+
+void LayerImplEpoll::ArmTimerFd(Clock::Timestamp awakenTime, Clock::Timestamp currentTime)
+{
+    // The timerfd is armed relative to the System::Clock rather than at an absolute CLOCK_MONOTONIC time,
+    // so that timers follow the configured clock (including the mock clock used by tests).
+    // A zero it_value would disarm the timerfd, so an already-expired timer is armed for the smallest possible delay.
+    const Clock::Microseconds64 delay =
+        (awakenTime > currentTime) ? Clock::Microseconds64(awakenTime - currentTime) : Clock::Microseconds64(0);
+
+    struct itimerspec spec = {};
+    spec.it_value.tv_sec   = static_cast<time_t>(delay.count() / kMicrosecondsPerSecond);
+    spec.it_value.tv_nsec  = static_cast<long>((delay.count() % kMicrosecondsPerSecond) * kNanosecondsPerMicrosecond);
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+    {
+        spec.it_value.tv_nsec = 1;
+    }
+
+    if (::timerfd_settime(mTimerFd, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        mTimerFdArmed = false;
+        return;
+    }
+
+    mTimerFdArmed      = true;
+    mTimerFdAwakenTime = awakenTime;
+}
+
+void LayerImplEpoll::DisarmTimerFd()
+{
+    VerifyOrReturn(mTimerFdArmed);
+
+    struct itimerspec spec = {};
+    if (::timerfd_settime(mTimerFd, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+    }
+    mTimerFdArmed = false;
+}
+
+void LayerImplEpoll::ConfirmTimerFd()
+{
+    uint64_t expirations;
+
+    if (::read(mTimerFd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+    {
+        ChipLogError(chipSystemLayer, "timerfd read failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+    }
+    mTimerFdArmed = false;
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    TimerList::Node * timer = mTimerList.Earliest();
+    if (timer == nullptr)
+    {
+        DisarmTimerFd();
+        return;
+    }
+
+    // Only touch the timerfd when the earliest deadline moved; the common case of an unchanged timer list costs
+    // no system call at all.
+    if (!mTimerFdArmed || timer->AwakenTime() != mTimerFdAwakenTime)
+    {
+        ArmTimerFd(timer->AwakenTime(), SystemClock().GetMonotonicTimestamp());
+    }
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    // Timers are delivered through the timerfd, so there is no need for a timeout here.
+    mEpollResult = ::epoll_wait(mEpollFd, mEvents, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS, -1);
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (!IsSelectResultValid())
+    {
+        // EINTR is expected, e.g. when a debugger attaches; anything else is worth reporting.
+        if (errno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        }
+        return;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    for (int i = 0; i < mEpollResult; i++)
+    {
+        if (mEvents[i].data.ptr == nullptr)
+        {
+            ConfirmTimerFd();
+        }
+    }
+
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(static_cast<TimerQueue::Node *>(timer));
+    }
+
+    for (int i = 0; i < mEpollResult; i++)
+    {
+        SocketWatch * watch = static_cast<SocketWatch *>(mEvents[i].data.ptr);
+        if (watch == nullptr || watch->mFD == kInvalidFd)
+        {
+            // Either the timerfd, or a watch stopped by an earlier callback in this pass.
+            continue;
+        }
+
+        SocketEvents events = SocketEventsFromEpollEvents(mEvents[i].events, watch->mPendingIO);
+        if (events.HasAny() && watch->mCallback != nullptr)
+        {
+            watch->mCallback(events, watch->mCallbackData);
+        }
+    }
+    mEpollResult = 0;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+void LayerImplEpoll::SocketWatch::Clear()
+{
+    mFD = kInvalidFd;
+    mPendingIO.ClearAll();
+    mCallback     = nullptr;
+    mCallbackData = 0;
+}
+
+} // namespace System
+} // namespace chip
@@ -44,6 +44,10 @@
 #endif
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL && (CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV)
+#error "CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL cannot be combined with CHIP_SYSTEM_CONFIG_USE_DISPATCH or CHIP_SYSTEM_CONFIG_USE_LIBEV"
+#endif
+
 #include <lib/support/ObjectLifeCycle.h>
 #include <system/SystemLayer.h>
 #include <system/SystemTimer.h>
@@ -128,8 +132,14 @@ protected:
     };
     SocketWatch mSocketWatchPool[kSocketWatchMax];
 
-    TimerPool<TimerList::Node> mTimerPool;
-    TimerList mTimerList;
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    using TimerQueue = TimerWheel;
+#else
+    using TimerQueue = TimerList;
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+    TimerPool<TimerQueue::Node> mTimerPool;
+    TimerQueue mTimerList;
     // List of expired timers being processed right now.  Stored in a member so
     // we can cancel them.
     TimerList mExpiredTimers;
@@ -58,6 +58,10 @@
 #include <lib/support/CHIPMem.h>
 #endif
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+#include <system/SystemPacketBufferSlab.h>
+#endif
+
 namespace chip {
 namespace System {
 
@@ -138,13 +142,22 @@ void PacketBufferHandle::InternalRightSize()
     const uint8_t * const start   = mBuffer->ReserveStart();
     const uint8_t * const payload = mBuffer->Start();
     const size_t usedSize         = static_cast<size_t>(payload - start + static_cast<ptrdiff_t>(mBuffer->len));
-    if (usedSize + kRightSizingThreshold > mBuffer->alloc_size)
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    size_t newAllocSize = PacketBufferSlabAllocator::RoundUpAllocSize(usedSize);
+#else
+    size_t newAllocSize = usedSize;
+#endif
+    if (newAllocSize + kRightSizingThreshold > mBuffer->alloc_size)
     {
         return;
     }
 
-    const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    PacketBuffer * newBuffer = static_cast<PacketBuffer *>(PacketBufferSlabAllocator::Allocate(newAllocSize));
+#else
+    const size_t blockSize   = newAllocSize + PacketBuffer::kStructureSize;
     PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+#endif
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -157,7 +170,7 @@ void PacketBufferHandle::InternalRightSize()
     newBuffer->tot_len       = mBuffer->tot_len;
     newBuffer->len           = mBuffer->len;
     newBuffer->ref           = 1;
-    newBuffer->alloc_size    = usedSize;
+    newBuffer->alloc_size    = newAllocSize;
     memcpy(newStart, start, usedSize);
 
     PacketBuffer::Free(mBuffer);
@@ -574,7 +587,7 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
     // sumOfAvailAndReserved is no larger than sumOfSizes, which we checked can be cast to
     // size_t.
-    const size_t lAllocSize = static_cast<size_t>(sumOfAvailAndReserved);
+    size_t lAllocSize = static_cast<size_t>(sumOfAvailAndReserved);
     PacketBuffer * lPacket;
 
     CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_PacketBufferNew, return PacketBufferHandle());
@@ -613,6 +626,11 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
     UNLOCK_BUF_POOL();
 
+#elif CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    // Rounds lAllocSize up to the size of the block's size class.
+    lPacket = static_cast<PacketBuffer *>(PacketBufferSlabAllocator::Allocate(lAllocSize));
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
     // sumOfSizes is essentially (kStructureSize + lAllocSize) which we already
     // checked to fit in a size_t.
@@ -697,11 +715,16 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+#endif
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+            const size_t lAllocSize = aPacket->alloc_size;
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
+#elif CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+            PacketBufferSlabAllocator::Free(aPacket, lAllocSize);
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             chip::Platform::MemoryFree(aPacket);
 #endif
@@ -410,6 +410,7 @@ private:
     const uint8_t * ReserveStart() const;
 
     friend class PacketBufferHandle;
+    friend class PacketBufferSlabAllocator;
     friend class TestSystemPacketBuffer;
 };
 
@@ -38,6 +38,17 @@
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+ *
+ * True if heap-allocated packet buffers are rounded up to size classes and cached for reuse.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES 0
+#endif
+
 /**
  * CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
  *
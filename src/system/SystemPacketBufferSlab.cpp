@@ -0,0 +1,304 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the size-class allocator for the memory blocks of heap-allocated packet buffers.
+ */
+
+#include <system/SystemPacketBufferSlab.h>
+
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemMutex.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
+
+namespace chip {
+namespace System {
+
+namespace {
+
+// Allocation sizes of the size classes.  The smallest fits a standalone acknowledgement with its headers and reserve; the largest
+// is a full-size buffer.
+constexpr size_t kSizeClasses[]  = { 64, 128, 256, 512, 1024, PacketBuffer::kMaxSizeWithoutReserve };
+constexpr size_t kNumSizeClasses = ArraySize(kSizeClasses);
+static_assert(PacketBuffer::kMaxSizeWithoutReserve > 1024, "The size classes must be in increasing order");
+
+constexpr size_t kThreadCacheSize = CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE;
+constexpr size_t kSharedCacheSize = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE;
+static_assert(kThreadCacheSize > 0, "CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE must be positive");
+
+// Number of blocks moved at once between a thread cache and the shared cache.
+constexpr size_t kThreadCacheTransfer = (kThreadCacheSize + 1) / 2;
+
+// Returns kNumSizeClasses if the allocation size is larger than every size class.
+size_t SizeClassIndex(size_t allocSize)
+{
+    size_t index = 0;
+    while (index < kNumSizeClasses && kSizeClasses[index] < allocSize)
+    {
+        index++;
+    }
+    return index;
+}
+
+void * AllocateFromHeap(size_t blockSize)
+{
+    void * block = chip::Platform::MemoryAlloc(blockSize);
+    if (block != nullptr)
+    {
+        SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufBlocks);
+    }
+    return block;
+}
+
+void FreeToHeap(void * block)
+{
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufBlocks);
+    chip::Platform::MemoryFree(block);
+}
+
+// A free block is linked into its free list through its first word.
+struct FreeBlock
+{
+    FreeBlock * mNext;
+};
+
+class FreeList
+{
+public:
+    bool Empty() const { return mHead == nullptr; }
+    size_t Count() const { return mCount; }
+
+    void Push(void * block)
+    {
+        auto * freeBlock = static_cast<FreeBlock *>(block);
+        freeBlock->mNext = mHead;
+        mHead            = freeBlock;
+        mCount++;
+    }
+
+    void * Pop()
+    {
+        FreeBlock * freeBlock = mHead;
+        if (freeBlock != nullptr)
+        {
+            mHead = freeBlock->mNext;
+            mCount--;
+        }
+        return freeBlock;
+    }
+
+private:
+    FreeBlock * mHead = nullptr;
+    size_t mCount     = 0;
+};
+
+class SharedCache
+{
+public:
+    SharedCache() { Mutex::Init(mMutex); }
+
+    void Lock() { mMutex.Lock(); }
+    void Unlock() { mMutex.Unlock(); }
+
+    // Must be called with the lock held.  Returns false, without taking the block, if the cache is full.
+    bool Put(size_t index, void * block)
+    {
+        VerifyOrReturnValue(mLists[index].Count() < kSharedCacheSize, false);
+        mLists[index].Push(block);
+        return true;
+    }
+
+    // Must be called with the lock held.
+    void * Take(size_t index) { return mLists[index].Pop(); }
+
+private:
+    Mutex mMutex;
+    FreeList mLists[kNumSizeClasses];
+};
+
+SharedCache sSharedCache;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+// The free blocks kept by one thread.  They are accessed without locking, and handed to the shared cache in batches when the
+// thread has too many, or when it exits.
+class ThreadCache
+{
+public:
+    ~ThreadCache()
+    {
+        for (size_t index = 0; index < kNumSizeClasses; index++)
+        {
+            Flush(index, 0);
+        }
+    }
+
+    void * Take(size_t index)
+    {
+        FreeList & list = mLists[index];
+        if (list.Empty())
+        {
+            sSharedCache.Lock();
+            while (list.Count() < kThreadCacheTransfer)
+            {
+                void * block = sSharedCache.Take(index);
+                if (block == nullptr)
+                {
+                    break;
+                }
+                list.Push(block);
+            }
+            sSharedCache.Unlock();
+        }
+        return list.Pop();
+    }
+
+    void Put(size_t index, void * block)
+    {
+        if (mLists[index].Count() >= kThreadCacheSize)
+        {
+            Flush(index, kThreadCacheSize - kThreadCacheTransfer);
+        }
+        mLists[index].Push(block);
+    }
+
+    // Move blocks to the shared cache until `keep` remain; blocks that do not fit there go back to the heap.
+    void Flush(size_t index, size_t keep)
+    {
+        FreeList & list = mLists[index];
+        FreeList overflow;
+
+        sSharedCache.Lock();
+        while (list.Count() > keep)
+        {
+            void * block = list.Pop();
+            if (!sSharedCache.Put(index, block))
+            {
+                overflow.Push(block);
+            }
+        }
+        sSharedCache.Unlock();
+
+        while (!overflow.Empty())
+        {
+            SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufBlocksCached);
+            FreeToHeap(overflow.Pop());
+        }
+    }
+
+private:
+    FreeList mLists[kNumSizeClasses];
+};
+
+thread_local ThreadCache tThreadCache;
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+} // namespace
+
+void * PacketBufferSlabAllocator::Allocate(size_t & allocSize)
+{
+    const size_t index = SizeClassIndex(allocSize);
+    if (index == kNumSizeClasses)
+    {
+        return AllocateFromHeap(PacketBuffer::kStructureSize + allocSize);
+    }
+
+    allocSize = kSizeClasses[index];
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    void * block = tThreadCache.Take(index);
+#else
+    sSharedCache.Lock();
+    void * block = sSharedCache.Take(index);
+    sSharedCache.Unlock();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    if (block != nullptr)
+    {
+        SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufBlocksCached);
+        return block;
+    }
+
+    return AllocateFromHeap(PacketBuffer::kStructureSize + allocSize);
+}
+
+void PacketBufferSlabAllocator::Free(void * block, size_t allocSize)
+{
+    const size_t index = SizeClassIndex(allocSize);
+    if (index == kNumSizeClasses || kSizeClasses[index] != allocSize)
+    {
+        FreeToHeap(block);
+        return;
+    }
+
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufBlocksCached);
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    tThreadCache.Put(index, block);
+#else
+    sSharedCache.Lock();
+    const bool cached = sSharedCache.Put(index, block);
+    sSharedCache.Unlock();
+
+    if (!cached)
+    {
+        SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufBlocksCached);
+        FreeToHeap(block);
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+size_t PacketBufferSlabAllocator::RoundUpAllocSize(size_t allocSize)
+{
+    const size_t index = SizeClassIndex(allocSize);
+    return (index == kNumSizeClasses) ? allocSize : kSizeClasses[index];
+}
+
+void PacketBufferSlabAllocator::ReleaseCachedBlocks()
+{
+    for (size_t index = 0; index < kNumSizeClasses; index++)
+    {
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+        tThreadCache.Flush(index, 0);
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+        FreeList released;
+        sSharedCache.Lock();
+        for (void * block = sSharedCache.Take(index); block != nullptr; block = sSharedCache.Take(index))
+        {
+            released.Push(block);
+        }
+        sSharedCache.Unlock();
+
+        while (!released.Empty())
+        {
+            SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufBlocksCached);
+            FreeToHeap(released.Pop());
+        }
+    }
+}
+
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
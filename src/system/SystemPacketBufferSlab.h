@@ -0,0 +1,68 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares the size-class allocator for the memory blocks of heap-allocated packet buffers,
+ *      enabled by CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES.
+ */
+
+#pragma once
+
+#include <system/SystemPacketBufferInternal.h>
+
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+
+#include <stddef.h>
+
+namespace chip {
+namespace System {
+
+/**
+ *  Allocates the memory blocks of heap-allocated packet buffers.
+ *
+ *  A block holds a PacketBuffer structure followed by its reserve and data space (the "allocation size").  Requests up to a
+ *  full-size buffer are rounded up to one of a few size classes, and freed blocks are kept in per-class free lists for reuse:
+ *  a small cache for each thread (with POSIX locking), backed by a cache shared by all threads.  Larger requests go straight
+ *  to the heap.
+ */
+class PacketBufferSlabAllocator
+{
+public:
+    /**
+     *  Allocate a block for a packet buffer with the given allocation size.
+     *
+     *  @param[in,out] allocSize  The requested allocation size; on success, the allocation size of the block, which may be larger.
+     *
+     *  @returns the block, or nullptr if the heap is exhausted.
+     */
+    static void * Allocate(size_t & allocSize);
+
+    /// Free a block returned by Allocate(), given the allocation size that Allocate() returned.
+    static void Free(void * block, size_t allocSize);
+
+    /// The allocation size of the block that Allocate() would return for the given requested allocation size.
+    static size_t RoundUpAllocSize(size_t allocSize);
+
+    /// Return the free blocks cached by the calling thread and the shared cache to the heap.
+    static void ReleaseCachedBlocks();
+};
+
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
@@ -44,6 +44,10 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "Packet Buffers",
+#endif
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    "Packet buffer heap blocks",
+    "Cached packet buffer heap blocks",
 #endif
     "Timers",
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -38,6 +38,25 @@
 namespace chip {
 namespace System {
 
+namespace {
+
+unsigned LowestSetBit(uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+    unsigned bit = 0;
+    while ((bits & 1) == 0)
+    {
+        bits >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+} // namespace
+
 TimerList::Node * TimerList::Add(TimerList::Node * add)
 {
     VerifyOrDie(add != mEarliestTimer);
@@ -178,5 +197,379 @@ Clock::Timeout TimerList::GetRemainingTime(TimerCompleteCallback aOnComplete, vo
     return Clock::kZero;
 }
 
+bool TimerWheel::IsBefore(const Node * a, const Node * b)
+{
+    if (a->AwakenTime() != b->AwakenTime())
+    {
+        return a->AwakenTime() < b->AwakenTime();
+    }
+    return a->mSequence < b->mSequence;
+}
+
+size_t TimerWheel::IndexBucket(TimerCompleteCallback onComplete, void * appState)
+{
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(appState)) ^
+        (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(onComplete)) << 1);
+    // Fibonacci hashing: the top bits of the product depend on all bits of the key.
+    hash *= UINT64_C(0x9E3779B97F4A7C15);
+    return static_cast<size_t>(hash >> (64 - kIndexBits));
+}
+
+uint64_t TimerWheel::SlotStart(unsigned level, unsigned slot) const
+{
+    const unsigned levelShift = level * kSlotBits;
+    const unsigned upperShift = levelShift + kSlotBits;
+    const uint64_t upper      = (upperShift >= 64) ? 0 : (mCurrentTick & ~((UINT64_C(1) << upperShift) - 1));
+    return upper | (static_cast<uint64_t>(slot) << levelShift);
+}
+
+void TimerWheel::Place(Node * timer)
+{
+    const uint64_t tick = Tick(timer->AwakenTime());
+    const uint64_t diff = tick ^ mCurrentTick;
+
+    // The level is determined by the most significant bit in which the expiration differs from the current tick, so
+    // that every timer in a slot above level 0 expires strictly after the current slot of that level.
+    unsigned level = 0;
+    for (uint64_t d = diff >> kSlotBits; d != 0; d >>= kSlotBits)
+    {
+        level++;
+    }
+    const unsigned slot = static_cast<unsigned>((tick >> (level * kSlotBits)) & (kSlotsPerLevel - 1));
+
+    timer->mLevel = static_cast<uint8_t>(level);
+    timer->mSlot  = static_cast<uint8_t>(slot);
+
+    Node *& head = mSlots[level][slot];
+    if (head == nullptr)
+    {
+        timer->mSlotPrev = timer;
+        timer->mSlotNext = timer;
+        head             = timer;
+        mOccupied[level] |= (UINT64_C(1) << slot);
+        return;
+    }
+
+    // All timers in a level 0 slot expire at the same tick; keep them in insertion order so they fire in that order.
+    // Timers are usually added in order, so the search from the tail is normally O(1).
+    Node * after = head->mSlotPrev;
+    if (level == 0)
+    {
+        while (after->mSequence > timer->mSequence && after != head)
+        {
+            after = after->mSlotPrev;
+        }
+        if (after == head && head->mSequence > timer->mSequence)
+        {
+            // New head: insert before the current head, i.e. after the tail, and move the head.
+            after = head->mSlotPrev;
+            head  = timer;
+        }
+    }
+
+    timer->mSlotPrev            = after;
+    timer->mSlotNext            = after->mSlotNext;
+    after->mSlotNext->mSlotPrev = timer;
+    after->mSlotNext            = timer;
+}
+
+void TimerWheel::Unplace(Node * timer)
+{
+    Node *& head = mSlots[timer->mLevel][timer->mSlot];
+    if (timer->mSlotNext == timer)
+    {
+        head = nullptr;
+        mOccupied[timer->mLevel] &= ~(UINT64_C(1) << timer->mSlot);
+    }
+    else
+    {
+        timer->mSlotPrev->mSlotNext = timer->mSlotNext;
+        timer->mSlotNext->mSlotPrev = timer->mSlotPrev;
+        if (head == timer)
+        {
+            head = timer->mSlotNext;
+        }
+    }
+    timer->mSlotPrev = nullptr;
+    timer->mSlotNext = nullptr;
+}
+
+TimerWheel::Node * TimerWheel::DetachSlot(unsigned level, unsigned slot)
+{
+    Node * head = mSlots[level][slot];
+    mSlots[level][slot] = nullptr;
+    mOccupied[level] &= ~(UINT64_C(1) << slot);
+
+    // Break the circle, so the result is a nullptr-terminated chain through mSlotNext.
+    if (head != nullptr)
+    {
+        head->mSlotPrev->mSlotNext = nullptr;
+    }
+    return head;
+}
+
+void TimerWheel::Rebase(uint64_t tick)
+{
+    // Only needed when the clock moves backwards relative to the wheel (e.g. a mock clock is installed), so a full
+    // O(n) reinsertion is acceptable.
+    Node * all = nullptr;
+    for (unsigned level = 0; level < kLevels; level++)
+    {
+        while (mOccupied[level] != 0)
+        {
+            const unsigned slot = LowestSetBit(mOccupied[level]);
+            Node * chain        = DetachSlot(level, slot);
+            while (chain != nullptr)
+            {
+                Node * next     = chain->mSlotNext;
+                chain->mSlotNext = all;
+                all             = chain;
+                if (Tick(chain->AwakenTime()) < tick)
+                {
+                    tick = Tick(chain->AwakenTime());
+                }
+                chain = next;
+            }
+        }
+    }
+
+    mCurrentTick = tick;
+    while (all != nullptr)
+    {
+        Node * next = all->mSlotNext;
+        Place(all);
+        all = next;
+    }
+}
+
+TimerWheel::Node * TimerWheel::FindInIndex(TimerCompleteCallback onComplete, void * appState) const
+{
+    // Timers started with ScheduleWork() may share a callback; return the earliest, as TimerList does.
+    Node * found = nullptr;
+    for (Node * timer = mIndex[IndexBucket(onComplete, appState)]; timer != nullptr; timer = timer->mIndexNext)
+    {
+        if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState &&
+            (found == nullptr || IsBefore(timer, found)))
+        {
+            found = timer;
+        }
+    }
+    return found;
+}
+
+void TimerWheel::RemoveFromIndex(Node * timer)
+{
+    Node ** link = &mIndex[IndexBucket(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())];
+    while (*link != nullptr)
+    {
+        if (*link == timer)
+        {
+            *link             = timer->mIndexNext;
+            timer->mIndexNext = nullptr;
+            return;
+        }
+        link = &(*link)->mIndexNext;
+    }
+}
+
+TimerWheel::Node * TimerWheel::Add(Node * add)
+{
+    VerifyOrDie(add != nullptr && !add->mQueued);
+
+    const uint64_t tick = Tick(add->AwakenTime());
+    if (mCount == 0)
+    {
+        mCurrentTick = tick;
+    }
+    else if (tick < mCurrentTick)
+    {
+        Rebase(tick);
+    }
+
+    add->mSequence = mNextSequence++;
+    add->mQueued   = true;
+    Place(add);
+
+    Node *& bucket  = mIndex[IndexBucket(add->GetCallback().GetOnComplete(), add->GetCallback().GetAppState())];
+    add->mIndexNext = bucket;
+    bucket          = add;
+
+    mCount++;
+    if (mEarliestValid && (mEarliest == nullptr || IsBefore(add, mEarliest)))
+    {
+        mEarliest = add;
+    }
+
+    return Earliest();
+}
+
+TimerWheel::Node * TimerWheel::Remove(Node * remove)
+{
+    if (remove != nullptr && remove->mQueued)
+    {
+        Unplace(remove);
+        RemoveFromIndex(remove);
+        remove->mQueued = false;
+        mCount--;
+        if (remove == mEarliest)
+        {
+            mEarliestValid = false;
+        }
+    }
+    return Earliest();
+}
+
+TimerWheel::Node * TimerWheel::Remove(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = FindInIndex(aOnComplete, aAppState);
+    if (timer != nullptr)
+    {
+        Remove(timer);
+    }
+    return timer;
+}
+
+TimerWheel::Node * TimerWheel::PopEarliest()
+{
+    Node * earliest = Earliest();
+    if (earliest != nullptr)
+    {
+        Remove(earliest);
+    }
+    return earliest;
+}
+
+TimerWheel::Node * TimerWheel::Earliest()
+{
+    if (mEarliestValid)
+    {
+        return mEarliest;
+    }
+
+    // The lowest occupied slot of the lowest occupied level holds the earliest timers, since every timer in a higher
+    // level expires after that level's current slot. A level 0 slot is kept in order; other slots must be scanned.
+    mEarliest = nullptr;
+    for (unsigned level = 0; level < kLevels; level++)
+    {
+        if (mOccupied[level] != 0)
+        {
+            Node * head = mSlots[level][LowestSetBit(mOccupied[level])];
+            mEarliest   = head;
+            if (level != 0)
+            {
+                for (Node * timer = head->mSlotNext; timer != head; timer = timer->mSlotNext)
+                {
+                    if (IsBefore(timer, mEarliest))
+                    {
+                        mEarliest = timer;
+                    }
+                }
+            }
+            break;
+        }
+    }
+    mEarliestValid = true;
+    return mEarliest;
+}
+
+TimerList TimerWheel::ExtractEarlier(Clock::Timestamp t)
+{
+    TimerList out;
+    TimerList::Node * outTail = nullptr;
+    const uint64_t limit      = Tick(t);
+
+    while (mCount != 0)
+    {
+        unsigned level = 0;
+        while (mOccupied[level] == 0)
+        {
+            level++;
+        }
+        const unsigned slot  = LowestSetBit(mOccupied[level]);
+        const uint64_t start = SlotStart(level, slot);
+        if (start >= limit)
+        {
+            break;
+        }
+
+        // Advance the wheel to the start of the slot: it is the earliest non-empty one, so no timer is skipped.
+        mCurrentTick   = start;
+        mEarliestValid = false;
+        Node * chain   = DetachSlot(level, slot);
+
+        while (chain != nullptr)
+        {
+            Node * timer = chain;
+            chain        = chain->mSlotNext;
+
+            if (level == 0)
+            {
+                // Expired: the slot is in insertion order, and slots are visited in time order.
+                RemoveFromIndex(timer);
+                timer->mQueued    = false;
+                timer->mSlotPrev  = nullptr;
+                timer->mSlotNext  = nullptr;
+                timer->mNextTimer = nullptr;
+                mCount--;
+                if (outTail == nullptr)
+                {
+                    out.mEarliestTimer = timer;
+                }
+                else
+                {
+                    outTail->mNextTimer = timer;
+                }
+                outTail = timer;
+            }
+            else
+            {
+                // Cascade into a finer level, relative to the new current tick.
+                Place(timer);
+            }
+        }
+    }
+
+    return out;
+}
+
+void TimerWheel::Clear()
+{
+    for (auto & level : mSlots)
+    {
+        for (auto & slot : level)
+        {
+            slot = nullptr;
+        }
+    }
+    for (auto & occupied : mOccupied)
+    {
+        occupied = 0;
+    }
+    for (auto & bucket : mIndex)
+    {
+        bucket = nullptr;
+    }
+    mCurrentTick   = 0;
+    mNextSequence  = 0;
+    mCount         = 0;
+    mEarliest      = nullptr;
+    mEarliestValid = true;
+}
+
+Clock::Timeout TimerWheel::GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = FindInIndex(aOnComplete, aAppState);
+    if (timer != nullptr)
+    {
+        Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+
+        if (currentTime < timer->AwakenTime())
+        {
+            return Clock::Timeout(timer->AwakenTime() - currentTime);
+        }
+    }
+    return Clock::kZero;
+}
+
 } // namespace System
 } // namespace chip
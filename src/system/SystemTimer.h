@@ -186,9 +186,141 @@ public:
     Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
 
 private:
+    friend class TimerWheel;
+
     Node * mEarliestTimer;
 };
 
+/**
+ * Hierarchical timing wheel of `Timer`s, offering the same operations as TimerList.
+ *
+ * Timers are hashed into 64-slot levels of increasing granularity (1 ms, 64 ms, 4096 ms, ...) according to the
+ * most significant bit in which their expiration tick differs from the wheel's current tick, and are cascaded
+ * into finer levels as time advances. A second hash index keyed by (onComplete, appState) makes lookup by
+ * callback constant-time. Add, Remove and lookup by callback are O(1); a timer is cascaded at most once per level
+ * before it expires.
+ *
+ * Timers expiring at the same tick are returned in the order they were added, as with TimerList.
+ */
+class TimerWheel
+{
+public:
+    class Node : public TimerList::Node
+    {
+    public:
+        Node(Layer & systemLayer, System::Clock::Timestamp awakenTime, TimerCompleteCallback onComplete, void * appState) :
+            TimerList::Node(systemLayer, awakenTime, onComplete, appState)
+        {}
+
+    private:
+        friend class TimerWheel;
+
+        Node * mSlotPrev  = nullptr; // Circular, doubly-linked list of the timers in a wheel slot.
+        Node * mSlotNext  = nullptr;
+        Node * mIndexNext = nullptr; // Singly-linked chain of the timers in a callback index bucket.
+        uint64_t mSequence = 0;      // Insertion order, for stable ordering of timers with equal expiration times.
+        uint8_t mLevel     = 0;
+        uint8_t mSlot      = 0;
+        bool mQueued       = false;
+    };
+
+    TimerWheel() { Clear(); }
+
+    /**
+     * Add a timer to the wheel
+     *
+     * @return  The new earliest timer in the wheel. If this is the newly added timer, that implies it is earlier
+     *          than any existing timer.
+     */
+    Node * Add(Node * timer);
+
+    /**
+     * Remove the given timer from the wheel, if present. It is not an error for the timer not to be present.
+     *
+     * @return  The new earliest timer in the wheel, or nullptr if the wheel is empty.
+     */
+    Node * Remove(Node * remove);
+
+    /**
+     * Remove the first timer with the given properties, if present. It is not an error for no such timer to be present.
+     *
+     * @return  The removed timer, or nullptr if the wheel contains no matching timer.
+     */
+    Node * Remove(TimerCompleteCallback onComplete, void * appState);
+
+    /**
+     * Remove and return the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if the wheel is empty.
+     */
+    Node * PopEarliest();
+
+    /**
+     * Get the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if there are no timers.
+     */
+    Node * Earliest();
+
+    /**
+     * Test whether there are any timers.
+     */
+    bool Empty() const { return mCount == 0; }
+
+    /**
+     * Return the number of timers in the wheel.
+     */
+    size_t Count() const { return mCount; }
+
+    /**
+     * Remove and return all timers that expire before the given time @a t, ordered by expiration time.
+     */
+    TimerList ExtractEarlier(Clock::Timestamp t);
+
+    /**
+     * Remove all timers.
+     */
+    void Clear();
+
+    /**
+     * Find the timer with the given properties, if present, and return its remaining time
+     *
+     * @return The remaining time on this particular timer or 0 if not found.
+     */
+    Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
+
+private:
+    static constexpr unsigned kSlotBits      = 6;
+    static constexpr unsigned kSlotsPerLevel = 1u << kSlotBits;
+    // Enough levels to cover every 64-bit tick, so that no timer ever needs an overflow list.
+    static constexpr unsigned kLevels    = (64 + kSlotBits - 1) / kSlotBits;
+    static constexpr unsigned kIndexBits = CHIP_SYSTEM_CONFIG_TIMER_WHEEL_INDEX_BITS;
+    static constexpr size_t kIndexSize   = static_cast<size_t>(1) << kIndexBits;
+
+    static uint64_t Tick(Clock::Timestamp t) { return t.count(); }
+    static bool IsBefore(const Node * a, const Node * b);
+    static size_t IndexBucket(TimerCompleteCallback onComplete, void * appState);
+
+    uint64_t SlotStart(unsigned level, unsigned slot) const;
+    void Place(Node * timer);
+    void Unplace(Node * timer);
+    Node * DetachSlot(unsigned level, unsigned slot);
+    void Rebase(uint64_t tick);
+    Node * FindInIndex(TimerCompleteCallback onComplete, void * appState) const;
+    void RemoveFromIndex(Node * timer);
+
+    Node * mSlots[kLevels][kSlotsPerLevel];
+    uint64_t mOccupied[kLevels];
+    Node * mIndex[kIndexSize];
+    uint64_t mCurrentTick;
+    uint64_t mNextSequence;
+    size_t mCount;
+
+    // Cached result of Earliest(); recomputed lazily when the cached timer is removed.
+    Node * mEarliest;
+    bool mEarliestValid;
+};
+
 /**
  * ObjectPool wrapper that keeps System Timer statistics.
  */
@@ -0,0 +1,169 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for the size-class allocator of heap-allocated packet buffers
+ *      (CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES).
+ */
+
+#include <system/SystemPacketBufferInternal.h>
+
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <thread>
+#endif
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/SystemPacketBufferSlab.h>
+#include <system/SystemStats.h>
+
+using namespace chip::System;
+
+namespace {
+
+class TestSystemPacketBufferSlab : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite()
+    {
+        PacketBufferSlabAllocator::ReleaseCachedBlocks();
+        chip::Platform::MemoryShutdown();
+    }
+
+    // Start each test with empty caches, so the block counts only reflect the test's own buffers.
+    void SetUp() override { PacketBufferSlabAllocator::ReleaseCachedBlocks(); }
+};
+
+} // namespace
+
+TEST_F(TestSystemPacketBufferSlab, CheckSizeClasses)
+{
+    PacketBufferHandle ack = PacketBufferHandle::New(10, 0);
+    ASSERT_FALSE(ack.IsNull());
+    EXPECT_EQ(ack->AllocSize(), 64u);
+
+    PacketBufferHandle small = PacketBufferHandle::New(100, 20);
+    ASSERT_FALSE(small.IsNull());
+    EXPECT_EQ(small->AllocSize(), 128u);
+    EXPECT_EQ(small->ReservedSize(), 20u);
+    EXPECT_GE(small->AvailableDataLength(), 100u);
+
+    PacketBufferHandle full = PacketBufferHandle::New(PacketBuffer::kMaxSize);
+    ASSERT_FALSE(full.IsNull());
+    EXPECT_EQ(full->AllocSize(), PacketBuffer::kMaxSizeWithoutReserve);
+
+    EXPECT_EQ(PacketBufferSlabAllocator::RoundUpAllocSize(1), 64u);
+    EXPECT_EQ(PacketBufferSlabAllocator::RoundUpAllocSize(64), 64u);
+    EXPECT_EQ(PacketBufferSlabAllocator::RoundUpAllocSize(65), 128u);
+    EXPECT_EQ(PacketBufferSlabAllocator::RoundUpAllocSize(PacketBuffer::kMaxSizeWithoutReserve + 1),
+              PacketBuffer::kMaxSizeWithoutReserve + 1);
+}
+
+TEST_F(TestSystemPacketBufferSlab, CheckReuse)
+{
+    PacketBufferHandle buffer = PacketBufferHandle::New(200, 0);
+    ASSERT_FALSE(buffer.IsNull());
+    const PacketBuffer * block = buffer.Get();
+    buffer                     = nullptr;
+
+    // A freed block is reused for the next buffer of the same size class, even if the requested size differs.
+    buffer = PacketBufferHandle::New(150, 0);
+    ASSERT_FALSE(buffer.IsNull());
+    EXPECT_EQ(buffer.Get(), block);
+}
+
+TEST_F(TestSystemPacketBufferSlab, CheckRightSize)
+{
+    PacketBufferHandle buffer = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    ASSERT_FALSE(buffer.IsNull());
+    buffer->SetDataLength(100);
+
+    // Right-sizing moves the data to a block of the smallest size class that fits it.
+    buffer.RightSize();
+    EXPECT_EQ(buffer->AllocSize(), 128u);
+    EXPECT_EQ(buffer->DataLength(), 100u);
+}
+
+TEST_F(TestSystemPacketBufferSlab, CheckSteadyStateDoesNotAllocate)
+{
+    constexpr size_t kSizes[] = { 10, 50, 100, 300, 600, 1000, 1200, 20 };
+    PacketBufferHandle buffers[chip::ArraySize(kSizes)];
+
+    SYSTEM_STATS_RESET_HIGH_WATER_MARK_FOR_TESTING(Stats::kSystemLayer_NumPacketBufBlocks);
+
+    for (int round = 0; round < 100; round++)
+    {
+        for (size_t i = 0; i < chip::ArraySize(kSizes); i++)
+        {
+            buffers[i] = PacketBufferHandle::New(kSizes[i], 0);
+            ASSERT_FALSE(buffers[i].IsNull());
+        }
+        for (auto & buffer : buffers)
+        {
+            buffer = nullptr;
+        }
+    }
+
+    // Only the first round took blocks from the heap; they are all cached now.
+    EXPECT_TRUE(SYSTEM_STATS_TEST_HIGH_WATER_MARK(Stats::kSystemLayer_NumPacketBufBlocks, chip::ArraySize(kSizes)));
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumPacketBufBlocks, chip::ArraySize(kSizes)));
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumPacketBufBlocksCached, chip::ArraySize(kSizes)));
+
+    PacketBufferSlabAllocator::ReleaseCachedBlocks();
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumPacketBufBlocks, 0));
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumPacketBufBlocksCached, 0));
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+TEST_F(TestSystemPacketBufferSlab, CheckFreeOnOtherThread)
+{
+    constexpr size_t kBufferCount = 2 * CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE;
+    PacketBufferHandle buffers[kBufferCount];
+
+    for (auto & buffer : buffers)
+    {
+        buffer = PacketBufferHandle::New(40, 0);
+        ASSERT_FALSE(buffer.IsNull());
+    }
+
+    // Buffers freed by another thread reach the shared cache (at the latest when that thread exits)...
+    std::thread([&buffers] {
+        for (auto & buffer : buffers)
+        {
+            buffer = nullptr;
+        }
+    }).join();
+
+    // ...so this thread can reuse them without taking more blocks from the heap.
+    for (auto & buffer : buffers)
+    {
+        buffer = PacketBufferHandle::New(40, 0);
+        ASSERT_FALSE(buffer.IsNull());
+    }
+    EXPECT_TRUE(SYSTEM_STATS_TEST_IN_USE(Stats::kSystemLayer_NumPacketBufBlocks, kBufferCount));
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
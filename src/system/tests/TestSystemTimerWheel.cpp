@@ -0,0 +1,263 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for <tt>chip::System::TimerWheel</tt>,
+ *      including a comparison against <tt>chip::System::TimerList</tt>.
+ *
+ */
+
+#include <algorithm>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayerImpl.h>
+#include <system/SystemTimer.h>
+
+using namespace chip::System;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+void CallbackA(Layer * layer, void * state) {}
+void CallbackB(Layer * layer, void * state) {}
+
+void * AppState(uintptr_t n)
+{
+    return reinterpret_cast<void *>(n);
+}
+
+// Layer the timer nodes refer to; never initialized, since no callback is invoked.
+LayerImpl sLayer;
+
+class TestSystemTimerWheel : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(::chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { ::chip::Platform::MemoryShutdown(); }
+};
+
+template <typename Node>
+Node * NewTimer(Clock::Timestamp awakenTime, TimerCompleteCallback onComplete, void * appState)
+{
+    return chip::Platform::New<Node>(sLayer, awakenTime, onComplete, appState);
+}
+
+template <typename Node>
+void DeleteAll(TimerList & list)
+{
+    TimerList::Node * timer;
+    while ((timer = list.PopEarliest()) != nullptr)
+    {
+        chip::Platform::Delete(static_cast<Node *>(timer));
+    }
+}
+
+} // namespace
+
+TEST_F(TestSystemTimerWheel, CheckEmpty)
+{
+    TimerWheel wheel;
+    EXPECT_TRUE(wheel.Empty());
+    EXPECT_EQ(wheel.Earliest(), nullptr);
+    EXPECT_EQ(wheel.PopEarliest(), nullptr);
+    EXPECT_EQ(wheel.Remove(nullptr), nullptr);
+    EXPECT_EQ(wheel.Remove(CallbackA, nullptr), nullptr);
+    EXPECT_TRUE(wheel.ExtractEarlier(1000_ms).Empty());
+}
+
+TEST_F(TestSystemTimerWheel, CheckOrdering)
+{
+    using Timer = TimerWheel::Node;
+
+    // Spread the timers over several wheel levels.
+    Clock::Timestamp awakenTimes[] = { 111_ms, 100_ms, 202_ms, 70000_ms, 303_ms, 5000_ms, 100_ms };
+    Timer * timers[chip::ArraySize(awakenTimes)];
+
+    TimerWheel wheel;
+    for (size_t i = 0; i < chip::ArraySize(awakenTimes); i++)
+    {
+        timers[i] = NewTimer<Timer>(awakenTimes[i], CallbackA, AppState(i));
+        ASSERT_NE(timers[i], nullptr);
+    }
+
+    EXPECT_EQ(wheel.Add(timers[0]), timers[0]);
+    EXPECT_EQ(wheel.Add(timers[1]), timers[1]);
+    EXPECT_EQ(wheel.Add(timers[2]), timers[1]);
+    EXPECT_EQ(wheel.Add(timers[3]), timers[1]);
+    EXPECT_EQ(wheel.Add(timers[4]), timers[1]);
+    EXPECT_EQ(wheel.Add(timers[5]), timers[1]);
+    // Equal expiration time: the earlier-added timer stays first.
+    EXPECT_EQ(wheel.Add(timers[6]), timers[1]);
+    EXPECT_EQ(wheel.Count(), chip::ArraySize(awakenTimes));
+
+    TimerList early = wheel.ExtractEarlier(200_ms);
+    EXPECT_EQ(early.PopEarliest(), timers[1]);
+    EXPECT_EQ(early.PopEarliest(), timers[6]);
+    EXPECT_EQ(early.PopEarliest(), timers[0]);
+    EXPECT_EQ(early.PopEarliest(), nullptr);
+
+    EXPECT_EQ(wheel.Earliest(), timers[2]);
+
+    TimerList later = wheel.ExtractEarlier(100000_ms);
+    EXPECT_EQ(later.PopEarliest(), timers[2]);
+    EXPECT_EQ(later.PopEarliest(), timers[4]);
+    EXPECT_EQ(later.PopEarliest(), timers[5]);
+    EXPECT_EQ(later.PopEarliest(), timers[3]);
+    EXPECT_EQ(later.PopEarliest(), nullptr);
+    EXPECT_TRUE(wheel.Empty());
+
+    for (auto * timer : timers)
+    {
+        chip::Platform::Delete(timer);
+    }
+}
+
+TEST_F(TestSystemTimerWheel, CheckRemove)
+{
+    using Timer = TimerWheel::Node;
+
+    TimerWheel wheel;
+    Timer * a = NewTimer<Timer>(100_ms, CallbackA, AppState(1));
+    Timer * b = NewTimer<Timer>(200_ms, CallbackB, AppState(1));
+    Timer * c = NewTimer<Timer>(300_ms, CallbackA, AppState(2));
+    // Same callback and state as `a`, but later, as ScheduleWork() may create.
+    Timer * d = NewTimer<Timer>(400_ms, CallbackA, AppState(1));
+
+    wheel.Add(d);
+    wheel.Add(c);
+    wheel.Add(b);
+    wheel.Add(a);
+    EXPECT_EQ(wheel.Earliest(), a);
+
+    // Lookup by callback finds the earliest match.
+    EXPECT_EQ(wheel.Remove(CallbackA, AppState(1)), a);
+    EXPECT_EQ(wheel.Earliest(), b);
+    EXPECT_EQ(wheel.Remove(CallbackB, AppState(2)), nullptr);
+
+    EXPECT_EQ(wheel.Remove(b), c);
+    // Removing a timer that is not in the wheel is not an error.
+    EXPECT_EQ(wheel.Remove(b), c);
+
+    EXPECT_EQ(wheel.PopEarliest(), c);
+    EXPECT_EQ(wheel.Remove(CallbackA, AppState(1)), d);
+    EXPECT_TRUE(wheel.Empty());
+
+    // A removed timer can be added again.
+    EXPECT_EQ(wheel.Add(a), a);
+    wheel.Clear();
+    EXPECT_TRUE(wheel.Empty());
+    EXPECT_EQ(wheel.Earliest(), nullptr);
+
+    for (auto * timer : { a, b, c, d })
+    {
+        chip::Platform::Delete(timer);
+    }
+}
+
+TEST_F(TestSystemTimerWheel, CheckClockRegression)
+{
+    using Timer = TimerWheel::Node;
+
+    // A timer earlier than the wheel's current time (e.g. after a mock clock is installed) must still be ordered
+    // correctly, and must not expire before its time.
+    TimerWheel wheel;
+    Timer * late  = NewTimer<Timer>(1000000_ms, CallbackA, AppState(1));
+    Timer * early = NewTimer<Timer>(300_ms, CallbackA, AppState(2));
+
+    EXPECT_EQ(wheel.Add(late), late);
+    EXPECT_TRUE(wheel.ExtractEarlier(999999_ms).Empty());
+    EXPECT_EQ(wheel.Add(early), early);
+
+    EXPECT_TRUE(wheel.ExtractEarlier(300_ms).Empty());
+    TimerList expired = wheel.ExtractEarlier(301_ms);
+    EXPECT_EQ(expired.PopEarliest(), early);
+    EXPECT_TRUE(expired.Empty());
+    EXPECT_EQ(wheel.Earliest(), late);
+
+    wheel.Clear();
+    chip::Platform::Delete(late);
+    chip::Platform::Delete(early);
+}
+
+namespace {
+
+// Replays the timer pattern of a busy controller: every timer is restarted (cancel and re-add, as StartTimer() does)
+// once per round, and the timers due in that round expire.  Returns the (round, app state) of every expired timer.
+template <typename Queue>
+std::vector<std::pair<size_t, uintptr_t>> RunTimerPattern(size_t timerCount, size_t rounds)
+{
+    using Timer = typename Queue::Node;
+
+    Queue queue;
+    uint64_t now = 0;
+    std::vector<std::pair<size_t, uintptr_t>> fired;
+
+    for (size_t round = 0; round < rounds; round++)
+    {
+        for (size_t i = 0; i < timerCount; i++)
+        {
+            Timer * timer = static_cast<Timer *>(queue.Remove(CallbackA, AppState(i + 1)));
+            chip::Platform::Delete(timer);
+
+            // Deterministic spread of delays up to 5 s, like MRP and subscription timeouts.
+            const Clock::Timestamp awakenTime(now + (i * 7919) % 5000);
+            queue.Add(NewTimer<Timer>(awakenTime, CallbackA, AppState(i + 1)));
+        }
+
+        now += 100;
+        TimerList expired = queue.ExtractEarlier(Clock::Timestamp(now));
+        TimerList::Node * timer;
+        while ((timer = expired.PopEarliest()) != nullptr)
+        {
+            EXPECT_TRUE(timer->AwakenTime() < Clock::Timestamp(now));
+            fired.emplace_back(round, reinterpret_cast<uintptr_t>(timer->GetCallback().GetAppState()));
+            chip::Platform::Delete(static_cast<Timer *>(timer));
+        }
+    }
+
+    TimerList remaining = queue.ExtractEarlier(Clock::Timestamp(UINT64_MAX));
+    DeleteAll<Timer>(remaining);
+    EXPECT_TRUE(queue.Empty());
+
+    // Timers due at the same time may expire in any order.
+    std::sort(fired.begin(), fired.end());
+    return fired;
+}
+
+} // namespace
+
+TEST_F(TestSystemTimerWheel, TestMatchesTimerList)
+{
+    constexpr size_t kRounds = 10;
+
+    for (size_t timerCount : { 16u, 256u, 2048u })
+    {
+        const auto listFired  = RunTimerPattern<TimerList>(timerCount, kRounds);
+        const auto wheelFired = RunTimerPattern<TimerWheel>(timerCount, kRounds);
+        EXPECT_FALSE(listFired.empty());
+        EXPECT_TRUE(wheelFired == listFired);
+    }
+}
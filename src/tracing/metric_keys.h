@@ -75,6 +75,9 @@ constexpr MetricKey kMetricDeviceCASESessionSigmaFinished = "core_dev_case_sessi
 // MRP Retry Counter
 constexpr MetricKey kMetricDeviceRMPRetryCount = "core_dev_rmp_retry_count";
 
+// MRP round-trip time of an acknowledged message, in milliseconds
+constexpr MetricKey kMetricDeviceRMPRoundTripTime = "core_dev_rmp_round_trip_time";
+
 // Subscription setup
 constexpr MetricKey kMetricDeviceSubscriptionSetup = "core_dev_subscription_setup";
 
@@ -32,6 +32,7 @@
 
 #include <lib/support/BytesToHex.h>
 
+#include <algorithm>
 #include <string.h>
 
 namespace chip {
@@ -40,6 +41,10 @@ namespace {
 
 constexpr size_t kMaxAADLen = 128;
 
+// Number of messages of an EncryptBatch() or DecryptBatch() call that are handed to the cipher at once; bounds the stack space
+// used for their additional authenticated data.
+constexpr size_t kBatchChunkSize = 8;
+
 /* Session Establish Key Info */
 constexpr uint8_t SEKeysInfo[] = { 0x53, 0x65, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x4b, 0x65, 0x79, 0x73 };
 
@@ -261,6 +266,168 @@ CHIP_ERROR CryptoContext::Decrypt(const uint8_t * input, size_t input_length, ui
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CryptoContext::EncryptBatch(EncryptBatchEntry * entries, size_t count) const
+{
+    VerifyOrReturnError(entries != nullptr || count == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    for (size_t start = 0; start < count; start += kBatchChunkSize)
+    {
+        const size_t chunkSize = std::min(count - start, kBatchChunkSize);
+        uint8_t AAD[kBatchChunkSize][kMaxAADLen];
+        uint8_t tags[kBatchChunkSize][kMaxTagLen];
+        AesCcmBatchEntry cipherEntries[kBatchChunkSize];
+        EncryptBatchEntry * batchEntries[kBatchChunkSize];
+        size_t cipherCount = 0;
+
+        for (size_t i = start; i < start + chunkSize; i++)
+        {
+            EncryptBatchEntry & entry = entries[i];
+            entry.result              = CHIP_NO_ERROR;
+            if (entry.input == nullptr || entry.input_length == 0 || entry.output == nullptr || entry.header == nullptr ||
+                entry.mac == nullptr)
+            {
+                entry.result = CHIP_ERROR_INVALID_ARGUMENT;
+                continue;
+            }
+
+            const size_t taglen = entry.header->MICTagLength();
+            VerifyOrDie(taglen <= kMaxTagLen);
+
+            uint16_t aadLen = kMaxAADLen;
+            entry.result    = GetAdditionalAuthData(*entry.header, AAD[cipherCount], aadLen);
+            if (entry.result != CHIP_NO_ERROR)
+            {
+                continue;
+            }
+
+            AesCcmBatchEntry & cipherEntry = cipherEntries[cipherCount];
+            cipherEntry.input              = entry.input;
+            cipherEntry.input_length       = entry.input_length;
+            cipherEntry.aad                = AAD[cipherCount];
+            cipherEntry.aad_length         = aadLen;
+            cipherEntry.nonce              = entry.nonce.data();
+            cipherEntry.nonce_length       = entry.nonce.size();
+            cipherEntry.output             = entry.output;
+            cipherEntry.tag                = tags[cipherCount];
+            cipherEntry.tag_length         = taglen;
+            batchEntries[cipherCount++]    = &entry;
+        }
+
+        ProcessBatch(cipherEntries, cipherCount, true /* encrypt */);
+
+        for (size_t i = 0; i < cipherCount; i++)
+        {
+            EncryptBatchEntry & entry = *batchEntries[i];
+            entry.result              = cipherEntries[i].result;
+            if (entry.result == CHIP_NO_ERROR)
+            {
+                entry.mac->SetTag(entry.header, cipherEntries[i].tag, cipherEntries[i].tag_length);
+            }
+        }
+
+        for (size_t i = start; i < start + chunkSize; i++)
+        {
+            error = (error == CHIP_NO_ERROR) ? entries[i].result : error;
+        }
+    }
+    return error;
+}
+
+CHIP_ERROR CryptoContext::DecryptBatch(DecryptBatchEntry * entries, size_t count) const
+{
+    VerifyOrReturnError(entries != nullptr || count == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    for (size_t start = 0; start < count; start += kBatchChunkSize)
+    {
+        const size_t chunkSize = std::min(count - start, kBatchChunkSize);
+        uint8_t AAD[kBatchChunkSize][kMaxAADLen];
+        uint8_t tags[kBatchChunkSize][kMaxTagLen];
+        AesCcmBatchEntry cipherEntries[kBatchChunkSize];
+        DecryptBatchEntry * batchEntries[kBatchChunkSize];
+        size_t cipherCount = 0;
+
+        for (size_t i = start; i < start + chunkSize; i++)
+        {
+            DecryptBatchEntry & entry = entries[i];
+            entry.result              = CHIP_NO_ERROR;
+            if (entry.input == nullptr || entry.input_length == 0 || entry.output == nullptr || entry.header == nullptr ||
+                entry.mac == nullptr)
+            {
+                entry.result = CHIP_ERROR_INVALID_ARGUMENT;
+                continue;
+            }
+
+            const size_t taglen = entry.header->MICTagLength();
+            VerifyOrDie(taglen <= kMaxTagLen);
+
+            uint16_t aadLen = kMaxAADLen;
+            entry.result    = GetAdditionalAuthData(*entry.header, AAD[cipherCount], aadLen);
+            if (entry.result != CHIP_NO_ERROR)
+            {
+                continue;
+            }
+
+            // The batch entry takes a mutable tag buffer, which decryption only reads.
+            memcpy(tags[cipherCount], entry.mac->GetTag(), taglen);
+
+            AesCcmBatchEntry & cipherEntry = cipherEntries[cipherCount];
+            cipherEntry.input              = entry.input;
+            cipherEntry.input_length       = entry.input_length;
+            cipherEntry.aad                = AAD[cipherCount];
+            cipherEntry.aad_length         = aadLen;
+            cipherEntry.nonce              = entry.nonce.data();
+            cipherEntry.nonce_length       = entry.nonce.size();
+            cipherEntry.output             = entry.output;
+            cipherEntry.tag                = tags[cipherCount];
+            cipherEntry.tag_length         = taglen;
+            batchEntries[cipherCount++]    = &entry;
+        }
+
+        ProcessBatch(cipherEntries, cipherCount, false /* encrypt */);
+
+        for (size_t i = 0; i < cipherCount; i++)
+        {
+            batchEntries[i]->result = cipherEntries[i].result;
+        }
+
+        for (size_t i = start; i < start + chunkSize; i++)
+        {
+            error = (error == CHIP_NO_ERROR) ? entries[i].result : error;
+        }
+    }
+    return error;
+}
+
+void CryptoContext::ProcessBatch(AesCcmBatchEntry * entries, size_t count, bool encrypt) const
+{
+    // The overall results are ignored; the caller collects the result of each entry.
+    if (mKeyContext && encrypt)
+    {
+        (void) mKeyContext->MessageEncryptBatch(entries, count);
+    }
+    else if (mKeyContext)
+    {
+        (void) mKeyContext->MessageDecryptBatch(entries, count);
+    }
+    else if (mKeyAvailable && encrypt)
+    {
+        (void) AES_CCM_encrypt_batch(entries, count, mEncryptionKey);
+    }
+    else if (mKeyAvailable)
+    {
+        (void) AES_CCM_decrypt_batch(entries, count, mDecryptionKey);
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            entries[i].result = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY;
+        }
+    }
+}
+
 CHIP_ERROR CryptoContext::PrivacyEncrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                                          MessageAuthenticationCode & mac) const
 {
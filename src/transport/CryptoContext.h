@@ -146,6 +146,60 @@ public:
     CHIP_ERROR Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
                        const PacketHeader & header, const MessageAuthenticationCode & mac) const;
 
+    /**
+     * @brief One message of an EncryptBatch() call. The fields correspond to the arguments of Encrypt().
+     */
+    struct EncryptBatchEntry
+    {
+        const uint8_t * input = nullptr;
+        size_t input_length   = 0;
+        uint8_t * output      = nullptr;
+        ConstNonceView nonce;
+        PacketHeader * header           = nullptr;
+        MessageAuthenticationCode * mac = nullptr;
+
+        /// Set by EncryptBatch() to the result of encrypting this message.
+        CHIP_ERROR result = CHIP_NO_ERROR;
+    };
+
+    /**
+     * @brief One message of a DecryptBatch() call. The fields correspond to the arguments of Decrypt().
+     */
+    struct DecryptBatchEntry
+    {
+        const uint8_t * input = nullptr;
+        size_t input_length   = 0;
+        uint8_t * output      = nullptr;
+        ConstNonceView nonce;
+        const PacketHeader * header           = nullptr;
+        const MessageAuthenticationCode * mac = nullptr;
+
+        /// Set by DecryptBatch() to the result of decrypting this message.
+        CHIP_ERROR result = CHIP_NO_ERROR;
+    };
+
+    /**
+     * @brief
+     *   Encrypt several messages with the keys established in the secure channel.
+     *
+     *   Equivalent to calling Encrypt() for each entry, but the cipher is set up once for all of them.
+     *   Every entry is processed, even if an earlier one failed.
+     *
+     * @return CHIP_NO_ERROR if every message was encrypted, otherwise the first failure.
+     */
+    CHIP_ERROR EncryptBatch(EncryptBatchEntry * entries, size_t count) const;
+
+    /**
+     * @brief
+     *   Decrypt several messages with the keys established in the secure channel.
+     *
+     *   Equivalent to calling Decrypt() for each entry; see EncryptBatch(). A message that fails
+     *   authentication does not prevent the others from being decrypted.
+     *
+     * @return CHIP_NO_ERROR if every message was decrypted, otherwise the first failure.
+     */
+    CHIP_ERROR DecryptBatch(DecryptBatchEntry * entries, size_t count) const;
+
     CHIP_ERROR PrivacyEncrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                               MessageAuthenticationCode & mac) const;
 
@@ -183,6 +237,9 @@ private:
     // The encryption operations includes AAD when message authentication tag is generated. This tag
     // is used at the time of decryption to integrity check the received data.
     static CHIP_ERROR GetAdditionalAuthData(const PacketHeader & header, uint8_t * aad, uint16_t & len);
+
+    // Encrypt or decrypt the entries with the session keys, setting the result of each.
+    void ProcessBatch(Crypto::AesCcmBatchEntry * entries, size_t count, bool encrypt) const;
 };
 
 } // namespace chip
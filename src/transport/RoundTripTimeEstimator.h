@@ -0,0 +1,118 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the round-trip time estimate of the peer of a session.
+ *
+ */
+#pragma once
+
+#include <system/SystemClock.h>
+
+#include <algorithm>
+#include <stdint.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Smoothed round-trip time and round-trip time variation of a session, computed from acknowledged
+ * messages as described in RFC 6298 section 2.
+ */
+class RoundTripTimeEstimator
+{
+public:
+    /**
+     * Lower bound of the variation term of the retransmission timeout, i.e. the clock granularity
+     * G of RFC 6298.
+     */
+    static constexpr System::Clock::Milliseconds32 kClockGranularity = System::Clock::Milliseconds32(1);
+
+    /**
+     * Update the estimate with the time between sending a message and receiving its acknowledgement.
+     * Samples must not be taken from retransmitted messages, since their acknowledgement cannot be
+     * matched to a particular transmission.
+     */
+    void AddSample(System::Clock::Milliseconds32 sample)
+    {
+        const uint64_t r = sample.count();
+
+        if (mSampleCount == 0)
+        {
+            mScaledSmoothed  = r * kSmoothedScale;
+            mScaledVariation = r * kVariationScale / 2;
+        }
+        else
+        {
+            // RTTVAR <- (1 - 1/4) * RTTVAR + 1/4 * |SRTT - R'|, then SRTT <- (1 - 1/8) * SRTT + 1/8 * R'
+            const uint64_t smoothed   = mScaledSmoothed / kSmoothedScale;
+            const uint64_t difference = (smoothed > r) ? (smoothed - r) : (r - smoothed);
+            mScaledVariation          = mScaledVariation - mScaledVariation / kVariationScale + difference;
+            mScaledSmoothed           = mScaledSmoothed - mScaledSmoothed / kSmoothedScale + r;
+        }
+
+        if (mSampleCount < UINT32_MAX)
+        {
+            mSampleCount++;
+        }
+    }
+
+    bool HasEstimate() const { return mSampleCount > 0; }
+
+    /**
+     * Number of samples the estimate is based on.
+     */
+    uint32_t GetSampleCount() const { return mSampleCount; }
+
+    System::Clock::Milliseconds32 GetSmoothedRoundTripTime() const { return ToMilliseconds32(mScaledSmoothed / kSmoothedScale); }
+    System::Clock::Milliseconds32 GetRoundTripTimeVariation() const { return ToMilliseconds32(mScaledVariation / kVariationScale); }
+
+    /**
+     * Retransmission timeout suggested by the estimate: SRTT + max(G, 4 * RTTVAR).
+     * Only meaningful when HasEstimate() is true.
+     */
+    System::Clock::Milliseconds32 GetRetransmissionTimeout() const
+    {
+        return ToMilliseconds32(mScaledSmoothed / kSmoothedScale +
+                                std::max<uint64_t>(kClockGranularity.count(), mScaledVariation * 4 / kVariationScale));
+    }
+
+    void Reset()
+    {
+        mScaledSmoothed  = 0;
+        mScaledVariation = 0;
+        mSampleCount     = 0;
+    }
+
+private:
+    static System::Clock::Milliseconds32 ToMilliseconds32(uint64_t milliseconds)
+    {
+        return System::Clock::Milliseconds32(static_cast<uint32_t>(std::min<uint64_t>(milliseconds, UINT32_MAX)));
+    }
+
+    // The estimates are kept in units of 1/8 ms and 1/4 ms respectively, the inverse of their gains, so that the
+    // updates keep the fractions that whole milliseconds would drop.
+    static constexpr uint64_t kSmoothedScale  = 8;
+    static constexpr uint64_t kVariationScale = 4;
+
+    uint64_t mScaledSmoothed  = 0;
+    uint64_t mScaledVariation = 0;
+    uint32_t mSampleCount     = 0;
+};
+
+} // namespace Transport
+} // namespace chip
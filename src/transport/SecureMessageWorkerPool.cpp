@@ -0,0 +1,169 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <transport/SecureMessageWorkerPool.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+namespace chip {
+namespace Transport {
+
+CHIP_ERROR SecureMessageWorkerPool::Init(size_t threadCount, TryLockFunction tryLockStack, LockFunction unlockStack)
+{
+    VerifyOrReturnError(!IsRunning(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(threadCount > 0 && threadCount <= kMaxWorkerThreads, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tryLockStack != nullptr && unlockStack != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mTryLockStack = tryLockStack;
+    mUnlockStack  = unlockStack;
+
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        Worker & worker = mWorkers[i];
+        worker.mStop    = false;
+        worker.mThread  = std::thread([this, &worker] { worker.Run(*this); });
+    }
+    mWorkerCount = threadCount;
+
+    return CHIP_NO_ERROR;
+}
+
+void SecureMessageWorkerPool::Shutdown()
+{
+    VerifyOrReturn(IsRunning());
+
+    for (size_t i = 0; i < mWorkerCount; i++)
+    {
+        Worker & worker = mWorkers[i];
+        {
+            std::lock_guard<std::mutex> lock(worker.mMutex);
+            worker.mStop = true;
+        }
+        worker.mCondition.notify_all();
+    }
+
+    // A worker waiting for the stack lock to complete its current job hands the job back and exits.
+    for (size_t i = 0; i < mWorkerCount; i++)
+    {
+        mWorkers[i].mThread.join();
+    }
+
+    // The workers are gone, so their queues can be drained without their mutexes.
+    for (size_t i = 0; i < mWorkerCount; i++)
+    {
+        Worker & worker = mWorkers[i];
+        while (worker.mHead != nullptr)
+        {
+            Job * job     = worker.mHead;
+            worker.mHead  = job->mNextJob;
+            job->mNextJob = nullptr;
+            job->Abandon();
+        }
+        worker.mTail = nullptr;
+    }
+
+    mWorkerCount = 0;
+}
+
+void SecureMessageWorkerPool::Submit(Job & job, uint32_t shardKey)
+{
+    VerifyOrDie(IsRunning());
+
+    Worker & worker = mWorkers[shardKey % mWorkerCount];
+    {
+        std::lock_guard<std::mutex> lock(worker.mMutex);
+        job.mNextJob = nullptr;
+        if (worker.mTail == nullptr)
+        {
+            worker.mHead = &job;
+        }
+        else
+        {
+            worker.mTail->mNextJob = &job;
+        }
+        worker.mTail = &job;
+    }
+    worker.mCondition.notify_one();
+}
+
+void SecureMessageWorkerPool::Worker::Run(SecureMessageWorkerPool & pool)
+{
+    while (true)
+    {
+        Job * job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mStop || mHead != nullptr; });
+            if (mStop)
+            {
+                return;
+            }
+
+            job   = mHead;
+            mHead = job->mNextJob;
+            if (mHead == nullptr)
+            {
+                mTail = nullptr;
+            }
+            job->mNextJob = nullptr;
+        }
+
+        job->Process();
+
+        if (!LockStack(pool))
+        {
+            // Put the job back at the head of the queue, for Shutdown() to abandon along with the rest.
+            std::lock_guard<std::mutex> lock(mMutex);
+            job->mNextJob = mHead;
+            mHead         = job;
+            if (mTail == nullptr)
+            {
+                mTail = job;
+            }
+            return;
+        }
+
+        if (mStop)
+        {
+            job->Abandon();
+        }
+        else
+        {
+            job->Complete();
+        }
+        pool.mUnlockStack();
+    }
+}
+
+bool SecureMessageWorkerPool::Worker::LockStack(SecureMessageWorkerPool & pool)
+{
+    // Never block on the stack lock: Shutdown() may be holding it while it waits for this worker to exit.
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!pool.mTryLockStack())
+    {
+        if (mCondition.wait_for(lock, kLockRetryInterval, [this] { return mStop.load(); }))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Transport
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
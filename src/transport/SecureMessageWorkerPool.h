@@ -0,0 +1,140 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a pool of worker threads that take CPU-bound message processing (such as
+ *      decryption) off the Matter event loop thread.
+ */
+
+#pragma once
+
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ *  A fixed set of worker threads, each with its own FIFO queue of jobs.
+ *
+ *  A job is submitted with a shard key (e.g. a session ID), and all jobs with the same key go to the same worker, so they are
+ *  processed and completed in submission order.  Each job runs in two steps on its worker: Process() runs without any lock,
+ *  so jobs on different workers run in parallel, and Complete() then runs with the stack lock held, so that it can safely
+ *  use the rest of the stack.
+ *
+ *  Submit() must be called with the stack lock held.  Shutdown() may be called with or without it, see there.
+ */
+class SecureMessageWorkerPool
+{
+public:
+    static constexpr size_t kMaxWorkerThreads = 16;
+
+    using TryLockFunction = bool (*)();
+    using LockFunction    = void (*)();
+
+    class Job
+    {
+    public:
+        virtual ~Job() = default;
+
+        /// Called on a worker thread, without the stack lock.
+        virtual void Process() = 0;
+
+        /// Called on the same worker thread after Process(), with the stack lock held.  The job may be destroyed here.
+        virtual void Complete() = 0;
+
+        /// Called instead of Complete(), whether or not Process() ran, for jobs dropped by Shutdown().  Runs on the thread
+        /// calling Shutdown().
+        virtual void Abandon() = 0;
+
+    private:
+        friend class SecureMessageWorkerPool;
+        Job * mNextJob = nullptr;
+    };
+
+    SecureMessageWorkerPool() = default;
+    ~SecureMessageWorkerPool() { VerifyOrDie(!IsRunning()); }
+
+    SecureMessageWorkerPool(const SecureMessageWorkerPool &)             = delete;
+    SecureMessageWorkerPool & operator=(const SecureMessageWorkerPool &) = delete;
+
+    /**
+     *  Start the worker threads.
+     *
+     *  @param[in] threadCount    Number of worker threads, at most kMaxWorkerThreads.
+     *  @param[in] tryLockStack   Acquires the stack lock if it is free; called by workers before Complete().
+     *  @param[in] unlockStack    Releases the stack lock.
+     */
+    CHIP_ERROR Init(size_t threadCount, TryLockFunction tryLockStack, LockFunction unlockStack);
+
+    /**
+     *  Stop the worker threads, and abandon any jobs that have not been completed.  Jobs already being processed are
+     *  abandoned once Process() returns.
+     *
+     *  This never touches the stack lock.  Workers only take the lock when it is free and give up once the pool stops, so
+     *  this can be called with the stack lock held, or without it by the thread that shuts the stack down once the event
+     *  loop has stopped.  Jobs are abandoned on the calling thread.
+     */
+    void Shutdown();
+
+    bool IsRunning() const { return mWorkerCount > 0; }
+    size_t GetWorkerCount() const { return mWorkerCount; }
+
+    /// Queue a job on the worker selected by shardKey.  The pool must be running.
+    void Submit(Job & job, uint32_t shardKey);
+
+private:
+    // How long a worker waits for the stack lock to be released before trying to take it again.
+    static constexpr std::chrono::microseconds kLockRetryInterval{ 100 };
+
+    struct Worker
+    {
+        void Run(SecureMessageWorkerPool & pool);
+
+        // Take the stack lock, unless the pool stops first.
+        bool LockStack(SecureMessageWorkerPool & pool);
+
+        std::thread mThread;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        Job * mHead = nullptr;
+        Job * mTail = nullptr;
+        std::atomic<bool> mStop{ false };
+    };
+
+    Worker mWorkers[kMaxWorkerThreads];
+    size_t mWorkerCount       = 0;
+    TryLockFunction mTryLockStack = nullptr;
+    LockFunction mUnlockStack     = nullptr;
+};
+
+} // namespace Transport
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
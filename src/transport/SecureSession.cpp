@@ -17,10 +17,21 @@
 #include <access/AuthMode.h>
 #include <transport/SecureSession.h>
 #include <transport/SecureSessionTable.h>
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+#include <transport/raw/TCP.h>
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
 namespace chip {
 namespace Transport {
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+namespace {
+// The user that secure sessions hold their TCP connection as. It has no callbacks: the SessionManager evicts the
+// sessions over a connection once it is closed.
+AppTCPConnectionCallbackCtxt gSecureSessionTCPConnCbCtxt;
+} // namespace
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
 void SecureSessionDeleter::Release(SecureSession * entry)
 {
     entry->mTable.ReleaseSession(entry);
@@ -40,12 +51,11 @@ void SecureSession::Activate(const ScopedNodeId & localNode, const ScopedNodeId
     VerifyOrDie(!((mSecureSessionType == Type::kCASE) &&
                   (!IsOperationalNodeId(peerNode.GetNodeId()) || !IsOperationalNodeId(localNode.GetNodeId()))));
 
-    mPeerNodeId          = peerNode.GetNodeId();
+    SetPeer(peerNode);
     mLocalNodeId         = localNode.GetNodeId();
     mPeerCATs            = peerCATs;
     mPeerSessionId       = peerSessionId;
     mRemoteSessionParams = sessionParameters;
-    SetFabricIndex(peerNode.GetFabricIndex());
     MarkActiveRx(); // Initialize SessionTimestamp and ActiveTimestamp per spec.
 
     Retain(); // This ref is released inside MarkForEviction
@@ -57,6 +67,14 @@ void SecureSession::Activate(const ScopedNodeId & localNode, const ScopedNodeId
     ChipLogDetail(Inet, "SecureSession[%p]: Activated - Type:%d LSID:%d", this, to_underlying(mSecureSessionType), mLocalSessionId);
 }
 
+void SecureSession::SetPeer(const ScopedNodeId & peer)
+{
+    mTable.RemoveFromPeerIndex(this);
+    mPeerNodeId = peer.GetNodeId();
+    SetFabricIndex(peer.GetFabricIndex());
+    mTable.AddToPeerIndex(this);
+}
+
 const char * SecureSession::StateToString(State state) const
 {
     switch (state)
@@ -99,6 +117,10 @@ void SecureSession::MarkAsDefunct()
                   mLocalSessionId);
     ReferenceCountedHandle<Transport::Session> ref(*this);
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    ReleaseTCPConnection();
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
     switch (mState)
     {
     case State::kEstablishing:
@@ -155,6 +177,29 @@ void SecureSession::MarkForEviction()
     }
 }
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+void SecureSession::HoldTCPConnection(AppTCPConnectionCallbackCtxt * appState)
+{
+    ActiveTCPConnectionState * conn = GetTCPConnection();
+    VerifyOrReturn(mHeldTCPConnection == nullptr && conn != nullptr && conn->InUse());
+    VerifyOrReturn(TCPBase::HandOverConnectionUser(conn, appState, &gSecureSessionTCPConnCbCtxt));
+    mHeldTCPConnection = conn;
+}
+
+void SecureSession::ReleaseTCPConnection()
+{
+    ActiveTCPConnectionState * conn = mHeldTCPConnection;
+    mHeldTCPConnection              = nullptr;
+
+    // A connection that is already freed has no users left to release.
+    VerifyOrReturn(conn != nullptr && conn->InUse());
+
+    // The connection is closed once no other session holds it.
+    TCPBase * tcp = reinterpret_cast<TCPBase *>(conn->mEndPoint->mAppState);
+    tcp->TCPDisconnect(conn, /* shouldAbort = */ false, &gSecureSessionTCPConnCbCtxt);
+}
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
 Access::SubjectDescriptor SecureSession::GetSubjectDescriptor() const
 {
     Access::SubjectDescriptor subjectDescriptor;
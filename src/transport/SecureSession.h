@@ -108,6 +108,9 @@ public:
     {
         ChipLogDetail(Inet, "SecureSession[%p]: Released - Type:%d LSID:%d", this, to_underlying(mSecureSessionType),
                       mLocalSessionId);
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+        ReleaseTCPConnection();
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
     }
 
     SecureSession(SecureSession &&)                  = delete;
@@ -134,6 +137,15 @@ public:
      */
     void MarkForEviction();
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    /*
+     * Take over the hold that appState has on the TCP connection of the session, so that the connection stays open
+     * for as long as the session is in use rather than until the session establishment that set it up is done. The
+     * hold is released when the session is marked for eviction or released.
+     */
+    void HoldTCPConnection(AppTCPConnectionCallbackCtxt * appState);
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
     /*
      * This marks a previously active session as defunct to temporarily prevent it from being used with
      * new exchanges to send or receive messages on this session. This should be called when there is suspicion of
@@ -227,7 +239,7 @@ public:
         {
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
-        SetFabricIndex(fabricIndex);
+        SetPeer(ScopedNodeId(mPeerNodeId, fabricIndex));
         return CHIP_NO_ERROR;
     }
 
@@ -317,7 +329,15 @@ private:
     const char * StateToString(State state) const;
     void MoveToState(State targetState);
 
+    // Changes the peer (and fabric) of the session, keeping the peer index of the owning table up to date.
+    void SetPeer(const ScopedNodeId & peer);
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    void ReleaseTCPConnection();
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
     friend class SecureSessionDeleter;
+    friend class SecureSessionTable;
     friend class TestSecureSessionTable;
 
     SecureSessionTable & mTable;
@@ -340,6 +360,15 @@ private:
     SessionParameters mRemoteSessionParams;
     CryptoContext mCryptoContext;
     SessionMessageCounter mSessionMessageCounter;
+
+    // Links of the SecureSessionTable peer index chain this session is on. The head's mPeerIndexPrev is the tail.
+    SecureSession * mPeerIndexPrev = nullptr;
+    SecureSession * mPeerIndexNext = nullptr;
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    // The TCP connection the session holds, see HoldTCPConnection().
+    ActiveTCPConnectionState * mHeldTCPConnection = nullptr;
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 };
 
 } // namespace Transport
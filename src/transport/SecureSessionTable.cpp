@@ -52,8 +52,8 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
         }
     }
 
-    SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
-                                                   peerSessionId, fabricIndex, config);
+    SecureSession * result = AddToIndexes(mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId,
+                                                                peerCATs, peerSessionId, fabricIndex, config));
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
@@ -73,7 +73,7 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
     //
     if (mEntries.Allocated() < GetMaxSessionTableSize())
     {
-        allocated = mEntries.CreateObject(*this, secureSessionType, sessionId.Value());
+        allocated = AddToIndexes(mEntries.CreateObject(*this, secureSessionType, sessionId.Value()));
     }
     else
     {
@@ -136,30 +136,14 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
     //
     // Compute two key stats for each session - the number of other sessions that
     // match its fabric, as well as the number of other sessions that match its peer.
+    // Both are maintained by the table's indexes.
     //
     // This will be used by the session eviction algorithm later.
     //
     ForEachSession([&index, &sortableSessions, this](auto * session) {
         sortableSessions[index].mSession             = session;
-        sortableSessions[index].mNumMatchingOnFabric = 0;
-        sortableSessions[index].mNumMatchingOnPeer   = 0;
-
-        ForEachSession([session, index, &sortableSessions](auto * otherSession) {
-            if (session != otherSession)
-            {
-                if (session->GetFabricIndex() == otherSession->GetFabricIndex())
-                {
-                    sortableSessions[index].mNumMatchingOnFabric++;
-
-                    if (session->GetPeerNodeId() == otherSession->GetPeerNodeId())
-                    {
-                        sortableSessions[index].mNumMatchingOnPeer++;
-                    }
-                }
-            }
-
-            return Loop::Continue;
-        });
+        sortableSessions[index].mNumMatchingOnFabric = static_cast<uint16_t>(mSessionCountByFabric[session->GetFabricIndex()] - 1);
+        sortableSessions[index].mNumMatchingOnPeer   = static_cast<uint16_t>(CountSessionsForPeer(session->GetPeer()) - 1);
 
         index++;
         return Loop::Continue;
@@ -216,7 +200,7 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
         if (newCount < prevCount)
         {
             ChipLogProgress(SecureChannel, "Successfully evicted a session!");
-            auto * retSession = mEntries.CreateObject(*this, secureSessionType, localSessionId);
+            auto * retSession = AddToIndexes(mEntries.CreateObject(*this, secureSessionType, localSessionId));
             VerifyOrDie(session != nullptr);
             return retSession;
         }
@@ -339,68 +323,172 @@ void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionC
 
 Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
 {
-    SecureSession * result = nullptr;
-    mEntries.ForEachActiveObject([&](auto session) {
-        if (session->GetLocalSessionId() == localSessionId)
-        {
-            result = session;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    SecureSession * result = FindInLocalSessionIdIndex(localSessionId);
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
 Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
 {
-    uint16_t candidate_base = 0;
-    uint64_t candidate_mask = 0;
-    for (uint32_t i = 0; i <= kMaxSessionID; i += 64)
+    uint16_t candidate = mNextSessionId;
+    for (uint32_t i = 0; i <= kMaxSessionID; i++, candidate++)
     {
-        // candidate_base is the base session ID we are searching from.
-        // We have a 64-bit mask anchored at this ID and iterate over the
-        // whole session table, setting bits in the mask for in-use IDs.
-        // If we can iterate through the entire session table and have
-        // any bits clear in the mask, we have available session IDs.
-        candidate_base = static_cast<uint16_t>(i + mNextSessionId);
-        candidate_mask = 0;
+        // kUnsecuredSessionId is never available
+        if (candidate != kUnsecuredSessionId && FindInLocalSessionIdIndex(candidate) == nullptr)
         {
-            uint16_t shift = static_cast<uint16_t>(kUnsecuredSessionId - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift); // kUnsecuredSessionId is never available
-            }
+            return MakeOptional<uint16_t>(candidate);
         }
-        mEntries.ForEachActiveObject([&](auto session) {
-            uint16_t shift = static_cast<uint16_t>(session->GetLocalSessionId() - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift);
-            }
-            if (candidate_mask == UINT64_MAX)
-            {
-                return Loop::Break; // No bits clear means this bucket is full.
-            }
-            return Loop::Continue;
-        });
-        if (candidate_mask != UINT64_MAX)
+    }
+
+    return NullOptional;
+}
+
+SecureSession * SecureSessionTable::AddToIndexes(SecureSession * session)
+{
+    if (session != nullptr)
+    {
+        AddToLocalSessionIdIndex(session);
+        AddToPeerIndex(session);
+    }
+    return session;
+}
+
+void SecureSessionTable::AddToLocalSessionIdIndex(SecureSession * session)
+{
+    size_t slot = LocalSessionIdHash(session->GetLocalSessionId());
+    while (mLocalSessionIdIndex[slot] != nullptr)
+    {
+        slot = (slot + 1) & kIndexMask;
+    }
+    mLocalSessionIdIndex[slot] = session;
+}
+
+void SecureSessionTable::RemoveFromLocalSessionIdIndex(SecureSession * session)
+{
+    size_t slot = LocalSessionIdHash(session->GetLocalSessionId());
+    while (mLocalSessionIdIndex[slot] != session)
+    {
+        VerifyOrDie(mLocalSessionIdIndex[slot] != nullptr);
+        slot = (slot + 1) & kIndexMask;
+    }
+
+    // Backward-shift deletion: move later entries of the probe sequence into the hole, unless their home slot
+    // lies (cyclically) after the hole.
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & kIndexMask; mLocalSessionIdIndex[next] != nullptr; next = (next + 1) & kIndexMask)
+    {
+        size_t home = LocalSessionIdHash(mLocalSessionIdIndex[next]->GetLocalSessionId());
+        if (((next - home) & kIndexMask) >= ((next - hole) & kIndexMask))
         {
-            break; // Any bit clear means we have an available ID in this bucket.
+            mLocalSessionIdIndex[hole] = mLocalSessionIdIndex[next];
+            hole                       = next;
         }
     }
-    if (candidate_mask != UINT64_MAX)
+    mLocalSessionIdIndex[hole] = nullptr;
+}
+
+SecureSession * SecureSessionTable::FindInLocalSessionIdIndex(uint16_t localSessionId) const
+{
+    for (size_t slot = LocalSessionIdHash(localSessionId); mLocalSessionIdIndex[slot] != nullptr; slot = (slot + 1) & kIndexMask)
     {
-        uint16_t offset = 0;
-        while (candidate_mask & 1)
+        if (mLocalSessionIdIndex[slot]->GetLocalSessionId() == localSessionId)
         {
-            candidate_mask >>= 1;
-            ++offset;
+            return mLocalSessionIdIndex[slot];
         }
-        uint16_t available = static_cast<uint16_t>(candidate_base + offset);
-        return MakeOptional<uint16_t>(available);
     }
+    return nullptr;
+}
 
-    return NullOptional;
+size_t SecureSessionTable::PeerHash(const ScopedNodeId & peer)
+{
+    // Fibonacci hashing of the node ID mixed with the fabric index; node IDs are not uniformly distributed.
+    uint64_t key = peer.GetNodeId() ^ (static_cast<uint64_t>(peer.GetFabricIndex()) << 56);
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & kIndexMask;
+}
+
+bool SecureSessionTable::FindPeerIndexSlot(const ScopedNodeId & peer, size_t & slot) const
+{
+    for (slot = PeerHash(peer); mPeerIndex[slot].mHead != nullptr; slot = (slot + 1) & kIndexMask)
+    {
+        if (mPeerIndex[slot].mHead->GetPeer() == peer)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+SecureSessionTable::SessionCount SecureSessionTable::CountSessionsForPeer(const ScopedNodeId & peer) const
+{
+    size_t slot;
+    return FindPeerIndexSlot(peer, slot) ? mPeerIndex[slot].mCount : 0;
+}
+
+void SecureSessionTable::AddToPeerIndex(SecureSession * session)
+{
+    size_t slot;
+    FindPeerIndexSlot(session->GetPeer(), slot);
+    PeerIndexSlot & entry = mPeerIndex[slot];
+
+    // Append to the chain; the head's previous link points at the tail.
+    session->mPeerIndexNext = nullptr;
+    if (entry.mHead == nullptr)
+    {
+        entry.mHead             = session;
+        session->mPeerIndexPrev = session;
+    }
+    else
+    {
+        SecureSession * tail        = entry.mHead->mPeerIndexPrev;
+        tail->mPeerIndexNext        = session;
+        session->mPeerIndexPrev     = tail;
+        entry.mHead->mPeerIndexPrev = session;
+    }
+    entry.mCount++;
+    mSessionCountByFabric[session->GetFabricIndex()]++;
+}
+
+void SecureSessionTable::RemoveFromPeerIndex(SecureSession * session)
+{
+    size_t slot;
+    VerifyOrDie(FindPeerIndexSlot(session->GetPeer(), slot));
+    PeerIndexSlot & entry = mPeerIndex[slot];
+
+    mSessionCountByFabric[session->GetFabricIndex()]--;
+    entry.mCount--;
+
+    if (entry.mHead == session)
+    {
+        entry.mHead = session->mPeerIndexNext;
+        if (entry.mHead != nullptr)
+        {
+            entry.mHead->mPeerIndexPrev = session->mPeerIndexPrev;
+        }
+    }
+    else
+    {
+        // The tail's successor for this purpose is the head, which holds the tail link.
+        SecureSession * next = session->mPeerIndexNext != nullptr ? session->mPeerIndexNext : entry.mHead;
+
+        session->mPeerIndexPrev->mPeerIndexNext = session->mPeerIndexNext;
+        next->mPeerIndexPrev                    = session->mPeerIndexPrev;
+    }
+    session->mPeerIndexPrev = nullptr;
+    session->mPeerIndexNext = nullptr;
+
+    VerifyOrReturn(entry.mHead == nullptr);
+
+    // Last session to this peer is gone: backward-shift deletion of the slot, as for the local session ID index.
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & kIndexMask; mPeerIndex[next].mHead != nullptr; next = (next + 1) & kIndexMask)
+    {
+        size_t home = PeerHash(mPeerIndex[next].mHead->GetPeer());
+        if (((next - home) & kIndexMask) >= ((next - hole) & kIndexMask))
+        {
+            mPeerIndex[hole] = mPeerIndex[next];
+            hole             = next;
+        }
+    }
+    mPeerIndex[hole] = PeerIndexSlot();
 }
 
 } // namespace Transport
@@ -23,18 +23,39 @@
 #include <system/TimeSource.h>
 #include <transport/SecureSession.h>
 
+#include <limits>
+#include <type_traits>
+
 namespace chip {
 namespace Transport {
 
 inline constexpr uint16_t kMaxSessionID       = UINT16_MAX;
 inline constexpr uint16_t kUnsecuredSessionId = 0;
 
+/**
+ * Number of slots in each SecureSessionTable index: the smallest power of two that keeps the index no more
+ * than two-thirds full when all poolSize sessions are allocated.
+ */
+constexpr size_t SecureSessionIndexCapacity(size_t poolSize)
+{
+    size_t capacity = 1;
+    while (capacity < poolSize + poolSize / 2 + 1)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
 /**
  * Handles a set of sessions.
  *
  * Intended for:
  *   - handle session active time and expiration
  *   - allocate and free space for sessions.
+ *
+ * Sessions are indexed by local session ID and by peer (fabric index, peer node ID), so that looking up the
+ * session of an incoming message, or the sessions to a given peer, does not depend on the number of sessions
+ * in the table.
  */
 class SecureSessionTable
 {
@@ -76,7 +97,12 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        RemoveFromLocalSessionIdIndex(session);
+        RemoveFromPeerIndex(session);
+        mEntries.ReleaseObject(session);
+    }
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -84,6 +110,31 @@ public:
         return mEntries.ForEachActiveObject(std::forward<Function>(function));
     }
 
+    /**
+     * Call the provided function on every session (in any state) whose GetPeer() matches the given peer.
+     *
+     * The function may release the session it is called for, but must not release other sessions or
+     * change the peer of any session.
+     */
+    template <typename Function>
+    Loop ForEachSessionForPeer(const ScopedNodeId & peer, Function && function)
+    {
+        size_t slot;
+        VerifyOrReturnValue(FindPeerIndexSlot(peer, slot), Loop::Finish);
+
+        SecureSession * session = mPeerIndex[slot].mHead;
+        while (session != nullptr)
+        {
+            SecureSession * next = session->mPeerIndexNext;
+            if (function(session) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+            session = next;
+        }
+        return Loop::Finish;
+    }
+
     /**
      * Get a secure session given its session ID.
      *
@@ -100,7 +151,7 @@ public:
     void NewerSessionAvailable(SecureSession * session)
     {
         VerifyOrDie(session->GetSecureSessionType() == SecureSession::Type::kCASE);
-        mEntries.ForEachActiveObject([&](SecureSession * oldSession) {
+        ForEachSessionForPeer(session->GetPeer(), [&](SecureSession * oldSession) {
             if (session == oldSession)
                 return Loop::Continue;
 
@@ -121,6 +172,7 @@ public:
     }
 
 private:
+    friend class SecureSession;
     friend class TestSecureSessionTable;
 
     /**
@@ -243,22 +295,57 @@ private:
     /**
      * Find an available session ID that is unused in the secure session table.
      *
-     * The search algorithm iterates over the session ID space in the outer loop
-     * and the session table in the inner loop to locate an available session ID
-     * from the starting mNextSessionId clue.
-     *
-     * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * Session IDs are probed in the local session ID index starting from the
+     * mNextSessionId clue, so at most one more ID than there are sessions in the
+     * table is considered.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
+    /**
+     * Both indexes are open-addressing hash tables with linear probing and backward-shift deletion, sized by
+     * SecureSessionIndexCapacity().
+     *
+     * The local session ID index holds one entry per session. The peer index holds one entry per distinct
+     * peer; the sessions to that peer are chained through SecureSession::mPeerIndexNext in insertion order.
+     */
+    static constexpr size_t kIndexCapacity = SecureSessionIndexCapacity(CHIP_CONFIG_SECURE_SESSION_POOL_SIZE);
+    static constexpr size_t kIndexMask     = kIndexCapacity - 1;
+
+    using SessionCount = std::conditional_t<(CHIP_CONFIG_SECURE_SESSION_POOL_SIZE <= UINT8_MAX), uint8_t, uint16_t>;
+
+    struct PeerIndexSlot
+    {
+        SecureSession * mHead = nullptr;
+        SessionCount mCount   = 0;
+    };
+
+    static size_t LocalSessionIdHash(uint16_t localSessionId) { return localSessionId & kIndexMask; }
+    static size_t PeerHash(const ScopedNodeId & peer);
+
+    void AddToLocalSessionIdIndex(SecureSession * session);
+    void RemoveFromLocalSessionIdIndex(SecureSession * session);
+    SecureSession * FindInLocalSessionIdIndex(uint16_t localSessionId) const;
+
+    // Called by SecureSession around changes of its peer.
+    void AddToPeerIndex(SecureSession * session);
+    void RemoveFromPeerIndex(SecureSession * session);
+    bool FindPeerIndexSlot(const ScopedNodeId & peer, size_t & slot) const;
+    SessionCount CountSessionsForPeer(const ScopedNodeId & peer) const;
+
+    // Adds a newly created session (if any) to both indexes and returns it.
+    SecureSession * AddToIndexes(SecureSession * session);
+
     bool mRunningEvictionLogic = false;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
 
+    SecureSession * mLocalSessionIdIndex[kIndexCapacity] = {};
+    PeerIndexSlot mPeerIndex[kIndexCapacity];
+    // Number of sessions per fabric index, for the eviction policy.
+    SessionCount mSessionCountByFabric[std::numeric_limits<FabricIndex>::max() + 1] = {};
+
     size_t GetMaxSessionTableSize() const
     {
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
@@ -27,6 +27,7 @@
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <messaging/SessionParameters.h>
 #include <platform/LockTracker.h>
+#include <transport/RoundTripTimeEstimator.h>
 #include <transport/SessionDelegate.h>
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
 #include <transport/raw/TCP.h>
@@ -270,6 +271,12 @@ public:
 
     FabricIndex GetFabricIndex() const { return mFabricIndex; }
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    // Round-trip time to the peer, measured from the acknowledgements of the reliable messages sent on this session.
+    RoundTripTimeEstimator & GetRoundTripTimeEstimator() { return mRoundTripTimeEstimator; }
+    const RoundTripTimeEstimator & GetRoundTripTimeEstimator() const { return mRoundTripTimeEstimator; }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
     SecureSession * AsSecureSession();
     UnauthenticatedSession * AsUnauthenticatedSession();
     IncomingGroupSession * AsIncomingGroupSession();
@@ -332,6 +339,9 @@ protected:
 
 private:
     FabricIndex mFabricIndex = kUndefinedFabricIndex;
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    RoundTripTimeEstimator mRoundTripTimeEstimator;
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
     // The underlying TCP connection object over which the session is
     // established.
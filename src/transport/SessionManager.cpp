@@ -48,6 +48,10 @@
 #include <transport/TracingStructs.h>
 #include <transport/TransportMgr.h>
 
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0 && !CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#error "CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS requires CHIP_SYSTEM_CONFIG_POSIX_LOCKING"
+#endif
+
 namespace chip {
 
 using System::PacketBufferHandle;
@@ -147,6 +151,12 @@ CHIP_ERROR SessionManager::Init(System::Layer * systemLayer, TransportMgrBase *
 
     mTransportMgr->SetSessionManager(this);
 
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+    ReturnErrorOnFailure(mWorkerPool.Init(
+        CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS, [] { return DeviceLayer::PlatformMgr().TryLockChipStack(); },
+        [] { DeviceLayer::PlatformMgr().UnlockChipStack(); }));
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
     mConnCompleteCb = nullptr;
     mConnClosedCb   = nullptr;
@@ -157,6 +167,11 @@ CHIP_ERROR SessionManager::Init(System::Layer * systemLayer, TransportMgrBase *
 
 void SessionManager::Shutdown()
 {
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+    // Messages still being decrypted are dropped, so none are dispatched into a partially shut down stack.
+    mWorkerPool.Shutdown();
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+
     if (mFabricTable != nullptr)
     {
         mFabricTable->RemoveFabricDelegate(this);
@@ -566,9 +581,8 @@ void SessionManager::ExpireAllSecureSessions()
 
 void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Optional<Transport::SecureSession::Type> & type)
 {
-    mSecureSessions.ForEachSession([&node, &type](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == node &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+    mSecureSessions.ForEachSessionForPeer(node, [&type](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             session->MarkAsDefunct();
         }
@@ -578,10 +592,10 @@ void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Opti
 
 void SessionManager::UpdateAllSessionsPeerAddress(const ScopedNodeId & node, const Transport::PeerAddress & addr)
 {
-    mSecureSessions.ForEachSession([&node, &addr](auto session) {
+    mSecureSessions.ForEachSessionForPeer(node, [&addr](auto session) {
         // Arguably we should only be updating active and defunct sessions, but there is no harm
         // in updating evicted sessions.
-        if (session->GetPeer() == node && Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
+        if (Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
         {
             session->SetPeerAddress(addr);
         }
@@ -690,6 +704,7 @@ void SessionManager::HandleConnectionAttemptComplete(Transport::ActiveTCPConnect
     Transport::AppTCPConnectionCallbackCtxt * appTCPConnCbCtxt = conn->mAppState;
     if (appTCPConnCbCtxt == nullptr)
     {
+        // A connection without a user to notify has nobody to leave it open for.
         TCPDisconnect(conn, /* shouldAbort = */ true);
         return;
     }
@@ -705,8 +720,8 @@ void SessionManager::HandleConnectionAttemptComplete(Transport::ActiveTCPConnect
 
         ChipLogProgress(Inet, "TCP Connection established with peer %s, but no registered handler. Disconnecting.", peerAddrBuf);
 
-        // Close the connection
-        TCPDisconnect(conn, /* shouldAbort = */ true);
+        // Close the connection, unless other sessions use it
+        TCPDisconnect(conn, /* shouldAbort = */ true, appTCPConnCbCtxt);
     }
 }
 
@@ -757,16 +772,21 @@ CHIP_ERROR SessionManager::TCPDisconnect(const PeerAddress & peerAddress)
     return CHIP_NO_ERROR;
 }
 
-void SessionManager::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort)
+void SessionManager::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort,
+                                   Transport::AppTCPConnectionCallbackCtxt * appState)
 {
     if (mTransportMgr != nullptr && conn != nullptr)
     {
         char peerAddrBuf[chip::Transport::PeerAddress::kMaxToStringSize];
         conn->mPeerAddr.ToString(peerAddrBuf);
         ChipLogProgress(Inet, "Disconnecting TCP connection from peer at %s.", peerAddrBuf);
-        mTransportMgr->TCPDisconnect(conn, shouldAbort);
+        mTransportMgr->TCPDisconnect(conn, shouldAbort, appState);
 
-        MarkSecureSessionOverTCPForEviction(conn, CHIP_NO_ERROR);
+        // The sessions of the other users of a shared connection keep using it.
+        if (!conn->InUse())
+        {
+            MarkSecureSessionOverTCPForEviction(conn, CHIP_NO_ERROR);
+        }
     }
 }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
@@ -897,8 +917,6 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
 {
     MATTER_TRACE_SCOPE("Secure Unicast Message Dispatch", "SessionManager");
 
-    CHIP_ERROR err = CHIP_NO_ERROR;
-
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
     if (peerAddress.GetTransportType() == Transport::Type::kTcp && ctxt->conn == nullptr)
     {
@@ -954,8 +972,6 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     PacketHeader packetHeader;
     ReturnOnFailure(packetHeader.DecodeAndConsume(msg));
 
-    SessionMessageDelegate::DuplicateMessage isDuplicate = SessionMessageDelegate::DuplicateMessage::No;
-
     if (msg.IsNull())
     {
         ChipLogError(Inet, "Secure transport received Unicast NULL packet, discarding");
@@ -982,13 +998,41 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     CryptoContext::BuildNonce(nonce, packetHeader.GetSecurityFlags(), packetHeader.GetMessageCounter(),
                               secureSession->GetSecureSessionType() == SecureSession::Type::kCASE ? secureSession->GetPeerNodeId()
                                                                                                   : kUndefinedNodeId);
+
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+    if (mWorkerPool.IsRunning())
+    {
+        SecureUnicastDecryptJob * job =
+            mDecryptJobPool.CreateObject(*this, *secureSession, packetHeader, peerAddress, nonce, std::move(msg));
+        if (job == nullptr)
+        {
+            ChipLogError(Inet, "Secure transport decryption queue is full, discarding message");
+            return;
+        }
+
+        // Shard by session, so that the messages on a session are still decrypted and dispatched in order.
+        mWorkerPool.Submit(*job, secureSession->GetLocalSessionId());
+        return;
+    }
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+
     if (SecureMessageCodec::Decrypt(secureSession->GetCryptoContext(), nonce, payloadHeader, packetHeader, msg) != CHIP_NO_ERROR)
     {
         ChipLogError(Inet, "Secure transport received message, but failed to decode/authenticate it, discarding");
         return;
     }
 
-    err =
+    SecureUnicastMessageDecrypted(packetHeader, payloadHeader, session.Value(), peerAddress, std::move(msg));
+}
+
+void SessionManager::SecureUnicastMessageDecrypted(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                                   const SessionHandle & session, const Transport::PeerAddress & peerAddress,
+                                                   System::PacketBufferHandle && msg)
+{
+    Transport::SecureSession * secureSession             = session->AsSecureSession();
+    SessionMessageDelegate::DuplicateMessage isDuplicate = SessionMessageDelegate::DuplicateMessage::No;
+
+    CHIP_ERROR err =
         secureSession->GetSessionMessageCounter().GetPeerMessageCounter().VerifyEncryptedUnicast(packetHeader.GetMessageCounter());
     if (err == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED)
     {
@@ -1024,7 +1068,7 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
         MATTER_LOG_MESSAGE_RECEIVED(chip::Tracing::IncomingMessageType::kSecureUnicast, &payloadHeader, &packetHeader,
                                     secureSession, &peerAddress, chip::ByteSpan(msg->Start(), msg->TotalLength()));
         CHIP_TRACE_MESSAGE_RECEIVED(payloadHeader, packetHeader, secureSession, peerAddress, msg->Start(), msg->TotalLength());
-        mCB->OnMessageReceived(packetHeader, payloadHeader, session.Value(), isDuplicate, std::move(msg));
+        mCB->OnMessageReceived(packetHeader, payloadHeader, session, isDuplicate, std::move(msg));
     }
     else
     {
@@ -1032,6 +1076,42 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     }
 }
 
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+void SessionManager::SecureUnicastDecryptJob::Process()
+{
+    // The session's crypto context does not change once the session is active, so it can be used without the stack lock.
+    mDecryptError = SecureMessageCodec::Decrypt(mSession->AsSecureSession()->GetCryptoContext(), mNonce, mPayloadHeader,
+                                                mPacketHeader, mMsg);
+}
+
+void SessionManager::SecureUnicastDecryptJob::Complete()
+{
+    SecureSession * secureSession = mSession->AsSecureSession();
+
+    if (mDecryptError != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Secure transport received message, but failed to decode/authenticate it, discarding");
+    }
+    else if (!secureSession->IsDefunct() && !secureSession->IsActiveSession() && !secureSession->IsPendingEviction())
+    {
+        // The session was released while the message was being decrypted.
+        ChipLogError(Inet, "Secure transport received message on a session in an invalid state (state = '%s')",
+                     secureSession->GetStateStr());
+    }
+    else
+    {
+        mManager.SecureUnicastMessageDecrypted(mPacketHeader, mPayloadHeader, mSession, mPeerAddress, std::move(mMsg));
+    }
+
+    mManager.mDecryptJobPool.ReleaseObject(this);
+}
+
+void SessionManager::SecureUnicastDecryptJob::Abandon()
+{
+    mManager.mDecryptJobPool.ReleaseObject(this);
+}
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+
 /**
  * Helper function to implement a single attempt to decrypt a groupcast message
  * using the given group key and privacy setting.
@@ -1261,13 +1341,12 @@ Optional<SessionHandle> SessionManager::FindSecureSessionForNode(ScopedNodeId pe
     SecureSession * tcpSession = nullptr;
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
-    mSecureSessions.ForEachSession([&peerNodeId, &type, &mrpSession,
+    mSecureSessions.ForEachSessionForPeer(peerNodeId, [&type, &mrpSession,
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-                                    &tcpSession,
+                                                       &tcpSession,
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
-                                    &transportPayloadCapability](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == peerNodeId &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+                                                       &transportPayloadCapability](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
             if ((transportPayloadCapability == TransportPayloadCapability::kMRPOrTCPCompatiblePayload ||
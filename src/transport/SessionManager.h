@@ -41,6 +41,7 @@
 #include <transport/GroupPeerMessageCounter.h>
 #include <transport/GroupSession.h>
 #include <transport/MessageCounterManagerInterface.h>
+#include <transport/SecureMessageWorkerPool.h>
 #include <transport/SecureSessionTable.h>
 #include <transport/Session.h>
 #include <transport/SessionDelegate.h>
@@ -461,6 +462,20 @@ public:
     TransportMgrBase * GetTransportManager() const { return mTransportMgr; }
     Transport::SecureSessionTable & GetSecureSessions() { return mSecureSessions; }
 
+    /**
+     * @brief
+     *   Number of received secure unicast messages handed to the decryption worker threads and not yet dispatched.
+     *   Always 0 when CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS is 0.  Must be called with the stack lock held.
+     */
+    size_t GetPendingDecryptCount() const
+    {
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+        return mDecryptJobPool.Allocated();
+#else
+        return 0;
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+    }
+
     /**
      * @brief
      *   Handle received secure message. Implements TransportMgrDelegate
@@ -479,7 +494,16 @@ public:
 
     CHIP_ERROR TCPDisconnect(const Transport::PeerAddress & peerAddress);
 
-    void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0);
+    /**
+     * Close the connection, or if appState is given, release the hold of that user on the connection. The sessions over the
+     * connection are marked for eviction once it is closed.
+     *
+     * Sessions release their own hold by passing appState. Closing the connection for all of its users, without appState,
+     * is reserved to callers that own the whole connection, e.g. a connection no upper layer is interested in, or an
+     * explicit request to drop the connection to a peer.
+     */
+    void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0,
+                       Transport::AppTCPConnectionCallbackCtxt * appState = nullptr);
 
     void HandleConnectionReceived(Transport::ActiveTCPConnectionState * conn) override;
 
@@ -579,6 +603,41 @@ private:
 
     GlobalUnencryptedMessageCounter mGlobalUnencryptedMessageCounter;
 
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+    /**
+     * Decrypts one secure unicast message on a worker thread, then hands it to SecureUnicastMessageDecrypted() with the
+     * stack lock held.  Jobs are allocated and released only with the stack lock held, or by Shutdown() on the thread
+     * that shuts the stack down.
+     */
+    class SecureUnicastDecryptJob : public Transport::SecureMessageWorkerPool::Job
+    {
+    public:
+        SecureUnicastDecryptJob(SessionManager & manager, Transport::SecureSession & session, const PacketHeader & packetHeader,
+                                const Transport::PeerAddress & peerAddress, const CryptoContext::NonceStorage & nonce,
+                                System::PacketBufferHandle && msg) :
+            mManager(manager),
+            mSession(session), mPacketHeader(packetHeader), mPeerAddress(peerAddress), mNonce(nonce), mMsg(std::move(msg))
+        {}
+
+        void Process() override;
+        void Complete() override;
+        void Abandon() override;
+
+    private:
+        SessionManager & mManager;
+        SessionHandle mSession; // Keeps the session (and its keys) alive while the job is queued.
+        PacketHeader mPacketHeader;
+        PayloadHeader mPayloadHeader;
+        Transport::PeerAddress mPeerAddress;
+        CryptoContext::NonceStorage mNonce;
+        System::PacketBufferHandle mMsg;
+        CHIP_ERROR mDecryptError = CHIP_NO_ERROR;
+    };
+
+    Transport::SecureMessageWorkerPool mWorkerPool;
+    ObjectPool<SecureUnicastDecryptJob, CHIP_CONFIG_SECURE_MESSAGE_WORKER_QUEUE_DEPTH> mDecryptJobPool;
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+
     /**
      * @brief Parse, decrypt, validate, and dispatch a secure unicast message.
      *
@@ -592,6 +651,19 @@ private:
     void SecureUnicastMessageDispatch(const PacketHeader & partialPacketHeader, const Transport::PeerAddress & peerAddress,
                                       System::PacketBufferHandle && msg, Transport::MessageTransportContext * ctxt = nullptr);
 
+    /**
+     * @brief Validate the message counter of, and dispatch, a secure unicast message that has been decrypted.
+     *
+     * @param[in] packetHeader The fully decoded PacketHeader of the message.
+     * @param[in] payloadHeader The decrypted PayloadHeader of the message.
+     * @param[in] session The secure session the message was received on.
+     * @param[in] peerAddress The PeerAddress of the message as provided by the receiving Transport Endpoint.
+     * @param msg The decrypted message payload.
+     */
+    void SecureUnicastMessageDecrypted(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                       const SessionHandle & session, const Transport::PeerAddress & peerAddress,
+                                       System::PacketBufferHandle && msg);
+
     /**
      * @brief Parse, decrypt, validate, and dispatch a secure group message.
      *
@@ -40,9 +40,10 @@ void TransportMgrBase::TCPDisconnect(const Transport::PeerAddress & address)
     mTransport->TCPDisconnect(address);
 }
 
-void TransportMgrBase::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort)
+void TransportMgrBase::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort,
+                                     Transport::AppTCPConnectionCallbackCtxt * appState)
 {
-    mTransport->TCPDisconnect(conn, shouldAbort);
+    mTransport->TCPDisconnect(conn, shouldAbort, appState);
 }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
@@ -110,7 +111,7 @@ void TransportMgrBase::HandleConnectionReceived(Transport::ActiveTCPConnectionSt
         Transport::TCPBase * tcp = reinterpret_cast<Transport::TCPBase *>(conn->mEndPoint->mAppState);
 
         // Close connection here since no upper layer is interested in the
-        // connection.
+        // connection. A received connection has no users to leave it to.
         if (tcp)
         {
             tcp->TCPDisconnect(conn, /* shouldAbort = */ true);
@@ -128,11 +129,12 @@ void TransportMgrBase::HandleConnectionAttemptComplete(Transport::ActiveTCPConne
     {
         Transport::TCPBase * tcp = reinterpret_cast<Transport::TCPBase *>(conn->mEndPoint->mAppState);
 
-        // Close connection here since no upper layer is interested in the
-        // connection.
+        // Release the user that the attempt completed for, since no upper
+        // layer is interested in the connection. The connection is closed
+        // unless other users share it.
         if (tcp)
         {
-            tcp->TCPDisconnect(conn, /* shouldAbort = */ true);
+            tcp->TCPDisconnect(conn, /* shouldAbort = */ true, conn->mAppState);
         }
     }
 }
@@ -148,7 +150,7 @@ void TransportMgrBase::HandleConnectionClosed(Transport::ActiveTCPConnectionStat
         Transport::TCPBase * tcp = reinterpret_cast<Transport::TCPBase *>(conn->mEndPoint->mAppState);
         if (tcp)
         {
-            tcp->TCPDisconnect(conn, /* shouldAbort = */ true);
+            tcp->TCPDisconnect(conn, /* shouldAbort = */ true, conn->mAppState);
         }
     }
 }
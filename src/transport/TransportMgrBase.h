@@ -48,7 +48,8 @@ public:
 
     void TCPDisconnect(const Transport::PeerAddress & address);
 
-    void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0);
+    void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0,
+                       Transport::AppTCPConnectionCallbackCtxt * appState = nullptr);
 
     void HandleConnectionReceived(Transport::ActiveTCPConnectionState * conn) override;
 
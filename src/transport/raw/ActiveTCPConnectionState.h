@@ -58,6 +58,8 @@ struct ActiveTCPConnectionState
         mPeerAddr = peerAddr;
         mReceived = nullptr;
         mAppState = nullptr;
+
+        mReferenceCount = 0;
     }
 
     void Free()
@@ -67,6 +69,8 @@ struct ActiveTCPConnectionState
         mEndPoint = nullptr;
         mReceived = nullptr;
         mAppState = nullptr;
+
+        mReferenceCount = 0;
     }
 
     bool InUse() const { return mEndPoint != nullptr; }
@@ -95,8 +99,31 @@ struct ActiveTCPConnectionState
     // is created.
     // At various connection events, this state is passed back to the
     // corresponding application.
+    // When the connection is shared, this is the state of the user that the
+    // callback is for while a callback is called, and the state of the first
+    // user otherwise.
     AppTCPConnectionCallbackCtxt * mAppState = nullptr;
 
+    // A user of the connection: a caller of TCPConnect() that has not let go
+    // of it yet. Once established, the connection to a peer is shared by the
+    // later TCPConnect() calls to the same peer, so that several sessions run
+    // over it, and it is only closed once none of them holds it anymore.
+    struct User
+    {
+        AppTCPConnectionCallbackCtxt * mAppState = nullptr;
+
+        // The connection attempt complete callback of a user that joined the
+        // established connection is still to be called.
+        bool mConnectCompletePending = false;
+    };
+
+    // The first mReferenceCount entries are the users of the connection.
+    User mUsers[CHIP_CONFIG_MAX_TCP_CONNECTION_USERS];
+    uint8_t mReferenceCount = 0;
+
+    // Next connection in the same bucket of the transport's peer address index.
+    ActiveTCPConnectionState * mNextInIndex = nullptr;
+
     // KeepAlive interval in seconds
     uint16_t mTCPKeepAliveIntervalSecs = CHIP_CONFIG_TCP_KEEPALIVE_INTERVAL_SECS;
     uint16_t mTCPMaxNumKeepAliveProbes = CHIP_CONFIG_MAX_TCP_KEEPALIVE_PROBES;
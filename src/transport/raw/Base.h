@@ -111,9 +111,14 @@ public:
     virtual void TCPDisconnect(const PeerAddress & address) {}
 
     /**
-     * Disconnect on the active connection that is passed in.
+     * Disconnect on the active connection that is passed in. If appState is given, only release the hold of that user on
+     * the connection, which stays open for its other users. Without appState, the connection is closed for all of its
+     * users: this is meant for the owner of the whole connection, e.g. when no upper layer is interested in it or on an
+     * explicit request to drop it.
      */
-    virtual void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0) {}
+    virtual void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0,
+                               Transport::AppTCPConnectionCallbackCtxt * appState = nullptr)
+    {}
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
     /**
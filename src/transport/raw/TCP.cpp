@@ -30,6 +30,7 @@
 #include <lib/support/logging/CHIPLogging.h>
 #include <transport/raw/MessageHeader.h>
 
+#include <algorithm>
 #include <inttypes.h>
 #include <limits>
 
@@ -51,12 +52,33 @@ constexpr uint32_t kMaxTCPMessageSize =
 
 constexpr int kListenBacklogSize = 2;
 
+static_assert(CHIP_CONFIG_MAX_TCP_CONNECTION_USERS >= 1 && CHIP_CONFIG_MAX_TCP_CONNECTION_USERS <= UINT8_MAX,
+              "A connection has at least one and at most 255 users");
+
+ActiveTCPConnectionState::User * FindConnectCompletePendingUser(ActiveTCPConnectionState * connection)
+{
+    for (uint8_t i = 0; i < connection->mReferenceCount; i++)
+    {
+        if (connection->mUsers[i].mConnectCompletePending)
+        {
+            return &connection->mUsers[i];
+        }
+    }
+    return nullptr;
+}
+
 } // namespace
 
 TCPBase::~TCPBase()
 {
     if (mListenSocket != nullptr)
     {
+        if (mConnectCompleteScheduled)
+        {
+            mListenSocket->GetSystemLayer().CancelTimer(HandlePendingConnectComplete, this);
+            mConnectCompleteScheduled = false;
+        }
+
         // endpoint is only non null if it is initialized and listening
         mListenSocket->Free();
         mListenSocket = nullptr;
@@ -122,6 +144,11 @@ void TCPBase::Close()
 {
     if (mListenSocket)
     {
+        if (mConnectCompleteScheduled)
+        {
+            mListenSocket->GetSystemLayer().CancelTimer(HandlePendingConnectComplete, this);
+            mConnectCompleteScheduled = false;
+        }
         mListenSocket->Free();
         mListenSocket = nullptr;
     }
@@ -149,23 +176,135 @@ ActiveTCPConnectionState * TCPBase::FindActiveConnection(const PeerAddress & add
         return nullptr;
     }
 
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    // Compare against the peer address recorded for the connection rather than asking each endpoint for it,
+    // which costs a system call per connection on sockets platforms.
+    ActiveTCPConnectionState * connection = mConnectionIndex[GetIndexBucket(address)];
+    for (; connection != nullptr; connection = connection->mNextInIndex)
     {
-        if (!mActiveConnections[i].IsConnected())
+        if (connection->IsConnected() && connection->mPeerAddr.GetIPAddress() == address.GetIPAddress() &&
+            connection->mPeerAddr.GetPort() == address.GetPort())
         {
-            continue;
+            return connection;
         }
-        Inet::IPAddress addr;
-        uint16_t port;
-        mActiveConnections[i].mEndPoint->GetPeerInfo(&addr, &port);
+    }
+
+    return nullptr;
+}
+
+size_t TCPBase::GetIndexBucket(const PeerAddress & address) const
+{
+    // The interface is left out, as it may not have been provided when the connection was set up.
+    uint32_t hash = address.GetPort();
+    for (uint32_t word : address.GetIPAddress().Addr)
+    {
+        hash = hash * 31 + word;
+    }
+    return hash % mActiveConnectionsSize;
+}
+
+void TCPBase::AddToIndex(ActiveTCPConnectionState * connection)
+{
+    ActiveTCPConnectionState *& head = mConnectionIndex[GetIndexBucket(connection->mPeerAddr)];
+    connection->mNextInIndex         = head;
+    head                             = connection;
+}
 
-        if ((addr == address.GetIPAddress()) && (port == address.GetPort()))
+void TCPBase::RemoveFromIndex(ActiveTCPConnectionState * connection)
+{
+    ActiveTCPConnectionState ** link = &mConnectionIndex[GetIndexBucket(connection->mPeerAddr)];
+    for (; *link != nullptr; link = &(*link)->mNextInIndex)
+    {
+        if (*link == connection)
         {
-            return &mActiveConnections[i];
+            *link                    = connection->mNextInIndex;
+            connection->mNextInIndex = nullptr;
+            return;
         }
     }
+}
 
-    return nullptr;
+void TCPBase::AddConnectionUser(ActiveTCPConnectionState * connection, AppTCPConnectionCallbackCtxt * appState,
+                                bool connectCompletePending)
+{
+    ActiveTCPConnectionState::User & user = connection->mUsers[connection->mReferenceCount++];
+    user.mAppState                        = appState;
+    user.mConnectCompletePending          = connectCompletePending;
+
+    if (connection->mReferenceCount == 1)
+    {
+        connection->mAppState = appState;
+    }
+}
+
+bool TCPBase::ReleaseConnectionUser(ActiveTCPConnectionState * connection, AppTCPConnectionCallbackCtxt * appState)
+{
+    for (uint8_t i = 0; i < connection->mReferenceCount; i++)
+    {
+        if (connection->mUsers[i].mAppState == appState)
+        {
+            connection->mReferenceCount--;
+            std::copy(connection->mUsers + i + 1, connection->mUsers + connection->mReferenceCount + 1, connection->mUsers + i);
+            break;
+        }
+    }
+
+    if (connection->mAppState == appState)
+    {
+        connection->mAppState = (connection->mReferenceCount > 0) ? connection->mUsers[0].mAppState : nullptr;
+    }
+
+    return connection->mReferenceCount > 0;
+}
+
+bool TCPBase::HandOverConnectionUser(ActiveTCPConnectionState * connection, AppTCPConnectionCallbackCtxt * appState,
+                                     AppTCPConnectionCallbackCtxt * newAppState)
+{
+    for (uint8_t i = 0; i < connection->mReferenceCount; i++)
+    {
+        ActiveTCPConnectionState::User & user = connection->mUsers[i];
+        if (user.mAppState == appState)
+        {
+            user.mAppState               = newAppState;
+            user.mConnectCompletePending = false;
+            if (connection->mAppState == appState)
+            {
+                connection->mAppState = newAppState;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TCPBase::HandlePendingConnectComplete(System::Layer * systemLayer, void * appState)
+{
+    TCPBase * tcp                  = reinterpret_cast<TCPBase *>(appState);
+    tcp->mConnectCompleteScheduled = false;
+
+    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
+    {
+        ActiveTCPConnectionState * connection = &tcp->mActiveConnections[i];
+
+        // The users are looked up again after each callback, which may release a user or close the connection.
+        while (connection->IsConnected())
+        {
+            ActiveTCPConnectionState::User * user = FindConnectCompletePendingUser(connection);
+            if (user == nullptr)
+            {
+                break;
+            }
+
+            user->mConnectCompletePending = false;
+            connection->mAppState         = user->mAppState;
+            tcp->HandleConnectionAttemptComplete(connection, CHIP_NO_ERROR);
+        }
+
+        if (connection->InUse())
+        {
+            connection->mAppState = (connection->mReferenceCount > 0) ? connection->mUsers[0].mAppState : nullptr;
+        }
+    }
 }
 
 // Find the ActiveTCPConnectionState for a given TCPEndPoint
@@ -248,14 +387,18 @@ CHIP_ERROR TCPBase::StartConnect(const PeerAddress & addr, Transport::AppTCPConn
     activeConnection = AllocateConnection();
     VerifyOrReturnError(activeConnection != nullptr, CHIP_ERROR_NO_MEMORY);
     activeConnection->Init(endPoint, addr);
-    activeConnection->mAppState        = appState;
     activeConnection->mConnectionState = TCPState::kConnecting;
+    if (appState != nullptr)
+    {
+        AddConnectionUser(activeConnection, appState, /* connectCompletePending = */ false);
+    }
     // Set the return value of the peer connection state to the allocated
     // connection.
     *outPeerConnState = activeConnection;
 
     ReturnErrorOnFailure(endPoint->Connect(addr.GetIPAddress(), addr.GetPort(), addr.GetInterface()));
 
+    AddToIndex(activeConnection);
     mUsedEndPointCount++;
 
     endPointHolder.release();
@@ -416,23 +559,46 @@ void TCPBase::CloseConnectionInternal(ActiveTCPConnectionState * connection, CHI
 
         if (suppressCallback == SuppressCallback::No)
         {
-            if (prevState == TCPState::kConnecting)
+            if (connection->mReferenceCount == 0)
             {
-                // Call upper layer connection attempt complete handler
-                HandleConnectionAttemptComplete(connection, err);
+                NotifyConnectionClosed(connection, prevState, /* connectCompletePending = */ false, err);
             }
             else
             {
-                // Call upper layer connection closed handler
-                HandleConnectionClosed(connection, err);
+                // Every user of a shared connection hears about it. The users are copied first, as they may let go of
+                // the connection from the callbacks.
+                ActiveTCPConnectionState::User users[CHIP_CONFIG_MAX_TCP_CONNECTION_USERS];
+                const uint8_t userCount = connection->mReferenceCount;
+                std::copy(connection->mUsers, connection->mUsers + userCount, users);
+                for (uint8_t i = 0; i < userCount; i++)
+                {
+                    connection->mAppState = users[i].mAppState;
+                    NotifyConnectionClosed(connection, prevState, users[i].mConnectCompletePending, err);
+                }
             }
         }
 
+        RemoveFromIndex(connection);
         connection->Free();
         mUsedEndPointCount--;
     }
 }
 
+void TCPBase::NotifyConnectionClosed(ActiveTCPConnectionState * connection, TCPState prevState, bool connectCompletePending,
+                                     CHIP_ERROR err)
+{
+    if (prevState == TCPState::kConnecting || connectCompletePending)
+    {
+        // Call upper layer connection attempt complete handler
+        HandleConnectionAttemptComplete(connection, err);
+    }
+    else
+    {
+        // Call upper layer connection closed handler
+        HandleConnectionClosed(connection, err);
+    }
+}
+
 CHIP_ERROR TCPBase::HandleTCPEndPointDataReceived(Inet::TCPEndPoint * endPoint, System::PacketBufferHandle && buffer)
 {
     Inet::IPAddress ipAddress;
@@ -575,6 +741,7 @@ void TCPBase::HandleIncomingConnection(Inet::TCPEndPoint * listenEndPoint, Inet:
 
         // Update state for the active connection
         activeConnection->Init(endPoint, addr);
+        tcp->AddToIndex(activeConnection);
         tcp->mUsedEndPointCount++;
         activeConnection->mConnectionState = TCPState::kConnected;
 
@@ -607,10 +774,29 @@ CHIP_ERROR TCPBase::TCPConnect(const PeerAddress & address, Transport::AppTCPCon
     // Verify that PeerAddress AddressType is TCP
     VerifyOrReturnError(address.GetTransportType() == Transport::Type::kTcp, CHIP_ERROR_INVALID_ARGUMENT);
 
-    VerifyOrReturnError(mUsedEndPointCount < mActiveConnectionsSize, CHIP_ERROR_NO_MEMORY);
-
     char addrStr[Transport::PeerAddress::kMaxToStringSize];
     address.ToString(addrStr);
+
+    // Share an established connection to the peer, so that a new session does not pay for a new connection.
+    ActiveTCPConnectionState * connection = FindActiveConnection(address);
+    if (connection != nullptr && appState != nullptr && connection->mReferenceCount < ArraySize(connection->mUsers))
+    {
+        ChipLogProgress(Inet, "Reusing connection to peer %s.", addrStr);
+
+        // As for a new connection, the caller hears that it is connected once this call has returned.
+        if (!mConnectCompleteScheduled)
+        {
+            ReturnErrorOnFailure(mListenSocket->GetSystemLayer().ScheduleWork(HandlePendingConnectComplete, this));
+            mConnectCompleteScheduled = true;
+        }
+
+        AddConnectionUser(connection, appState, /* connectCompletePending = */ true);
+        *outPeerConnState = connection;
+        return CHIP_NO_ERROR;
+    }
+
+    VerifyOrReturnError(mUsedEndPointCount < mActiveConnectionsSize, CHIP_ERROR_NO_MEMORY);
+
     ChipLogProgress(Inet, "Connecting to peer %s.", addrStr);
 
     ReturnErrorOnFailure(StartConnect(address, appState, outPeerConnState));
@@ -643,7 +829,8 @@ void TCPBase::TCPDisconnect(const PeerAddress & address)
     }
 }
 
-void TCPBase::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort)
+void TCPBase::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort,
+                            Transport::AppTCPConnectionCallbackCtxt * appState)
 {
 
     if (conn == nullptr)
@@ -652,6 +839,12 @@ void TCPBase::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool sho
         return;
     }
 
+    // Never close a connection that other users still hold.
+    if (appState != nullptr && ReleaseConnectionUser(conn, appState))
+    {
+        return;
+    }
+
     // This call should be able to disconnect the connection either when it is
     // already established, or when it is being set up.
     if ((conn->IsConnected() && shouldAbort) || conn->IsConnecting())
@@ -118,10 +118,12 @@ protected:
 
 public:
     using PendingPacketPoolType = PoolInterface<PendingPacket, const PeerAddress &, System::PacketBufferHandle &&>;
-    TCPBase(ActiveTCPConnectionState * activeConnectionsBuffer, size_t bufferSize, PendingPacketPoolType & packetBuffers) :
-        mActiveConnections(activeConnectionsBuffer), mActiveConnectionsSize(bufferSize), mPendingPackets(packetBuffers)
+    TCPBase(ActiveTCPConnectionState * activeConnectionsBuffer, ActiveTCPConnectionState ** connectionIndexBuffer, size_t bufferSize,
+            PendingPacketPoolType & packetBuffers) :
+        mActiveConnections(activeConnectionsBuffer),
+        mConnectionIndex(connectionIndexBuffer), mActiveConnectionsSize(bufferSize), mPendingPackets(packetBuffers)
     {
-        // activeConnectionsBuffer must be initialized by the caller.
+        // activeConnectionsBuffer and connectionIndexBuffer must be initialized by the caller.
     }
     ~TCPBase() override;
 
@@ -167,6 +169,11 @@ public:
      *                          connection attempt if the caller object dies
      *                          before the attempt completes.
      *
+     * If a connection to the peer is already established (e.g. one that was
+     * set up for an earlier CASE session), it is shared with the caller: the
+     * connection attempt complete callback for appState is called once this
+     * method has returned, as it would be for a new connection.
+     *
      */
     CHIP_ERROR TCPConnect(const PeerAddress & address, Transport::AppTCPConnectionCallbackCtxt * appState,
                           Transport::ActiveTCPConnectionState ** outPeerConnState) override;
@@ -176,7 +183,21 @@ public:
     // Close an active connection (corresponding to the passed
     // ActiveTCPConnectionState object)
     // and release from the pool.
-    void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = false) override;
+    // If appState is given, only the hold of that user on the connection is
+    // released, and the connection is left open for its other users if any.
+    // Without appState, the connection is closed for all of its users; only
+    // callers that own the whole connection should do that.
+    void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = false,
+                       Transport::AppTCPConnectionCallbackCtxt * appState = nullptr) override;
+
+    /**
+     * Hand the hold of appState on a connection over to newAppState, so that
+     * the connection outlives appState, e.g. the CASE session that set it up,
+     * and is released by newAppState instead. Returns false if appState does
+     * not hold the connection.
+     */
+    static bool HandOverConnectionUser(ActiveTCPConnectionState * connection, AppTCPConnectionCallbackCtxt * appState,
+                                       AppTCPConnectionCallbackCtxt * newAppState);
 
     bool CanSendToPeer(const PeerAddress & address) override
     {
@@ -220,6 +241,27 @@ private:
     ActiveTCPConnectionState * FindActiveConnection(const PeerAddress & addr);
     ActiveTCPConnectionState * FindActiveConnection(const Inet::TCPEndPoint * endPoint);
 
+    /**
+     * Maintain the index of connections by peer address used by FindActiveConnection(). A connection is
+     * in the index from the time its endpoint is attached until it is closed.
+     */
+    size_t GetIndexBucket(const PeerAddress & addr) const;
+    void AddToIndex(ActiveTCPConnectionState * connection);
+    void RemoveFromIndex(ActiveTCPConnectionState * connection);
+
+    /**
+     * Maintain the users of a connection, see ActiveTCPConnectionState::mUsers. ReleaseConnectionUser() returns
+     * whether other users still hold the connection.
+     */
+    static void AddConnectionUser(ActiveTCPConnectionState * connection, AppTCPConnectionCallbackCtxt * appState,
+                                  bool connectCompletePending);
+    static bool ReleaseConnectionUser(ActiveTCPConnectionState * connection, AppTCPConnectionCallbackCtxt * appState);
+
+    /**
+     * Call the connection attempt complete callback of the users that joined an established connection.
+     */
+    static void HandlePendingConnectComplete(System::Layer * systemLayer, void * appState);
+
     /**
      * Find an allocated connection that matches the corresponding TCPEndPoint.
      */
@@ -274,6 +316,12 @@ private:
      */
     void CloseConnectionInternal(ActiveTCPConnectionState * connection, CHIP_ERROR err, SuppressCallback suppressCallback);
 
+    /**
+     * Call the connection attempt complete or closed callback for the user of a connection being closed in mAppState.
+     */
+    void NotifyConnectionClosed(ActiveTCPConnectionState * connection, TCPState prevState, bool connectCompletePending,
+                                CHIP_ERROR err);
+
     // Close the listening socket endpoint
     void CloseListeningSocket();
 
@@ -309,8 +357,14 @@ private:
     // Number of active and 'pending connection' endpoints
     size_t mUsedEndPointCount = 0;
 
+    // Whether HandlePendingConnectComplete() is scheduled to run.
+    bool mConnectCompleteScheduled = false;
+
     // Currently active connections
     ActiveTCPConnectionState * mActiveConnections;
+
+    // Heads of the buckets of the connection index by peer address, mActiveConnectionsSize of them.
+    ActiveTCPConnectionState ** mConnectionIndex;
     const size_t mActiveConnectionsSize;
 
     // Data to be sent when connections succeed
@@ -321,11 +375,12 @@ template <size_t kActiveConnectionsSize, size_t kPendingPacketSize>
 class TCP : public TCPBase
 {
 public:
-    TCP() : TCPBase(mConnectionsBuffer, kActiveConnectionsSize, mPendingPackets)
+    TCP() : TCPBase(mConnectionsBuffer, mConnectionIndexBuffer, kActiveConnectionsSize, mPendingPackets)
     {
         for (size_t i = 0; i < kActiveConnectionsSize; ++i)
         {
             mConnectionsBuffer[i].Init(nullptr, PeerAddress::Uninitialized());
+            mConnectionIndexBuffer[i] = nullptr;
         }
     }
 
@@ -333,6 +388,7 @@ public:
 
 private:
     ActiveTCPConnectionState mConnectionsBuffer[kActiveConnectionsSize];
+    ActiveTCPConnectionState * mConnectionIndexBuffer[kActiveConnectionsSize];
     PoolImpl<PendingPacket, kPendingPacketSize, ObjectPoolMem::kInline, PendingPacketPoolType::Interface> mPendingPackets;
 };
 
@@ -53,6 +53,15 @@ namespace chip {
 #error "If TCP is enabled, the maximum number of connections cannot exceed the number of tcp endpoints"
 #endif
 
+/**
+ * @def CHIP_CONFIG_MAX_TCP_CONNECTION_USERS
+ *
+ * @brief Maximum number of TCPConnect() callers, e.g. CASE sessions, that may share a TCP connection to a peer
+ */
+#ifndef CHIP_CONFIG_MAX_TCP_CONNECTION_USERS
+#define CHIP_CONFIG_MAX_TCP_CONNECTION_USERS 4
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_TCP_PENDING_PACKETS
  *
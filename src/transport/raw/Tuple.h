@@ -102,9 +102,10 @@ public:
 
     void TCPDisconnect(const PeerAddress & address) override { return TCPDisconnectImpl<0>(address); }
 
-    void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0) override
+    void TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0,
+                       Transport::AppTCPConnectionCallbackCtxt * appState = nullptr) override
     {
-        return TCPDisconnectImpl<0>(conn, shouldAbort);
+        return TCPDisconnectImpl<0>(conn, shouldAbort, appState);
     }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
@@ -208,19 +209,22 @@ private:
      * @tparam N the index of the underlying transport to send disconnect to
      *
      * @param conn pointer to the connection to the peer.
+     * @param appState the user of the connection that lets go of it, if not all of them.
      */
     template <size_t N, typename std::enable_if<(N < sizeof...(TransportTypes))>::type * = nullptr>
-    void TCPDisconnectImpl(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0)
+    void TCPDisconnectImpl(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0,
+                           Transport::AppTCPConnectionCallbackCtxt * appState = nullptr)
     {
-        std::get<N>(mTransports).TCPDisconnect(conn, shouldAbort);
-        TCPDisconnectImpl<N + 1>(conn, shouldAbort);
+        std::get<N>(mTransports).TCPDisconnect(conn, shouldAbort, appState);
+        TCPDisconnectImpl<N + 1>(conn, shouldAbort, appState);
     }
 
     /**
      * TCPDisconnectImpl template for out of range N.
      */
     template <size_t N, typename std::enable_if<(N >= sizeof...(TransportTypes))>::type * = nullptr>
-    void TCPDisconnectImpl(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0)
+    void TCPDisconnectImpl(Transport::ActiveTCPConnectionState * conn, bool shouldAbort = 0,
+                           Transport::AppTCPConnectionCallbackCtxt * appState = nullptr)
     {}
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
@@ -55,6 +55,7 @@ constexpr size_t kMaxTcpPendingPackets        = 4;
 constexpr size_t kPacketSizeBytes             = sizeof(uint32_t);
 uint16_t gChipTCPPort                         = static_cast<uint16_t>(CHIP_PORT + chip::Crypto::GetRandU16() % 100);
 chip::Transport::AppTCPConnectionCallbackCtxt gAppTCPConnCbCtxt;
+chip::Transport::AppTCPConnectionCallbackCtxt gSecondAppTCPConnCbCtxt;
 chip::Transport::ActiveTCPConnectionState * gActiveTCPConnState = nullptr;
 
 using TCPImpl    = Transport::TCP<kMaxTcpActiveConnectionCount, kMaxTcpPendingPackets>;
@@ -175,6 +176,8 @@ public:
         gAppTCPConnCbCtxt.connReceivedCb = nullptr;
         gAppTCPConnCbCtxt.connCompleteCb = nullptr;
         gAppTCPConnCbCtxt.connClosedCb   = nullptr;
+
+        gSecondAppTCPConnCbCtxt = chip::Transport::AppTCPConnectionCallbackCtxt();
     }
 
     void SingleMessageTest(TCPImpl & tcp, const IPAddress & addr)
@@ -201,6 +204,134 @@ public:
         SetCallback(nullptr);
     }
 
+    void PipelinedMessagesTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        constexpr int kMessageCount = 3;
+
+        SetCallback([](const uint8_t * message, size_t length, int count, void * data) { return memcmp(message, data, length); },
+                    const_cast<void *>(static_cast<const void *>(PAYLOAD)));
+
+        // Messages sent before the connection is established are queued, then sent together once it is.
+        for (int i = 0; i < kMessageCount; i++)
+        {
+            chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+            ASSERT_FALSE(buffer.IsNull());
+
+            PacketHeader header;
+            header.SetSourceNodeId(kSourceNodeId)
+                .SetDestinationNodeId(kDestinationNodeId)
+                .SetMessageCounter(kMessageCounter + static_cast<uint32_t>(i));
+            EXPECT_EQ(header.EncodeBeforeData(buffer), CHIP_NO_ERROR);
+
+            EXPECT_EQ(tcp.SendMessage(Transport::PeerAddress::TCP(addr, gChipTCPPort), std::move(buffer)), CHIP_NO_ERROR);
+        }
+
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5),
+                                 [this]() { return mReceiveHandlerCallCount == kMessageCount; });
+        EXPECT_EQ(mReceiveHandlerCallCount, kMessageCount);
+
+        SetCallback(nullptr);
+    }
+
+    void ReuseConnectionTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        HandleConnectCompleteCbCalledTest(tcp, addr);
+        chip::Transport::ActiveTCPConnectionState * firstConnState = gActiveTCPConnState;
+
+        // Connecting to the same peer again shares the established connection. The second user hears that it is
+        // connected once TCPConnect() has returned, as for a new connection.
+        mHandleConnectionCompleteCalled                             = false;
+        chip::Transport::ActiveTCPConnectionState * secondConnState = nullptr;
+        CHIP_ERROR err =
+            tcp.TCPConnect(Transport::PeerAddress::TCP(addr, gChipTCPPort), &gSecondAppTCPConnCbCtxt, &secondConnState);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(secondConnState, firstConnState);
+        EXPECT_FALSE(mHandleConnectionCompleteCalled);
+
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [this]() { return mHandleConnectionCompleteCalled; });
+        EXPECT_TRUE(mHandleConnectionCompleteCalled);
+        EXPECT_EQ(firstConnState->mReferenceCount, 2u);
+
+        // Either user letting go of the connection leaves it open for the other one.
+        tcp.TCPDisconnect(secondConnState, /* shouldAbort = */ true, &gSecondAppTCPConnCbCtxt);
+        EXPECT_TRUE(firstConnState->IsConnected());
+        EXPECT_EQ(firstConnState->mReferenceCount, 1u);
+        EXPECT_EQ(firstConnState->mAppState, &gAppTCPConnCbCtxt);
+    }
+
+    void ReuseConnectionFailingSessionTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        HandleConnectCompleteCbCalledTest(tcp, addr);
+        chip::Transport::ActiveTCPConnectionState * firstConnState = gActiveTCPConnState;
+
+        // The second session fails as soon as it is connected and aborts the connection, as CASESession does.
+        gSecondAppTCPConnCbCtxt.appContext     = &tcp;
+        gSecondAppTCPConnCbCtxt.connCompleteCb = [](chip::Transport::ActiveTCPConnectionState * conn, CHIP_ERROR conErr) {
+            EXPECT_EQ(conErr, CHIP_NO_ERROR);
+            EXPECT_EQ(conn->mAppState, &gSecondAppTCPConnCbCtxt);
+            static_cast<TCPImpl *>(conn->mAppState->appContext)->TCPDisconnect(conn, /* shouldAbort = */ true, conn->mAppState);
+        };
+
+        mHandleConnectionCompleteCalled                             = false;
+        chip::Transport::ActiveTCPConnectionState * secondConnState = nullptr;
+        CHIP_ERROR err =
+            tcp.TCPConnect(Transport::PeerAddress::TCP(addr, gChipTCPPort), &gSecondAppTCPConnCbCtxt, &secondConnState);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(secondConnState, firstConnState);
+
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [this]() { return mHandleConnectionCompleteCalled; });
+        EXPECT_TRUE(mHandleConnectionCompleteCalled);
+
+        // The first session keeps its connection, and can still send over it.
+        EXPECT_TRUE(firstConnState->IsConnected());
+        EXPECT_EQ(firstConnState->mReferenceCount, 1u);
+        EXPECT_EQ(firstConnState->mAppState, &gAppTCPConnCbCtxt);
+        EXPECT_FALSE(mHandleConnectionCloseCalled);
+        SingleMessageTest(tcp, addr);
+    }
+
+    void ReuseConnectionWithoutSessionManagerTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        HandleConnectCompleteCbCalledTest(tcp, addr);
+        chip::Transport::ActiveTCPConnectionState * firstConnState = gActiveTCPConnState;
+
+        // With no upper layer to hand the second user to, the transport manager releases that user only, and the
+        // connection stays open for the first one.
+        mTransportMgrBase.SetSessionManager(nullptr);
+        chip::Transport::ActiveTCPConnectionState * secondConnState = nullptr;
+        CHIP_ERROR err =
+            tcp.TCPConnect(Transport::PeerAddress::TCP(addr, gChipTCPPort), &gSecondAppTCPConnCbCtxt, &secondConnState);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(secondConnState, firstConnState);
+        EXPECT_EQ(firstConnState->mReferenceCount, 2u);
+
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5),
+                                 [firstConnState]() { return firstConnState->mReferenceCount == 1; });
+        mTransportMgrBase.SetSessionManager(this);
+
+        EXPECT_TRUE(firstConnState->IsConnected());
+        EXPECT_EQ(firstConnState->mReferenceCount, 1u);
+        EXPECT_EQ(firstConnState->mAppState, &gAppTCPConnCbCtxt);
+    }
+
+    void ForceCloseSharedConnectionTest(TCPImpl & tcp, const IPAddress & addr)
+    {
+        HandleConnectCompleteCbCalledTest(tcp, addr);
+        chip::Transport::ActiveTCPConnectionState * connState = gActiveTCPConnState;
+
+        chip::Transport::ActiveTCPConnectionState * secondConnState = nullptr;
+        CHIP_ERROR err =
+            tcp.TCPConnect(Transport::PeerAddress::TCP(addr, gChipTCPPort), &gSecondAppTCPConnCbCtxt, &secondConnState);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(connState->mReferenceCount, 2u);
+
+        // Disconnecting without a user closes the connection for all of its users.
+        tcp.TCPDisconnect(connState, /* shouldAbort = */ true);
+        EXPECT_FALSE(connState->IsConnected());
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [&tcp]() { return !tcp.HasActiveConnections(); });
+        EXPECT_FALSE(tcp.HasActiveConnections());
+    }
+
     void ConnectTest(TCPImpl & tcp, const IPAddress & addr)
     {
         // Connect and wait for seeing active connection
@@ -506,6 +637,55 @@ protected:
         gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
     }
 
+    void PipelinedMessagesTest(const IPAddress & addr)
+    {
+        TCPImpl tcp;
+
+        MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+        gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+        gMockTransportMgrDelegate.PipelinedMessagesTest(tcp, addr);
+        gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
+    }
+
+    void ReuseConnectionTest(const IPAddress & addr)
+    {
+        TCPImpl tcp;
+
+        MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+        gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+        gMockTransportMgrDelegate.ReuseConnectionTest(tcp, addr);
+        gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
+    }
+
+    void ReuseConnectionFailingSessionTest(const IPAddress & addr)
+    {
+        TCPImpl tcp;
+
+        MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+        gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+        gMockTransportMgrDelegate.ReuseConnectionFailingSessionTest(tcp, addr);
+        gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
+    }
+
+    void ReuseConnectionWithoutSessionManagerTest(const IPAddress & addr)
+    {
+        TCPImpl tcp;
+
+        MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+        gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+        gMockTransportMgrDelegate.ReuseConnectionWithoutSessionManagerTest(tcp, addr);
+        gMockTransportMgrDelegate.DisconnectTest(tcp, addr);
+    }
+
+    void ForceCloseSharedConnectionTest(const IPAddress & addr)
+    {
+        TCPImpl tcp;
+
+        MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+        gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+        gMockTransportMgrDelegate.ForceCloseSharedConnectionTest(tcp, addr);
+    }
+
     // Callback used by CheckProcessReceivedBuffer.
     static int TestDataCallbackCheck(const uint8_t * message, size_t length, int count, void * data)
     {
@@ -609,6 +789,41 @@ TEST_F(TestTCP, HandleConnCloseCalledTest6)
     HandleConnCloseTest(addr);
 }
 
+TEST_F(TestTCP, PipelinedMessagesTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    PipelinedMessagesTest(addr);
+}
+
+TEST_F(TestTCP, ReuseConnectionTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    ReuseConnectionTest(addr);
+}
+
+TEST_F(TestTCP, ReuseConnectionFailingSessionTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    ReuseConnectionFailingSessionTest(addr);
+}
+
+TEST_F(TestTCP, ReuseConnectionWithoutSessionManagerTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    ReuseConnectionWithoutSessionManagerTest(addr);
+}
+
+TEST_F(TestTCP, ForceCloseSharedConnectionTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    ForceCloseSharedConnectionTest(addr);
+}
+
 TEST_F(TestTCP, CheckProcessReceivedBuffer)
 {
     TCPImpl tcp;
@@ -17,9 +17,17 @@
 
 #include <lib/core/CHIPError.h>
 #include <lib/support/CodeUtils.h>
+#include <transport/SessionManager.h>
 #include <transport/TransportMgr.h>
 #include <transport/raw/tests/NetworkTestHelpers.h>
 
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+#include <platform/PlatformManager.h>
+
+#include <chrono>
+#include <thread>
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+
 namespace chip {
 namespace Test {
 
@@ -99,6 +107,36 @@ public:
         }
     }
 
+    /*
+     * Same as DrainAndServiceIO, but also waits for the secure messages handed to the decryption worker
+     * threads of the given session manager to be dispatched, so that callers can check the received
+     * messages right after it whether CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS is set or not.
+     *
+     * When the worker threads are enabled, this must be called with the stack lock held, as they
+     * dispatch the messages with the stack lock held.
+     */
+    void DrainAndServiceIO(SessionManager & sessionManager, System::Clock::Timeout maxWait = chip::System::Clock::Seconds16(5))
+    {
+        System::Clock::Timestamp startTime = System::SystemClock().GetMonotonicTimestamp();
+
+        do
+        {
+            DrainAndServiceIO(maxWait);
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+            while (sessionManager.GetPendingDecryptCount() > 0 &&
+                   (System::SystemClock().GetMonotonicTimestamp() - startTime) < maxWait)
+            {
+                DeviceLayer::PlatformMgr().UnlockChipStack();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                DeviceLayer::PlatformMgr().LockChipStack();
+            }
+#else
+            (void) sessionManager;
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+            // The dispatched messages might have been answered.
+        } while (GetLoopback().HasPendingMessages() && (System::SystemClock().GetMonotonicTimestamp() - startTime) < maxWait);
+    }
+
 private:
     Test::IOContext mIOContext;
     TransportMgr<LoopbackTransport> mTransportManager;
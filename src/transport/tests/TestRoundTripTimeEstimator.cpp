@@ -0,0 +1,81 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the RoundTripTimeEstimator.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <transport/RoundTripTimeEstimator.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+using chip::Transport::RoundTripTimeEstimator;
+
+TEST(TestRoundTripTimeEstimator, FirstSample)
+{
+    RoundTripTimeEstimator estimator;
+    EXPECT_FALSE(estimator.HasEstimate());
+
+    estimator.AddSample(100_ms32);
+    EXPECT_TRUE(estimator.HasEstimate());
+    EXPECT_EQ(estimator.GetSampleCount(), 1u);
+    EXPECT_EQ(estimator.GetSmoothedRoundTripTime(), 100_ms32);
+    EXPECT_EQ(estimator.GetRoundTripTimeVariation(), 50_ms32);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(), 300_ms32);
+
+    estimator.Reset();
+    EXPECT_FALSE(estimator.HasEstimate());
+}
+
+TEST(TestRoundTripTimeEstimator, SmoothsSamples)
+{
+    RoundTripTimeEstimator estimator;
+
+    estimator.AddSample(100_ms32);
+    estimator.AddSample(200_ms32);
+    EXPECT_EQ(estimator.GetSmoothedRoundTripTime(), 112_ms32);
+    EXPECT_EQ(estimator.GetRoundTripTimeVariation(), 62_ms32);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(), 362_ms32);
+
+    // A steady round-trip time brings the timeout down towards it.
+    for (int i = 0; i < 100; i++)
+    {
+        estimator.AddSample(200_ms32);
+    }
+    EXPECT_EQ(estimator.GetSmoothedRoundTripTime(), 200_ms32);
+    EXPECT_LE(estimator.GetRetransmissionTimeout(), 210_ms32);
+}
+
+TEST(TestRoundTripTimeEstimator, TimeoutIsAboveClockGranularity)
+{
+    RoundTripTimeEstimator estimator;
+
+    estimator.AddSample(0_ms32);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(), RoundTripTimeEstimator::kClockGranularity);
+
+    estimator.AddSample(System::Clock::Milliseconds32(UINT32_MAX));
+    EXPECT_GT(estimator.GetRetransmissionTimeout(), estimator.GetSmoothedRoundTripTime());
+}
+
+} // namespace
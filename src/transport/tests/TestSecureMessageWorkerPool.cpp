@@ -0,0 +1,376 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the SecureMessageWorkerPool, including the AES-CCM
+ *      decryption of messages from many simulated peers with different numbers of worker threads.
+ */
+
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <transport/SecureMessageWorkerPool.h>
+
+using namespace chip;
+using namespace chip::Transport;
+
+namespace {
+
+// Stands in for the Matter stack lock.
+std::mutex sStackLock;
+
+void LockStack()
+{
+    sStackLock.lock();
+}
+
+bool TryLockStack()
+{
+    return sStackLock.try_lock();
+}
+
+void UnlockStack()
+{
+    sStackLock.unlock();
+}
+
+class TestSecureMessageWorkerPool : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+// Records the order in which jobs complete for each peer.
+class OrderedJob : public SecureMessageWorkerPool::Job
+{
+public:
+    void Process() override { mProcessed = true; }
+    void Complete() override
+    {
+        mCompleted = mProcessed;
+        (*mCompletions)[mPeer].push_back(mSequence);
+        (*mDone)++;
+    }
+    void Abandon() override
+    {
+        mAbandoned = true;
+        (*mDone)++;
+    }
+
+    size_t mPeer;
+    uint32_t mSequence;
+    std::vector<std::vector<uint32_t>> * mCompletions;
+    std::atomic<size_t> * mDone;
+    bool mProcessed = false;
+    bool mCompleted = false;
+    bool mAbandoned = false;
+};
+
+void WaitForJobs(std::atomic<size_t> & done, size_t count)
+{
+    while (done < count)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+} // namespace
+
+TEST_F(TestSecureMessageWorkerPool, CheckInitArguments)
+{
+    SecureMessageWorkerPool pool;
+    EXPECT_EQ(pool.Init(0, TryLockStack, UnlockStack), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(pool.Init(SecureMessageWorkerPool::kMaxWorkerThreads + 1, TryLockStack, UnlockStack), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(pool.Init(2, nullptr, UnlockStack), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_FALSE(pool.IsRunning());
+
+    EXPECT_EQ(pool.Init(2, TryLockStack, UnlockStack), CHIP_NO_ERROR);
+    EXPECT_EQ(pool.GetWorkerCount(), 2u);
+    EXPECT_EQ(pool.Init(2, TryLockStack, UnlockStack), CHIP_ERROR_INCORRECT_STATE);
+
+    LockStack();
+    pool.Shutdown();
+    UnlockStack();
+    EXPECT_FALSE(pool.IsRunning());
+}
+
+TEST_F(TestSecureMessageWorkerPool, CheckOrderPerShard)
+{
+    constexpr size_t kPeers         = 13;
+    constexpr uint32_t kJobsPerPeer = 50;
+    constexpr size_t kJobCount      = kPeers * kJobsPerPeer;
+
+    std::vector<std::vector<uint32_t>> completions(kPeers);
+    std::atomic<size_t> done{ 0 };
+    std::vector<OrderedJob> jobs(kJobCount);
+
+    SecureMessageWorkerPool pool;
+    ASSERT_EQ(pool.Init(4, TryLockStack, UnlockStack), CHIP_NO_ERROR);
+
+    LockStack();
+    for (size_t i = 0; i < kJobCount; i++)
+    {
+        OrderedJob & job = jobs[i];
+        job.mPeer        = i % kPeers;
+        job.mSequence    = static_cast<uint32_t>(i / kPeers);
+        job.mCompletions = &completions;
+        job.mDone        = &done;
+        pool.Submit(job, static_cast<uint32_t>(job.mPeer));
+    }
+    UnlockStack();
+
+    WaitForJobs(done, kJobCount);
+
+    LockStack();
+    pool.Shutdown();
+    UnlockStack();
+
+    // Every job was processed before it completed, and the jobs for each peer completed in submission order.
+    for (auto & job : jobs)
+    {
+        EXPECT_TRUE(job.mCompleted);
+    }
+    for (size_t peer = 0; peer < kPeers; peer++)
+    {
+        ASSERT_EQ(completions[peer].size(), kJobsPerPeer);
+        for (uint32_t sequence = 0; sequence < kJobsPerPeer; sequence++)
+        {
+            EXPECT_EQ(completions[peer][sequence], sequence);
+        }
+    }
+}
+
+TEST_F(TestSecureMessageWorkerPool, CheckShutdownAbandonsJobs)
+{
+    constexpr size_t kJobCount = 200;
+
+    std::vector<std::vector<uint32_t>> completions(1);
+    std::atomic<size_t> done{ 0 };
+    std::vector<OrderedJob> jobs(kJobCount);
+
+    SecureMessageWorkerPool pool;
+    ASSERT_EQ(pool.Init(1, TryLockStack, UnlockStack), CHIP_NO_ERROR);
+
+    // Holding the stack lock keeps the worker from completing any job, and Shutdown() does not release it.
+    LockStack();
+    for (auto & job : jobs)
+    {
+        job.mPeer        = 0;
+        job.mSequence    = 0;
+        job.mCompletions = &completions;
+        job.mDone        = &done;
+        pool.Submit(job, 0);
+    }
+    pool.Shutdown();
+    UnlockStack();
+
+    // Each job was either completed or abandoned, exactly once.
+    size_t abandoned = 0;
+    for (auto & job : jobs)
+    {
+        abandoned += job.mAbandoned ? 1 : 0;
+    }
+    EXPECT_EQ(done.load(), kJobCount);
+    EXPECT_EQ(abandoned, kJobCount);
+    EXPECT_TRUE(completions[0].empty());
+}
+
+TEST_F(TestSecureMessageWorkerPool, CheckShutdownWithoutStackLock)
+{
+    constexpr size_t kPeers    = 4;
+    constexpr size_t kJobCount = 400;
+
+    std::vector<std::vector<uint32_t>> completions(kPeers);
+    std::atomic<size_t> done{ 0 };
+    std::vector<OrderedJob> jobs(kJobCount);
+
+    SecureMessageWorkerPool pool;
+    ASSERT_EQ(pool.Init(kPeers, TryLockStack, UnlockStack), CHIP_NO_ERROR);
+
+    LockStack();
+    for (size_t i = 0; i < kJobCount; i++)
+    {
+        OrderedJob & job = jobs[i];
+        job.mPeer        = i % kPeers;
+        job.mSequence    = static_cast<uint32_t>(i / kPeers);
+        job.mCompletions = &completions;
+        job.mDone        = &done;
+        pool.Submit(job, static_cast<uint32_t>(job.mPeer));
+    }
+    UnlockStack();
+
+    // The stack is shut down without the lock while the workers are still completing jobs with it.
+    pool.Shutdown();
+    EXPECT_FALSE(pool.IsRunning());
+
+    // Each job was either completed or abandoned, exactly once, and the workers left the lock free.
+    size_t abandoned = 0;
+    size_t completed = 0;
+    for (auto & job : jobs)
+    {
+        EXPECT_NE(job.mCompleted, job.mAbandoned);
+        abandoned += job.mAbandoned ? 1 : 0;
+    }
+    for (auto & peerCompletions : completions)
+    {
+        completed += peerCompletions.size();
+    }
+    EXPECT_EQ(done.load(), kJobCount);
+    EXPECT_EQ(abandoned + completed, kJobCount);
+    EXPECT_TRUE(TryLockStack());
+    UnlockStack();
+}
+
+namespace {
+
+constexpr size_t kMessageLength = 1024;
+constexpr size_t kTagLength     = Crypto::CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES;
+constexpr size_t kNonceLength   = Crypto::CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES;
+
+struct SimulatedPeer
+{
+    Crypto::Aes128KeyHandle mKey;
+};
+
+// An encrypted message from a simulated peer, as SessionManager would hand it to a worker.
+class DecryptJob : public SecureMessageWorkerPool::Job
+{
+public:
+    void Process() override
+    {
+        mResult = Crypto::AES_CCM_decrypt(mCiphertext, kMessageLength, mAad, sizeof(mAad), mTag, kTagLength, mPeer->mKey, mNonce,
+                                          kNonceLength, mPlaintext);
+    }
+    void Complete() override { (*mDone)++; }
+    void Abandon() override
+    {
+        mResult = CHIP_ERROR_CANCELLED;
+        (*mDone)++;
+    }
+
+    SimulatedPeer * mPeer;
+    uint8_t mAad[8];
+    uint8_t mNonce[kNonceLength];
+    uint8_t mTag[kTagLength];
+    uint8_t mCiphertext[kMessageLength];
+    uint8_t mExpectedPlaintext[kMessageLength];
+    uint8_t mPlaintext[kMessageLength];
+    CHIP_ERROR mResult = CHIP_NO_ERROR;
+    std::atomic<size_t> * mDone;
+};
+
+// Decrypts every job once, either inline (threadCount == 0) or with a pool of threadCount workers, and checks the results.
+void DecryptJobs(std::vector<DecryptJob> & jobs, size_t peerCount, size_t threadCount)
+{
+    std::atomic<size_t> done{ 0 };
+    for (auto & job : jobs)
+    {
+        job.mDone = &done;
+    }
+
+    SecureMessageWorkerPool pool;
+    if (threadCount > 0)
+    {
+        EXPECT_EQ(pool.Init(threadCount, TryLockStack, UnlockStack), CHIP_NO_ERROR);
+    }
+
+    LockStack();
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        if (threadCount > 0)
+        {
+            pool.Submit(jobs[i], static_cast<uint32_t>(i % peerCount));
+        }
+        else
+        {
+            jobs[i].Process();
+            jobs[i].Complete();
+        }
+    }
+    UnlockStack();
+    WaitForJobs(done, jobs.size());
+
+    LockStack();
+    pool.Shutdown();
+    UnlockStack();
+
+    for (auto & job : jobs)
+    {
+        EXPECT_EQ(job.mResult, CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(job.mPlaintext, job.mExpectedPlaintext, kMessageLength), 0);
+        job.mResult = CHIP_ERROR_INTERNAL;
+        memset(job.mPlaintext, 0, kMessageLength);
+    }
+}
+
+} // namespace
+
+TEST_F(TestSecureMessageWorkerPool, CheckDecryptWithWorkers)
+{
+    constexpr size_t kPeers           = 64;
+    constexpr size_t kMessagesPerPeer = 32;
+
+    Crypto::DefaultSessionKeystore keystore;
+    std::vector<SimulatedPeer> peers(kPeers);
+    for (size_t i = 0; i < kPeers; i++)
+    {
+        Crypto::Symmetric128BitsKeyByteArray keyMaterial;
+        ASSERT_EQ(Crypto::DRBG_get_bytes(keyMaterial, sizeof(keyMaterial)), CHIP_NO_ERROR);
+        ASSERT_EQ(keystore.CreateKey(keyMaterial, peers[i].mKey), CHIP_NO_ERROR);
+    }
+
+    std::vector<DecryptJob> jobs(kPeers * kMessagesPerPeer);
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        DecryptJob & job = jobs[i];
+        job.mPeer        = &peers[i % kPeers];
+        ASSERT_EQ(Crypto::DRBG_get_bytes(job.mAad, sizeof(job.mAad)), CHIP_NO_ERROR);
+        ASSERT_EQ(Crypto::DRBG_get_bytes(job.mNonce, sizeof(job.mNonce)), CHIP_NO_ERROR);
+        ASSERT_EQ(Crypto::DRBG_get_bytes(job.mExpectedPlaintext, sizeof(job.mExpectedPlaintext)), CHIP_NO_ERROR);
+        ASSERT_EQ(Crypto::AES_CCM_encrypt(job.mExpectedPlaintext, kMessageLength, job.mAad, sizeof(job.mAad), job.mPeer->mKey,
+                                          job.mNonce, kNonceLength, job.mCiphertext, job.mTag, kTagLength),
+                  CHIP_NO_ERROR);
+    }
+
+    for (size_t threadCount : { 0u, 1u, 2u, 4u, 8u })
+    {
+        DecryptJobs(jobs, kPeers, threadCount);
+    }
+
+    for (auto & peer : peers)
+    {
+        keystore.DestroyKey(peer.mKey);
+    }
+}
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
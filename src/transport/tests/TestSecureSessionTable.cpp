@@ -461,5 +461,108 @@ TEST_F(TestSecureSessionTable, ValidateSessionSorting)
     ValidateSessionSorting();
 }
 
+namespace {
+
+size_t CountSessionsForPeer(SecureSessionTable & table, const ScopedNodeId & peer)
+{
+    size_t count = 0;
+    table.ForEachSessionForPeer(peer, [&count, &peer](auto * session) {
+        EXPECT_EQ(session->GetPeer(), peer);
+        count++;
+        return Loop::Continue;
+    });
+    return count;
+}
+
+void ActivateSession(const SessionHandle & session, const ScopedNodeId & peer)
+{
+    session->AsSecureSession()->Activate(
+        ScopedNodeId(peer.GetFabricIndex() == kUndefinedFabricIndex ? kUndefinedNodeId : 1, peer.GetFabricIndex()), peer,
+        CATValues(), 0,
+        ReliableMessageProtocolConfig(System::Clock::Milliseconds32(0), System::Clock::Milliseconds32(0),
+                                      System::Clock::Milliseconds16(0)));
+}
+
+} // namespace
+
+TEST_F(TestSecureSessionTable, LookupByLocalSessionId)
+{
+    auto table = Platform::MakeUnique<SecureSessionTable>();
+    ASSERT_NE(table.get(), nullptr);
+    table->Init();
+
+    Optional<SessionHandle> sessions[CHIP_CONFIG_SECURE_SESSION_POOL_SIZE];
+    for (auto & session : sessions)
+    {
+        session = table->CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+        ASSERT_TRUE(session.HasValue());
+    }
+
+    for (auto & session : sessions)
+    {
+        uint16_t localSessionId = session.Value()->AsSecureSession()->GetLocalSessionId();
+        EXPECT_NE(localSessionId, kUnsecuredSessionId);
+        EXPECT_TRUE(table->FindSecureSessionByLocalKey(localSessionId) == session);
+    }
+
+    // Dropping the last handle to a pending session releases it, which must remove it from the index.
+    uint16_t releasedSessionId = sessions[0].Value()->AsSecureSession()->GetLocalSessionId();
+    sessions[0].ClearValue();
+    EXPECT_FALSE(table->FindSecureSessionByLocalKey(releasedSessionId).HasValue());
+
+    for (size_t i = 1; i < ArraySize(sessions); i++)
+    {
+        EXPECT_TRUE(table->FindSecureSessionByLocalKey(sessions[i].Value()->AsSecureSession()->GetLocalSessionId()) == sessions[i]);
+    }
+
+    // A new session gets an ID that does not collide with any session still in the table.
+    auto session = table->CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+    ASSERT_TRUE(session.HasValue());
+    EXPECT_TRUE(table->FindSecureSessionByLocalKey(session.Value()->AsSecureSession()->GetLocalSessionId()) == session);
+}
+
+TEST_F(TestSecureSessionTable, LookupByPeer)
+{
+    auto table = Platform::MakeUnique<SecureSessionTable>();
+    ASSERT_NE(table.get(), nullptr);
+    table->Init();
+
+    const ScopedNodeId peers[] = { { 2, kFabric1 }, { 2, kFabric1 }, { 3, kFabric1 }, { 2, kFabric2 } };
+    Optional<SessionHandle> sessions[ArraySize(peers)];
+    for (auto & session : sessions)
+    {
+        session = table->CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+        ASSERT_TRUE(session.HasValue());
+    }
+
+    // Pending sessions have no peer yet.
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId()), ArraySize(peers));
+
+    for (size_t i = 0; i < ArraySize(peers); i++)
+    {
+        ActivateSession(sessions[i].Value(), peers[i]);
+    }
+
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId()), 0u);
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId(2, kFabric1)), 2u);
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId(3, kFabric1)), 1u);
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId(2, kFabric2)), 1u);
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId(3, kFabric2)), 0u);
+
+    // A PASE session moves to its new fabric when it adopts one.
+    auto pase = table->CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+    ASSERT_TRUE(pase.HasValue());
+    ActivateSession(pase.Value(), ScopedNodeId());
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId()), 1u);
+    EXPECT_EQ(pase.Value()->AsSecureSession()->AdoptFabricIndex(kFabric3), CHIP_NO_ERROR);
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId()), 0u);
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId(kUndefinedNodeId, kFabric3)), 1u);
+
+    // An evicted session is removed from its peer once released.
+    sessions[0].Value()->AsSecureSession()->MarkForEviction();
+    sessions[0].ClearValue();
+    EXPECT_EQ(CountSessionsForPeer(*table, ScopedNodeId(2, kFabric1)), 1u);
+}
+
 } // namespace Transport
 } // namespace chip
@@ -36,6 +36,7 @@
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
+#include <platform/PlatformManager.h>
 #include <protocols/Protocols.h>
 #include <protocols/echo/Echo.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
@@ -121,8 +122,21 @@ public:
 class TestSessionManager : public ::testing::Test
 {
 protected:
-    void SetUp() { ASSERT_EQ(mContext.Init(), CHIP_NO_ERROR); }
-    void TearDown() { mContext.Shutdown(); }
+    void SetUp()
+    {
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+        // The tests run as the event loop thread, which the decryption worker threads synchronize with.
+        DeviceLayer::PlatformMgr().LockChipStack();
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+        ASSERT_EQ(mContext.Init(), CHIP_NO_ERROR);
+    }
+    void TearDown()
+    {
+        mContext.Shutdown();
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+        DeviceLayer::PlatformMgr().UnlockChipStack();
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+    }
 
     TestContext mContext;
 };
@@ -212,7 +226,14 @@ TEST_F(TestSessionManager, CheckMessageTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+    // The message is decrypted on a worker thread, which cannot dispatch it while this thread holds the stack lock.
     mContext.DrainAndServiceIO();
+    EXPECT_EQ(sessionManager.GetPendingDecryptCount(), 1u);
+    EXPECT_EQ(callback.ReceiveHandlerCallCount, 0);
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
 
     // Let's send the max sized message and make sure it is received
@@ -227,7 +248,7 @@ TEST_F(TestSessionManager, CheckMessageTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 2);
 
     uint16_t large_payload_len = sizeof(LARGE_PAYLOAD);
@@ -318,7 +339,7 @@ TEST_F(TestSessionManager, SendEncryptedPacketTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
 
     // Reset receive side message counter, or duplicated message will be denied.
@@ -328,7 +349,7 @@ TEST_F(TestSessionManager, SendEncryptedPacketTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 2);
 
     sessionManager.Shutdown();
@@ -407,7 +428,7 @@ TEST_F(TestSessionManager, SendBadEncryptedPacketTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
 
     /* -------------------------------------------------------------------------------------------*/
@@ -428,7 +449,7 @@ TEST_F(TestSessionManager, SendBadEncryptedPacketTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), badMessageCounterMsg);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
 
     /* -------------------------------------------------------------------------------------------*/
@@ -445,7 +466,7 @@ TEST_F(TestSessionManager, SendBadEncryptedPacketTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), badKeyIdMsg);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
 
     /* -------------------------------------------------------------------------------------------*/
@@ -455,7 +476,7 @@ TEST_F(TestSessionManager, SendBadEncryptedPacketTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 2);
 
     sessionManager.Shutdown();
@@ -533,7 +554,7 @@ TEST_F(TestSessionManager, SendPacketWithOldCounterTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
 
     // Now advance our message counter by 5.
@@ -550,7 +571,7 @@ TEST_F(TestSessionManager, SendPacketWithOldCounterTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), newMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 2);
 
     // Now resend our original message.  It should be rejected as a duplicate.
@@ -558,7 +579,7 @@ TEST_F(TestSessionManager, SendPacketWithOldCounterTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 2);
 
     sessionManager.Shutdown();
@@ -635,7 +656,7 @@ TEST_F(TestSessionManager, SendPacketWithTooOldCounterTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
 
     // Now advance our message counter by at least
@@ -654,7 +675,7 @@ TEST_F(TestSessionManager, SendPacketWithTooOldCounterTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), newMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 2);
 
     // Now resend our original message.  It should be rejected as a duplicate.
@@ -662,7 +683,7 @@ TEST_F(TestSessionManager, SendPacketWithTooOldCounterTest)
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     EXPECT_EQ(err, CHIP_NO_ERROR);
 
-    mContext.DrainAndServiceIO();
+    mContext.DrainAndServiceIO(sessionManager);
     EXPECT_EQ(callback.ReceiveHandlerCallCount, 2);
 
     sessionManager.Shutdown();
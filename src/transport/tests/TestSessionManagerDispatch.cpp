@@ -36,6 +36,7 @@
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
+#include <platform/PlatformManager.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
 #include <transport/SessionManager.h>
 #include <transport/TransportMgr.h>
@@ -551,8 +552,21 @@ CHIP_ERROR InjectGroupSessionWithTestKey(SessionHolder & sessionHolder, MessageT
 class TestSessionManagerDispatch : public ::testing::Test
 {
 protected:
-    void SetUp() { ASSERT_EQ(mContext.Init(), CHIP_NO_ERROR); }
-    void TearDown() { mContext.Shutdown(); }
+    void SetUp()
+    {
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+        // The tests run as the event loop thread, which the decryption worker threads synchronize with.
+        DeviceLayer::PlatformMgr().LockChipStack();
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+        ASSERT_EQ(mContext.Init(), CHIP_NO_ERROR);
+    }
+    void TearDown()
+    {
+        mContext.Shutdown();
+#if CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+        DeviceLayer::PlatformMgr().UnlockChipStack();
+#endif // CHIP_CONFIG_SECURE_MESSAGE_WORKER_THREADS > 0
+    }
 
     TestContext mContext;
 };
@@ -601,6 +615,7 @@ TEST_F(TestSessionManagerDispatch, TestSessionManagerDispatch)
 
         const PeerAddress peerAddress = AddressFromString(testEntry.peerAddr);
         sessionManager.OnMessageReceived(peerAddress, std::move(msg));
+        mContext.DrainAndServiceIO(sessionManager);
         EXPECT_EQ(callback.NumMessagesReceived(), testEntry.expectedMessageCount);
 
         if ((testEntry.expectedMessageCount == 0) && (callback.NumMessagesReceived() == 0))